@@ -6,6 +6,10 @@
 #include <ncvalues.h>
 #include <netcdfcpp.h>
 #include <usml/biverbs/biverb_collection.h>
+#include <usml/eigenverbs/eigenverb_collection.h>
+#include <usml/netcdf/columnar_file.h>
+#include <usml/netcdf/columnar_writer.h>
+#include <usml/netcdf/netcdf_utils.h>
 #include <usml/types/seq_vector.h>
 #include <usml/types/wposition1.h>
 #include <usml/ublas/math_traits.h>
@@ -14,12 +18,16 @@
 #include <boost/numeric/ublas/expression_types.hpp>
 #include <boost/numeric/ublas/storage.hpp>
 #include <boost/numeric/ublas/vector_expression.hpp>
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <list>
-#include <sstream>
+#include <mutex>
 #include <string>
 
 using namespace usml::biverbs;
+using namespace usml::eigenverbs;
+using namespace usml::netcdf;
 
 // #define DEBUG_BIVERB
 
@@ -40,6 +48,21 @@ biverb_list biverb_collection::biverbs(size_t interface) const {
     return list;
 }
 
+/**
+ * Creates list of biverbs for a specific interface in a travel time window.
+ */
+biverb_list biverb_collection::biverbs(size_t interface, double t_min,
+                                       double t_max) const {
+    read_lock_guard guard(_mutex);
+    const map& verbs = _collection[interface];
+    biverb_list list;
+    for (auto iter = verbs.lower_bound(t_min);
+         iter != verbs.end() && iter->first < t_max; ++iter) {
+        list.push_back(iter->second);
+    }
+    return list;
+}
+
 /**
  * Adds a new biverb to this collection.
  */
@@ -48,17 +71,42 @@ void biverb_collection::add_biverb(const eigenverb_model::csptr& src_verb,
                                    const vector<double>& scatter,
                                    size_t interface) {
     write_lock_guard guard(_mutex);
+    double det_sr;
+    const double scale = overlap(*src_verb, *rcv_verb, &det_sr);
+    insert(*src_verb, *rcv_verb, scatter, scale, det_sr, interface);
+}
+
+/**
+ * Adds the biverbs for both orderings of a monostatic eigenverb pair.
+ */
+void biverb_collection::add_biverb_pair(const eigenverb_model::csptr& verb1,
+                                        const eigenverb_model::csptr& verb2,
+                                        const vector<double>& scatter12,
+                                        const vector<double>& scatter21,
+                                        size_t interface) {
+    write_lock_guard guard(_mutex);
+    double det_sr;
+    const double scale = overlap(*verb1, *verb2, &det_sr);
+    insert(*verb1, *verb2, scatter12, scale, det_sr, interface);
+    insert(*verb2, *verb1, scatter21, scale, det_sr, interface);
+}
 
+/**
+ * Computes the overlap of the source and receiver Gaussians.
+ */
+double biverb_collection::overlap(const eigenverb_model& src_verb,
+                                  const eigenverb_model& rcv_verb,
+                                  double* det_sr) {
     // determine relative range and bearing between Gaussians
 
     double bearing;
     const double range =
-        rcv_verb->position.gc_range(src_verb->position, &bearing);
+        rcv_verb.position.gc_range(src_verb.position, &bearing);
 
     if (range < 1e-6) {
         bearing = 0;  // fixes bearing = NaN
     }
-    bearing -= rcv_verb->direction;  // relative bearing
+    bearing -= rcv_verb.direction;  // relative bearing
 
     const double ys = range * cos(bearing);
     const double ys2 = ys * ys;
@@ -68,71 +116,46 @@ void biverb_collection::add_biverb(const eigenverb_model::csptr& src_verb,
 
 #ifdef DEBUG_BIVERB
     cout << "biverb_generator::compute_overlap() " << endl
-         << "\txs2=" << xs2 << " ys2=" << ys2 << " scatter=" << scatter << endl
+         << "\txs2=" << xs2 << " ys2=" << ys2 << endl
          << "\tsrc_verb"
-         << " t=" << src_verb->travel_time
-         << " de=" << to_degrees(src_verb->source_de)
-         << " az=" << to_degrees(src_verb->source_az)
-         << " direction=" << to_degrees(src_verb->direction)
-         << " grazing=" << to_degrees(src_verb->grazing) << endl
-         << "\tpower=" << 10.0 * log10(src_verb->power)
-         << " length=" << src_verb->length << " width=" << src_verb->width
-         << " surface=" << src_verb->surface << " bottom=" << src_verb->bottom
-         << " caustic=" << src_verb->caustic << endl
+         << " t=" << src_verb.travel_time
+         << " de=" << to_degrees(src_verb.source_de)
+         << " az=" << to_degrees(src_verb.source_az)
+         << " direction=" << to_degrees(src_verb.direction)
+         << " grazing=" << to_degrees(src_verb.grazing) << endl
+         << "\tpower=" << 10.0 * log10(src_verb.power)
+         << " length=" << src_verb.length << " width=" << src_verb.width
+         << " surface=" << src_verb.surface << " bottom=" << src_verb.bottom
+         << " caustic=" << src_verb.caustic << endl
          << "\trcv_verb"
-         << " t=" << rcv_verb->travel_time
-         << " de=" << to_degrees(rcv_verb->source_de)
-         << " az=" << to_degrees(rcv_verb->source_az)
-         << " direction=" << to_degrees(rcv_verb->direction)
-         << " grazing=" << to_degrees(rcv_verb->grazing) << endl
-         << "\tpower=" << 10.0 * log10(rcv_verb->power)
-         << " length=" << rcv_verb->length << " width=" << rcv_verb->width
-         << " surface=" << rcv_verb->surface << " bottom=" << rcv_verb->bottom
-         << " caustic=" << rcv_verb->caustic << endl;
+         << " t=" << rcv_verb.travel_time
+         << " de=" << to_degrees(rcv_verb.source_de)
+         << " az=" << to_degrees(rcv_verb.source_az)
+         << " direction=" << to_degrees(rcv_verb.direction)
+         << " grazing=" << to_degrees(rcv_verb.grazing) << endl
+         << "\tpower=" << 10.0 * log10(rcv_verb.power)
+         << " length=" << rcv_verb.length << " width=" << rcv_verb.width
+         << " surface=" << rcv_verb.surface << " bottom=" << rcv_verb.bottom
+         << " caustic=" << rcv_verb.caustic << endl;
 #endif
-    // copy data from source and receiver eigenverbs
-
-    auto* biverb = new biverb_model();
-    biverb->travel_time = src_verb->travel_time + rcv_verb->travel_time;
-    biverb->frequencies = rcv_verb->frequencies;
-    biverb->de_index = rcv_verb->de_index;
-    biverb->az_index = rcv_verb->az_index;
-
-    biverb->source_de = src_verb->source_de;
-    biverb->source_az = src_verb->source_az;
-
-    biverb->source_surface = src_verb->surface;
-    biverb->source_bottom = src_verb->bottom;
-    biverb->source_caustic = src_verb->caustic;
-    biverb->source_upper = src_verb->upper;
-    biverb->source_lower = src_verb->lower;
-
-    biverb->receiver_de = rcv_verb->source_de;
-    biverb->receiver_az = rcv_verb->source_az;
-
-    biverb->receiver_surface = rcv_verb->surface;
-    biverb->receiver_bottom = rcv_verb->bottom;
-    biverb->receiver_caustic = rcv_verb->caustic;
-    biverb->receiver_upper = rcv_verb->upper;
-    biverb->receiver_lower = rcv_verb->lower;
 
     // determine the relative tilt between the projected Gaussians
 
-    const double alpha = src_verb->direction - rcv_verb->direction;
+    const double alpha = src_verb.direction - rcv_verb.direction;
     const double cos2alpha = cos(2.0 * alpha);
     const double sin2alpha = sin(2.0 * alpha);
 
     // compute commonly used terms in the intersection of the Gaussian
     // profiles
 
-    auto src_length2 = src_verb->length * src_verb->length;
-    auto src_width2 = src_verb->width * src_verb->width;
+    auto src_length2 = src_verb.length * src_verb.length;
+    auto src_width2 = src_verb.width * src_verb.width;
     const double src_sum = src_length2 + src_width2;
     const double src_diff = src_length2 - src_width2;
     const double src_prod = src_length2 * src_width2;
 
-    auto rcv_length2 = rcv_verb->length * rcv_verb->length;
-    auto rcv_width2 = rcv_verb->width * rcv_verb->width;
+    auto rcv_length2 = rcv_verb.length * rcv_verb.length;
+    auto rcv_width2 = rcv_verb.width * rcv_verb.width;
     const double rcv_sum = rcv_length2 + rcv_width2;
     const double rcv_diff = rcv_length2 - rcv_width2;
     const double rcv_prod = rcv_length2 * rcv_width2;
@@ -140,31 +163,74 @@ void biverb_collection::add_biverb(const eigenverb_model::csptr& src_verb,
     // compute the scaling of the exponential
     // equations (26) and (28) from the paper
 
-    double det_sr = 0.5 * (2.0 * (src_prod + rcv_prod) + (src_sum * rcv_sum) -
-                           (src_diff * rcv_diff) * cos2alpha);
-    biverb->power = 0.25 * 0.5 * src_verb->power * rcv_verb->power * scatter;
+    *det_sr = 0.5 * (2.0 * (src_prod + rcv_prod) + (src_sum * rcv_sum) -
+                     (src_diff * rcv_diff) * cos2alpha);
 
     // compute the power of the exponential
     // equation (28) from the paper
+    // cross term keeps the sign of xs*ys, to match the quadratic form of
+    // the sum of the two Gaussians, which also makes it symmetric
+    // earlier releases used sqrt(xs2*ys2), which over-estimated the overlap
+    // of tilted Gaussians when xs*ys is negative
 
     const double new_prod = src_diff * cos2alpha;
     const double kappa = -0.25 *
                          (xs2 * (src_sum + new_prod + 2.0 * rcv_length2) +
                           ys2 * (src_sum - new_prod + 2.0 * rcv_width2) -
-                          2.0 * sqrt(xs2 * ys2) * src_diff * sin2alpha) /
-                         det_sr;
+                          2.0 * xs * ys * src_diff * sin2alpha) /
+                         *det_sr;
 #ifdef DEBUG_BIVERB
-    cout << "\tdet_sr=" << det_sr << " kappa=" << kappa
-         << " scatter=" << (10.0 * log10(scatter))
-         << " power=" << (10.0 * log10(biverb->power)) << endl;
+    cout << "\tdet_sr=" << *det_sr << " kappa=" << kappa << endl;
 #endif
-    const double overlap_scale = exp(kappa) / sqrt(det_sr);
-    biverb->power *= overlap_scale;
+    return exp(kappa) / sqrt(*det_sr);
+}
+
+/**
+ * Constructs a new biverb from its overlap, and adds it to this collection.
+ */
+void biverb_collection::insert(const eigenverb_model& src_verb,
+                               const eigenverb_model& rcv_verb,
+                               const vector<double>& scatter, double scale,
+                               double det_sr, size_t interface) {
+    // copy data from source and receiver eigenverbs
+
+    auto* biverb = new biverb_model();
+    biverb->travel_time = src_verb.travel_time + rcv_verb.travel_time;
+    biverb->frequencies = rcv_verb.frequencies;
+    biverb->de_index = rcv_verb.de_index;
+    biverb->az_index = rcv_verb.az_index;
+
+    biverb->source_de = src_verb.source_de;
+    biverb->source_az = src_verb.source_az;
+
+    biverb->source_surface = src_verb.surface;
+    biverb->source_bottom = src_verb.bottom;
+    biverb->source_caustic = src_verb.caustic;
+    biverb->source_upper = src_verb.upper;
+    biverb->source_lower = src_verb.lower;
+
+    biverb->receiver_de = rcv_verb.source_de;
+    biverb->receiver_az = rcv_verb.source_az;
+
+    biverb->receiver_surface = rcv_verb.surface;
+    biverb->receiver_bottom = rcv_verb.bottom;
+    biverb->receiver_caustic = rcv_verb.caustic;
+    biverb->receiver_upper = rcv_verb.upper;
+    biverb->receiver_lower = rcv_verb.lower;
+
+    biverb->power = 0.25 * 0.5 * src_verb.power * rcv_verb.power * scatter;
+    biverb->power *= scale;
 
     // compute the square of the duration of the overlap
     // equation (41) from the paper
 
-    det_sr = det_sr / (src_prod * rcv_prod);
+    const double alpha = src_verb.direction - rcv_verb.direction;
+    const double cos2alpha = cos(2.0 * alpha);
+    const double src_length2 = src_verb.length * src_verb.length;
+    const double src_width2 = src_verb.width * src_verb.width;
+    const double rcv_length2 = rcv_verb.length * rcv_verb.length;
+    const double rcv_width2 = rcv_verb.width * rcv_verb.width;
+    det_sr /= (src_length2 * src_width2 * rcv_length2 * rcv_width2);
     auto sigma = 0.5 *
                  ((1.0 / src_width2 + 1.0 / src_length2) +
                   (1.0 / src_width2 - 1.0 / src_length2) * cos2alpha +
@@ -174,10 +240,11 @@ void biverb_collection::add_biverb(const eigenverb_model::csptr& src_verb,
     // combine duration of the overlap with pulse length
     // equation (33) from the paper
 
-    const double factor = cos(rcv_verb->grazing) / rcv_verb->sound_speed;
+    const double factor = cos(rcv_verb.grazing) / rcv_verb.sound_speed;
     biverb->duration = 0.5 * factor * sqrt(sigma);
 #ifdef DEBUG_BIVERB
     cout << "\tcontribution duration=" << biverb->duration
+         << " scatter=" << (10.0 * log10(scatter))
          << " power=" << (10.0 * log10(biverb->power)) << endl;
 #endif
 
@@ -195,33 +262,15 @@ void biverb_collection::add_biverb(const eigenverb_model::csptr& src_verb,
 void biverb_collection::write_netcdf(const char* filename,
                                      size_t interface) const {
     read_lock_guard guard(_mutex);
+    std::lock_guard<std::mutex> lock(netcdf_utils::mutex());
     NcFile nc_file(filename, NcFile::Replace);
 
-    switch (interface) {
-        case eigenverb_model::BOTTOM:
-            nc_file.add_att("long_name", "bottom eigenverbs");
-            break;
-        case eigenverb_model::SURFACE:
-            nc_file.add_att("long_name", "surface eigenverbs");
-            break;
-        case eigenverb_model::VOLUME_UPPER:
-            nc_file.add_att("long_name", "upper volume eigenverbs");
-            nc_file.add_att("layer", 1);
-            break;
-        case eigenverb_model::VOLUME_LOWER:
-            nc_file.add_att("long_name", "lower volume eigenverbs");
-            nc_file.add_att("layer", 1);
-            break;
-        default: {
-            size_t layer = interface - eigenverb_model::VOLUME_UPPER;
-            size_t side = layer % 2;
-            layer = (layer / 2) + 1;
-            std::ostringstream oss;
-            oss << ((side) != 0U ? "lower" : "upper") << " volume " << layer
-                << " eigenverbs";
-            nc_file.add_att("long_name", oss.str().c_str());
-            nc_file.add_att("layer", (long)layer);
-        } break;
+    size_t layer = 0;
+    nc_file.add_att(
+        "long_name",
+        eigenverb_collection::interface_name(interface, &layer).c_str());
+    if (layer > 0) {
+        nc_file.add_att("layer", (long)layer);
     }
 
     biverb_list list = biverbs(interface);
@@ -372,3 +421,90 @@ void biverb_collection::write_netcdf(const char* filename,
         // clang-format on
     }
 }
+
+/**
+ * Writes the biverbs for an individual interface to a columnar file.
+ */
+void biverb_collection::write_columnar(const char* filename,
+                                       size_t interface) const {
+    columnar_file file;
+    size_t layer = 0;
+    file.attribute("long_name",
+                   eigenverb_collection::interface_name(interface, &layer));
+    if (layer > 0) {
+        file.attribute("layer", std::to_string(layer));
+    }
+
+    biverb_list list = biverbs(interface);
+    if (!list.empty()) {
+        const auto& frequencies = *list.begin()->get()->frequencies;
+        const size_t num_verbs = list.size();
+        const size_t num_freqs = frequencies.size();
+        std::vector<double> travel_time;
+        std::vector<double> power;
+        std::vector<double> duration;
+        std::vector<int16_t> de_index;
+        std::vector<int16_t> az_index;
+        std::vector<double> source_de;
+        std::vector<double> source_az;
+        std::vector<int16_t> source_surface;
+        std::vector<int16_t> source_bottom;
+        std::vector<int16_t> source_caustic;
+        std::vector<int16_t> source_upper;
+        std::vector<int16_t> source_lower;
+        std::vector<double> receiver_de;
+        std::vector<double> receiver_az;
+        std::vector<int16_t> receiver_surface;
+        std::vector<int16_t> receiver_bottom;
+        std::vector<int16_t> receiver_caustic;
+        std::vector<int16_t> receiver_upper;
+        std::vector<int16_t> receiver_lower;
+        power.reserve(num_verbs * num_freqs);
+        for (const auto& verb : list) {
+            travel_time.push_back(verb->travel_time);
+            for (size_t f = 0; f < num_freqs; ++f) {
+                const double p = std::max(verb->power[f], 1e-30);
+                power.push_back(10.0 * std::log10(p));
+            }
+            duration.push_back(verb->duration);
+            de_index.push_back((int16_t)verb->de_index);
+            az_index.push_back((int16_t)verb->az_index);
+            source_de.push_back(to_degrees(verb->source_de));
+            source_az.push_back(to_degrees(verb->source_az));
+            source_surface.push_back((int16_t)verb->source_surface);
+            source_bottom.push_back((int16_t)verb->source_bottom);
+            source_caustic.push_back((int16_t)verb->source_caustic);
+            source_upper.push_back((int16_t)verb->source_upper);
+            source_lower.push_back((int16_t)verb->source_lower);
+            receiver_de.push_back(to_degrees(verb->receiver_de));
+            receiver_az.push_back(to_degrees(verb->receiver_az));
+            receiver_surface.push_back((int16_t)verb->receiver_surface);
+            receiver_bottom.push_back((int16_t)verb->receiver_bottom);
+            receiver_caustic.push_back((int16_t)verb->receiver_caustic);
+            receiver_upper.push_back((int16_t)verb->receiver_upper);
+            receiver_lower.push_back((int16_t)verb->receiver_lower);
+        }
+        file.add("travel_time", "seconds", travel_time);
+        file.add("frequencies", "hertz", {num_freqs},
+                 frequencies.data().begin());
+        file.add("power", "dB", {num_verbs, num_freqs}, power.data());
+        file.add("duration", "s", duration);
+        file.add("de_index", "count", de_index);
+        file.add("az_index", "count", az_index);
+        file.add("source_de", "degrees", source_de);
+        file.add("source_az", "degrees_true", source_az);
+        file.add("source_surface", "count", source_surface);
+        file.add("source_bottom", "count", source_bottom);
+        file.add("source_caustic", "count", source_caustic);
+        file.add("source_upper", "count", source_upper);
+        file.add("source_lower", "count", source_lower);
+        file.add("receiver_de", "degrees", receiver_de);
+        file.add("receiver_az", "degrees_true", receiver_az);
+        file.add("receiver_surface", "count", receiver_surface);
+        file.add("receiver_bottom", "count", receiver_bottom);
+        file.add("receiver_caustic", "count", receiver_caustic);
+        file.add("receiver_upper", "count", receiver_upper);
+        file.add("receiver_lower", "count", receiver_lower);
+    }
+    columnar_writer::instance()->write(filename, std::move(file));
+}
@@ -84,6 +84,17 @@ class USML_DECLSPEC biverb_collection {
      */
     biverb_list biverbs(size_t interface) const;
 
+    /**
+     * Creates list of biverbs for a specific interface whose travel time
+     * is in the range [t_min, t_max). Uses the time sorted map, so the cost
+     * of this query is proportional to the number of biverbs returned.
+     *
+     * @param interface Interface number of the desired list of biverbs.
+     * @param t_min     Earliest travel time to include (sec).
+     * @param t_max     Travel time at the end of the window (sec).
+     */
+    biverb_list biverbs(size_t interface, double t_min, double t_max) const;
+
     /**
      * Constructs a new bistatic eigenverb and adds it to this collection. Note
      * that passing the scattering strength as an argument allows the same
@@ -98,6 +109,29 @@ class USML_DECLSPEC biverb_collection {
                     const eigenverb_model::csptr& rcv_verb,
                     const vector<double>& scatter, size_t interface);
 
+    /**
+     * Constructs the bistatic eigenverbs for both orderings of a pair of
+     * eigenverbs from a monostatic sensor, and adds them to this collection.
+     * The overlap of two Gaussians does not depend on which one is the
+     * source, so it is computed once and shared by both biverbs. The travel
+     * times of the two biverbs are the same. Their scattering strengths,
+     * source/receiver angles, path counts, and durations are separate.
+     *
+     * @param verb1     Source eigenverb for the first biverb, and receiver
+     *                  eigenverb for the second.
+     * @param verb2     Receiver eigenverb for the first biverb, and source
+     *                  eigenverb for the second.
+     * @param scatter12 Scattering strength vs. frequency at the position of
+     *                  verb2, incident from verb1.
+     * @param scatter21 Scattering strength vs. frequency at the position of
+     *                  verb1, incident from verb2.
+     * @param interface Interface number for this addition.
+     */
+    void add_biverb_pair(const eigenverb_model::csptr& verb1,
+                         const eigenverb_model::csptr& verb2,
+                         const vector<double>& scatter12,
+                         const vector<double>& scatter21, size_t interface);
+
     /**
      * Writes the biverbs for an individual interface to a netcdf file.
      * There are separate variables for each biverb component,
@@ -184,12 +218,53 @@ class USML_DECLSPEC biverb_collection {
      */
     void write_netcdf(const char* filename, size_t interface) const;
 
+    /**
+     * Writes the biverbs for an individual interface to a columnar file,
+     * using the same variable names and units as write_netcdf(). Copies the
+     * data into a columnar_file, then returns while the file is written by
+     * the columnar_writer on a background I/O thread.
+     *
+     * @param filename      Filename used to store this data.
+     * @param interface     Interface number for this list of biverbs.
+     */
+    void write_columnar(const char* filename, size_t interface) const;
+
    private:
     /// Mutex to that locks object during changes.
     mutable read_write_lock _mutex;
 
     /// Spatial index for each interface.
     std::vector<map> _collection;
+
+    /**
+     * Computes the overlap of the source and receiver Gaussians, from
+     * equations (26) and (28) of the paper. The result is the same if the
+     * source and receiver are exchanged.
+     *
+     * @param src_verb  Source eigenverb.
+     * @param rcv_verb  Receiver eigenverb.
+     * @param det_sr    Determinant of the combined covariance (output).
+     * @return          Scale factor applied to the product of the powers.
+     */
+    static double overlap(const eigenverb_model& src_verb,
+                          const eigenverb_model& rcv_verb, double* det_sr);
+
+    /**
+     * Constructs a new biverb from the overlap of its source and receiver
+     * eigenverbs, and adds it to this collection if its power is above
+     * power_threshold. Caller must hold a write lock.
+     *
+     * @param src_verb  Source eigenverb.
+     * @param rcv_verb  Receiver eigenverb.
+     * @param scatter   Scattering strength vs. frequency.
+     * @param scale     Overlap scale factor computed by overlap().
+     * @param det_sr    Determinant computed by overlap().
+     * @param interface Interface number for this addition.
+     */
+    void insert(const eigenverb_model& src_verb,
+                const eigenverb_model& rcv_verb,
+                const vector<double>& scatter, double scale, double det_sr,
+                size_t interface);
 };
 
 /// @}
@@ -8,12 +8,15 @@
 #include <usml/managed/managed_obj.h>
 #include <usml/ocean/ocean_model.h>
 #include <usml/ocean/ocean_shared.h>
-#include <usml/sensors/sensor_manager.h>
 #include <usml/types/seq_vector.h>
 
 #include <boost/numeric/ublas/vector.hpp>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <memory>
+#include <utility>
+#include <vector>
 
 using namespace usml::biverbs;
 
@@ -44,38 +47,173 @@ void biverb_generator::run() {
     }
     cout << "task #" << id()
          << " biverb_generator: " << _sensor_pair->description() << endl;
+    auto aborted = [this]() {
+        if (checkpoint()) {
+            cout << "task #" << id()
+                 << " biverb_generator *** aborted during execution ***"
+                 << endl;
+            return true;
+        }
+        return false;
+    };
 
     // initialize workspace for results
 
     auto ocean = ocean_shared::current();
-    auto freq = sensor_manager::instance()->frequencies();
-    const size_t num_freq = freq->size();
-    vector<double> scatter(num_freq, 0.0);
-    auto* collection = new biverb_collection(ocean->num_volume());
+    vector<double> scatter;
+    matrix<double> scatter_batch;
+    std::vector<wposition1> location;
+    vector<double> de_incident, de_scattered, az_incident, az_scattered;
+    std::unique_ptr<biverb_collection> collection(
+        new biverb_collection(ocean->num_volume()));
 
-    // loop through eigenverbs for each interface
+    // list receiver eigenverbs for each interface
+    // sort by travel time across all interfaces if streaming
 
+    std::vector<std::pair<size_t, const eigenverb_model::csptr*>> rcv_list;
     auto num_interfaces = _rcv_eigenverbs->num_interfaces();
     for (size_t interface = 0; interface < num_interfaces; ++interface) {
         for (const auto& rcv_verb : _rcv_eigenverbs->eigenverbs(interface)) {
-            eigenverb_list found_verbs =
-                _src_eigenverbs->find_eigenverbs(rcv_verb, interface);
-            for (const auto& src_verb : found_verbs) {
-                ocean->scattering(interface, rcv_verb->position,
-                                  rcv_verb->frequencies, src_verb->grazing,
-                                  rcv_verb->grazing, src_verb->direction,
-                                  rcv_verb->direction, &scatter);
-                collection->add_biverb(src_verb, rcv_verb, scatter, interface);
-                if (_abort) {
-                    cout << "task #" << id()
-                         << " biverb_generator *** aborted during execution ***"
-                         << endl;
-                    return;
+            rcv_list.emplace_back(interface, &rcv_verb);
+        }
+    }
+    const bool stream = streaming();
+    if (stream) {
+        std::stable_sort(rcv_list.begin(), rcv_list.end(),
+                         [](const auto& a, const auto& b) {
+                             return (*a.second)->travel_time <
+                                    (*b.second)->travel_time;
+                         });
+    }
+    double window_start = 0.0;
+
+    // monostatic sensors use the same collection for source and receiver
+    // a pair of eigenverbs that each find the other is evaluated once,
+    // when the receiver is the first of the pair in memory
+
+    const bool monostatic = (_src_eigenverbs == _rcv_eigenverbs);
+    std::vector<bool> mutual;
+    matrix<double> mirror_batch;
+    vector<double> mirror_scatter;
+
+    // loop through receiver eigenverbs
+    // check for cancellation before each search of source eigenverbs
+
+    for (const auto& entry : rcv_list) {
+        const size_t interface = entry.first;
+        const eigenverb_model::csptr& rcv_verb = *entry.second;
+        if (aborted()) {
+            return;
+        }
+
+        // publish windows that are complete before this travel time
+
+        while (stream && rcv_verb->travel_time >= window_start + _window) {
+            _window_listener(*collection, window_start,
+                             window_start + _window);
+            window_start += _window;
+        }
+
+        // skip pairs that are added with the other ordering
+
+        eigenverb_list found_verbs =
+            _src_eigenverbs->find_eigenverbs(rcv_verb, interface);
+        mutual.assign(found_verbs.size(), false);
+        size_t num_mirrors = 0;
+        if (monostatic) {
+            size_t keep = 0;
+            for (auto& src_verb : found_verbs) {
+                const bool both = src_verb != rcv_verb &&
+                                  eigenverb_collection::in_search_area(
+                                      *src_verb, *rcv_verb);
+                if (both && src_verb.get() < rcv_verb.get()) {
+                    continue;
                 }
+                mutual[keep] = both;
+                num_mirrors += both ? 1 : 0;
+                found_verbs[keep++] = std::move(src_verb);
             }
+            found_verbs.resize(keep);
         }
+        if (found_verbs.empty()) {
+            continue;
+        }
+
+        // compute scattering strength for all overlaps in one call
+
+        const size_t num_pairs = found_verbs.size();
+        location.assign(num_pairs, rcv_verb->position);
+        de_incident.resize(num_pairs, false);
+        az_incident.resize(num_pairs, false);
+        de_scattered.resize(num_pairs, false);
+        az_scattered.resize(num_pairs, false);
+        size_t n = 0;
+        for (const auto& src_verb : found_verbs) {
+            de_incident(n) = src_verb->grazing;
+            az_incident(n) = src_verb->direction;
+            ++n;
+        }
+        noalias(de_scattered) =
+            scalar_vector<double>(num_pairs, rcv_verb->grazing);
+        noalias(az_scattered) =
+            scalar_vector<double>(num_pairs, rcv_verb->direction);
+        ocean->scattering(interface, location, rcv_verb->frequencies,
+                          de_incident, de_scattered, az_incident,
+                          az_scattered, &scatter_batch);
+
+        // compute scattering strength for the other ordering of each pair
+        // at the position of the source eigenverb, with the angles swapped
+
+        if (num_mirrors > 0) {
+            location.clear();
+            de_incident.resize(num_mirrors, false);
+            az_incident.resize(num_mirrors, false);
+            de_scattered.resize(num_mirrors, false);
+            az_scattered.resize(num_mirrors, false);
+            n = 0;
+            for (size_t k = 0; k < num_pairs; ++k) {
+                if (mutual[k]) {
+                    const auto& src_verb = found_verbs[k];
+                    location.push_back(src_verb->position);
+                    de_scattered(n) = src_verb->grazing;
+                    az_scattered(n) = src_verb->direction;
+                    ++n;
+                }
+            }
+            noalias(de_incident) =
+                scalar_vector<double>(num_mirrors, rcv_verb->grazing);
+            noalias(az_incident) =
+                scalar_vector<double>(num_mirrors, rcv_verb->direction);
+            ocean->scattering(interface, location, rcv_verb->frequencies,
+                              de_incident, de_scattered, az_incident,
+                              az_scattered, &mirror_batch);
+        }
+
+        // add both biverbs at once if the search for the source eigenverb
+        // also finds this receiver eigenverb
+        // size scattering strength from the eigenverb frequencies, which
+        // may differ from the sensor_manager frequencies
+
+        scatter.resize(rcv_verb->frequencies->size(), false);
+        mirror_scatter.resize(rcv_verb->frequencies->size(), false);
+        size_t m = 0;
+        for (size_t k = 0; k < num_pairs; ++k) {
+            const auto& src_verb = found_verbs[k];
+            noalias(scatter) = row(scatter_batch, k);
+            if (mutual[k]) {
+                noalias(mirror_scatter) = row(mirror_batch, m++);
+                collection->add_biverb_pair(src_verb, rcv_verb, scatter,
+                                            mirror_scatter, interface);
+            } else {
+                collection->add_biverb(src_verb, rcv_verb, scatter,
+                                       interface);
+            }
+        }
+    }
+    if (stream) {
+        _window_listener(*collection, window_start, INFINITY);
     }
-    _collection = biverb_collection::csptr(collection);
+    _collection = biverb_collection::csptr(collection.release());
     _done = true;
     notify_update(&_collection);
     cout << "task #" << id() << " biverb_generator: done" << endl;
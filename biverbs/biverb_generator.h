@@ -11,6 +11,9 @@
 #include <usml/threads/thread_task.h>
 #include <usml/usml_config.h>
 
+#include <functional>
+#include <utility>
+
 namespace usml {
 namespace biverbs {
 
@@ -48,6 +51,31 @@ class USML_DECLSPEC biverb_generator
                      const eigenverb_collection::csptr& src_eigenverbs,
                      const eigenverb_collection::csptr& rcv_eigenverbs);
 
+    /**
+     * Function that receives the partial results at the end of each travel
+     * time window. The arguments are the biverbs computed so far, and the
+     * start and end of the window that has just been completed (sec). All
+     * of the biverbs with travel times before the end of the window are
+     * in the collection when this function is called.
+     */
+    typedef std::function<void(const biverb_collection&, double, double)>
+        window_listener;
+
+    /**
+     * Publish partial results at the end of each travel time window. Must be
+     * called before the task is launched. Disabled if window is zero.
+     *
+     * @param window    Duration of each travel time window (sec).
+     * @param listener  Function that receives the results of each window.
+     */
+    void stream(double window, window_listener listener) {
+        _window = window;
+        _window_listener = std::move(listener);
+    }
+
+    /// True if partial results are published at the end of each window.
+    bool streaming() const { return _window > 0.0 && _window_listener; }
+
     /**
      * Virtual destructor
      */
@@ -66,6 +94,25 @@ class USML_DECLSPEC biverb_generator
      * Finally, it uses the evelope_collection.add_contribution() method
      * to add this this source/receiver combination to the reverberation
      * time series.
+     *
+     * In streaming mode, the receiver eigenverbs for all interfaces are
+     * processed in order of travel time. Because the two way travel time of
+     * each biverb is the sum of its source and receiver travel times, every
+     * biverb earlier than the travel time of the current receiver eigenverb
+     * has already been computed. Each time that the receiver travel time
+     * crosses the end of a window, the window_listener is called with the
+     * partial results. The last window ends at infinity.
+     *
+     * In monostatic mode, where the source and receiver eigenverbs are the
+     * same collection, a pair of eigenverbs that each find the other is
+     * evaluated once, by add_biverb_pair(), which creates the biverbs for
+     * both orderings. eigenverb_collection::in_search_area() tells whether
+     * the search in the other direction finds the pair, so the search
+     * results do not need to be stored. The pair is added when the receiver
+     * eigenverb is first in memory, and skipped otherwise. The scattering
+     * strength of each ordering is computed separately, at the position of
+     * its receiver eigenverb. Pairs found in only one direction are still
+     * evaluated by add_biverb().
      */
     virtual void run();
 
@@ -91,6 +138,12 @@ class USML_DECLSPEC biverb_generator
      * Collection of bistatic eigenverbs generated by this calculation.
      */
     biverb_collection::csptr _collection;
+
+    /// Duration of each travel time window in streaming mode (sec).
+    double _window{0.0};
+
+    /// Function that receives the partial results of each window.
+    window_listener _window_listener;
 };
 
 /// @}
@@ -9,6 +9,8 @@
 #include <usml/ocean/ocean_utils.h>
 #include <usml/sensors/sensor_manager.h>
 #include <usml/sensors/test/simple_sonobuoy.h>
+#include <usml/threads/thread_controller.h>
+#include <usml/threads/thread_pool.h>
 #include <usml/threads/thread_task.h>
 #include <usml/types/seq_linear.h>
 #include <usml/types/seq_vector.h>
@@ -18,11 +20,13 @@
 
 #include <boost/numeric/ublas/vector.hpp>
 #include <boost/test/unit_test.hpp>
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
 #include <iostream>
 #include <list>
 #include <memory>
+#include <vector>
 
 BOOST_AUTO_TEST_SUITE(biverbs_test)
 
@@ -72,6 +76,40 @@ eigenverb_model::csptr create_eigenverb(const wposition1 source_pos,
 
     return eigenverb_model::csptr(verb);
 }
+
+/**
+ * Add a monostatic sonobuoy to the sensor_manager, in an iso-velocity ocean,
+ * and return its sensor pair. The sensor_manager frequencies may differ from
+ * the frequencies of the eigenverbs.
+ */
+sensor_pair::sptr create_pair(const seq_vector::csptr& frequencies) {
+    sensor_manager* smgr = sensor_manager::instance();
+    ocean_utils::make_iso(depth);
+    smgr->frequencies(frequencies);
+
+    sensor_model* sensor = new test::simple_sonobuoy(1, "simple_sonobuoy");
+    sensor->time_maximum(7.0);
+    sensor->compute_reverb(true);
+    smgr->add_sensor(sensor_model::sptr(sensor));
+    return *(smgr->find_source(1).begin());
+}
+
+/**
+ * Build hard-coded eigenverbs on bottom for 8 different DE and 10 different
+ * AZ around a sensor position.
+ */
+eigenverb_collection::csptr create_eigenverbs(
+    const wposition1& sensor_pos, const seq_vector::csptr& frequencies) {
+    auto* collection = new eigenverb_collection(eigenverb_model::BOTTOM);
+    for (double az = 0.0; az <= 90.0; az += az_spacing) {
+        for (double de = -90.0 + de_spacing; de < 0.0; de += de_spacing) {
+            collection->add_eigenverb(
+                create_eigenverb(sensor_pos, depth, de, az, frequencies),
+                eigenverb_model::BOTTOM);
+        }
+    }
+    return eigenverb_collection::csptr(collection);
+}
 }  // namespace
 
 /**
@@ -91,41 +129,18 @@ eigenverb_model::csptr create_eigenverb(const wposition1 source_pos,
 BOOST_AUTO_TEST_CASE(update_wavefront_data) {
     cout << "=== biverbs_test: update_wavefront_data ===" << endl;
     const char* ncname = USML_TEST_DIR "/biverbs/test/";
-    sensor_manager* smgr = sensor_manager::instance();
-
-    ocean_utils::make_iso(depth);
     seq_vector::csptr frequencies(new seq_linear(3000.0, 1.0, 1));
-    smgr->frequencies(frequencies);
-    wposition1 source_pos(15.0, 35.0, 0.0);
-    vector<double> scatter(frequencies->size(), 1.0);
-
-    // construct monostatic sensor pair in the bistatic manager
-
-    sensor_model* sensor_ptr = new test::simple_sonobuoy(1, "simple_sonobuoy");
-    sensor_ptr->time_maximum(7.0);
-    sensor_ptr->compute_reverb(true);
-    sensor_model::sptr sensor(sensor_ptr);
-    smgr->add_sensor(sensor);
-    pair_list blist = smgr->find_source(1);
-    sensor_pair::sptr pair = *(blist.begin());
-
-    // build hard-coded eigenverbs on bottom for varying DE and AZ
-
-    auto* verb_collection = new eigenverb_collection(eigenverb_model::BOTTOM);
-    for (double az = 0.0; az <= 90.0; az += az_spacing) {
-        for (double de = -90.0 + de_spacing; de < 0.0; de += de_spacing) {
-            eigenverb_model::csptr verb = create_eigenverb(
-                sensor->position(), depth, de, az, frequencies);
-            verb_collection->add_eigenverb(verb, eigenverb_model::BOTTOM);
-        }
-    }
+    sensor_pair::sptr pair = create_pair(frequencies);
+    sensor_model::sptr sensor = pair->source();
+    eigenverb_collection::csptr verb_collection =
+        create_eigenverbs(sensor->position(), frequencies);
     {
         std::ostringstream filename;
         filename << ncname << "eigenverbs.nc";
         verb_collection->write_netcdf(filename.str().c_str(),
                                       eigenverb_model::BOTTOM);
     }
-    eigenverb_list eigenverb_list =
+    eigenverb_span eigenverb_list =
         verb_collection->eigenverbs(eigenverb_model::BOTTOM);
     BOOST_CHECK_EQUAL(eigenverb_list.size(), 80);
 
@@ -137,15 +152,15 @@ BOOST_AUTO_TEST_CASE(update_wavefront_data) {
     auto* ray_collection = new eigenray_collection(frequencies, pos1, pos);
     pair->update_wavefront_data(sensor.get(),
                                 eigenray_collection::csptr(ray_collection),
-                                eigenverb_collection::csptr(verb_collection));
+                                verb_collection);
     thread_task::wait();
 
     // extract biverbs, write to disk, and count entries in collection
 
     auto collection = pair->biverbs();
     biverb_list verb_list = collection->biverbs(eigenverb_model::BOTTOM);
-    BOOST_CHECK_EQUAL(verb_list.size(), 182);
-    BOOST_CHECK_EQUAL(collection->size(eigenverb_model::BOTTOM), 182);
+    BOOST_CHECK_EQUAL(verb_list.size(), 109);
+    BOOST_CHECK_EQUAL(collection->size(eigenverb_model::BOTTOM), 109);
     {
         std::ostringstream filename;
         filename << ncname << "biverbs_test.nc";
@@ -156,6 +171,231 @@ BOOST_AUTO_TEST_CASE(update_wavefront_data) {
     sensor_manager::reset();
 }
 
+/**
+ * Tests the ability to stream biverbs in travel time windows. Uses the same
+ * sensor and eigenverbs as update_wavefront_data, but runs the
+ * biverb_generator in the foreground with a 0.5 sec window. At the end of
+ * each window, records the number of biverbs earlier than the end of the
+ * window. Checks that the windows are contiguous, that the last window ends
+ * at infinity, and that every biverb earlier than the end of a window was
+ * already in the collection when that window was published.
+ */
+BOOST_AUTO_TEST_CASE(stream_biverbs) {
+    cout << "=== biverbs_test: stream_biverbs ===" << endl;
+    seq_vector::csptr frequencies(new seq_linear(3000.0, 1.0, 1));
+    sensor_pair::sptr pair = create_pair(frequencies);
+    eigenverb_collection::csptr eigenverbs =
+        create_eigenverbs(pair->source()->position(), frequencies);
+
+    // run biverb generator in the background, recording each window
+
+    struct window_record {
+        double t_min;
+        double t_max;
+        size_t count;
+    };
+    std::vector<window_record> windows;
+    auto generator =
+        std::make_shared<biverb_generator>(pair, eigenverbs, eigenverbs);
+    generator->stream(0.5, [&](const biverb_collection& biverbs, double t_min,
+                               double t_max) {
+        size_t count = 0;
+        for (size_t n = 0; n < biverbs.num_interfaces(); ++n) {
+            count += biverbs.biverbs(n, 0.0, t_max).size();
+        }
+        windows.push_back({t_min, t_max, count});
+    });
+    BOOST_CHECK(generator->streaming());
+    thread_controller::instance()->run(generator);
+    thread_task::wait();
+
+    // compare windows to the final collection
+
+    auto collection = pair->biverbs();
+    BOOST_REQUIRE(collection != nullptr);
+    BOOST_CHECK_EQUAL(collection->size(eigenverb_model::BOTTOM), 109);
+    BOOST_REQUIRE_GT(windows.size(), 2);
+    BOOST_CHECK(std::isinf(windows.back().t_max));
+    bool partial = false;
+    double window_end = 0.0;
+    for (const auto& window : windows) {
+        BOOST_CHECK_EQUAL(window.t_min, window_end);
+        BOOST_CHECK_GT(window.t_max, window.t_min);
+        window_end = window.t_max;
+        size_t count = 0;
+        for (size_t n = 0; n < collection->num_interfaces(); ++n) {
+            count += collection->biverbs(n, 0.0, window.t_max).size();
+        }
+        BOOST_CHECK_EQUAL(window.count, count);
+        partial |= (count > 0 && count < 109);
+    }
+    BOOST_CHECK(partial);
+    sensor_manager::reset();
+}
+
+/**
+ * Tests the monostatic shortcut in the biverb_generator. Uses the same
+ * sensor and eigenverbs as update_wavefront_data. Computes biverbs once with
+ * the same collection for source and receiver, which evaluates each pair
+ * of eigenverbs once, and again with an identical copy of the collection
+ * for the receiver, which evaluates every ordered pair separately. Checks
+ * that both produce the same biverbs.
+ */
+BOOST_AUTO_TEST_CASE(monostatic_biverbs) {
+    cout << "=== biverbs_test: monostatic_biverbs ===" << endl;
+    seq_vector::csptr frequencies(new seq_linear(3000.0, 1.0, 1));
+    sensor_pair::sptr pair = create_pair(frequencies);
+    const wposition1 sensor_pos = pair->source()->position();
+    eigenverb_collection::csptr src_verbs =
+        create_eigenverbs(sensor_pos, frequencies);
+    eigenverb_collection::csptr rcv_verbs =
+        create_eigenverbs(sensor_pos, frequencies);
+
+    // compute biverbs in monostatic and bistatic modes
+
+    std::vector<std::vector<biverb_model::csptr>> results;
+    for (const auto& verbs : {src_verbs, rcv_verbs}) {
+        auto generator =
+            std::make_shared<biverb_generator>(pair, src_verbs, verbs);
+        thread_controller::instance()->run(generator);
+        thread_task::wait();
+        BOOST_REQUIRE(pair->biverbs() != nullptr);
+        biverb_list list = pair->biverbs()->biverbs(eigenverb_model::BOTTOM);
+        results.emplace_back(list.begin(), list.end());
+    }
+
+    // compare biverbs, sorted by travel time and angles
+
+    auto order = [](const biverb_model::csptr& a,
+                    const biverb_model::csptr& b) {
+        if (a->travel_time != b->travel_time) {
+            return a->travel_time < b->travel_time;
+        }
+        if (a->source_de != b->source_de) {
+            return a->source_de < b->source_de;
+        }
+        if (a->source_az != b->source_az) {
+            return a->source_az < b->source_az;
+        }
+        if (a->receiver_de != b->receiver_de) {
+            return a->receiver_de < b->receiver_de;
+        }
+        return a->receiver_az < b->receiver_az;
+    };
+    for (auto& list : results) {
+        std::sort(list.begin(), list.end(), order);
+    }
+    const auto& mono = results[0];
+    const auto& bistatic = results[1];
+    BOOST_CHECK_EQUAL(mono.size(), 109);
+    BOOST_REQUIRE_EQUAL(mono.size(), bistatic.size());
+    for (size_t n = 0; n < mono.size(); ++n) {
+        BOOST_CHECK_EQUAL(mono[n]->travel_time, bistatic[n]->travel_time);
+        BOOST_CHECK_EQUAL(mono[n]->source_de, bistatic[n]->source_de);
+        BOOST_CHECK_EQUAL(mono[n]->source_az, bistatic[n]->source_az);
+        BOOST_CHECK_EQUAL(mono[n]->receiver_de, bistatic[n]->receiver_de);
+        BOOST_CHECK_EQUAL(mono[n]->receiver_az, bistatic[n]->receiver_az);
+        BOOST_CHECK_EQUAL(mono[n]->de_index, bistatic[n]->de_index);
+        BOOST_CHECK_EQUAL(mono[n]->az_index, bistatic[n]->az_index);
+        BOOST_CHECK_CLOSE(mono[n]->duration, bistatic[n]->duration, 1e-6);
+        BOOST_CHECK_CLOSE(mono[n]->power[0], bistatic[n]->power[0], 1e-6);
+    }
+    sensor_manager::reset();
+}
+
+/**
+ * Tests biverbs for eigenverbs whose frequencies differ from the
+ * sensor_manager frequencies. This happens when the sensor_manager
+ * frequencies change while tasks are in flight, or when eigenverbs are
+ * loaded from a snapshot. Checks that the biverbs are computed at the
+ * eigenverb frequencies.
+ */
+BOOST_AUTO_TEST_CASE(eigenverb_frequencies) {
+    cout << "=== biverbs_test: eigenverb_frequencies ===" << endl;
+    seq_vector::csptr frequencies(new seq_linear(3000.0, 1.0, 1));
+    sensor_pair::sptr pair =
+        create_pair(seq_vector::csptr(new seq_linear(1000.0, 1000.0, 4)));
+    eigenverb_collection::csptr eigenverbs =
+        create_eigenverbs(pair->source()->position(), frequencies);
+
+    auto generator =
+        std::make_shared<biverb_generator>(pair, eigenverbs, eigenverbs);
+    thread_controller::instance()->run(generator);
+    thread_task::wait();
+
+    auto collection = pair->biverbs();
+    BOOST_REQUIRE(collection != nullptr);
+    BOOST_CHECK_EQUAL(collection->size(eigenverb_model::BOTTOM), 109);
+    for (const auto& biverb : collection->biverbs(eigenverb_model::BOTTOM)) {
+        BOOST_CHECK_EQUAL(biverb->frequencies->size(), 1);
+        BOOST_CHECK_EQUAL(biverb->power.size(), 1);
+    }
+    sensor_manager::reset();
+}
+
+/**
+ * Regression test for the overlap of a bistatic pair of eigenverbs that are
+ * tilted relative to each other. The source eigenverb is ahead and to the
+ * left of the receiver eigenverb, so the cross term in the overlap, which
+ * depends on the sign of xs*ys, is negative. Compares the power of the
+ * biverb to an independent computation of the integral of the product of
+ * the two Gaussians, using their 2x2 covariance matrices in the frame of
+ * the receiver eigenverb (x to the right, y along its direction).
+ */
+BOOST_AUTO_TEST_CASE(bistatic_overlap) {
+    cout << "=== biverbs_test: bistatic_overlap ===" << endl;
+    seq_vector::csptr frequencies(new seq_linear(3000.0, 1.0, 1));
+    const wposition1 center(15.0, 35.0, -depth);
+    const double range = 200.0;
+    const double bearing = -M_PI / 4.0;
+    const double alpha = M_PI / 6.0;
+
+    auto* rcv = new eigenverb_model(
+        *create_eigenverb(center, depth, -45.0, 0.0, frequencies));
+    rcv->position = center;
+    rcv->direction = 0.0;
+    rcv->length = 100.0;
+    rcv->width = 40.0;
+    eigenverb_model::csptr rcv_verb(rcv);
+
+    auto* src = new eigenverb_model(*rcv);
+    src->position = wposition1(center, range, bearing);
+    src->direction = alpha;
+    src->length = 150.0;
+    src->width = 50.0;
+    eigenverb_model::csptr src_verb(src);
+
+    const vector<double> scatter(frequencies->size(), 0.01);
+    biverb_collection collection;
+    collection.add_biverb(src_verb, rcv_verb, scatter, eigenverb_model::BOTTOM);
+    biverb_list list = collection.biverbs(eigenverb_model::BOTTOM);
+    BOOST_REQUIRE_EQUAL(list.size(), 1);
+
+    // covariance of the sum of the Gaussians
+
+    const double ls2 = src->length * src->length;
+    const double ws2 = src->width * src->width;
+    const double sxx =
+        ls2 * sin(alpha) * sin(alpha) + ws2 * cos(alpha) * cos(alpha);
+    const double syy =
+        ls2 * cos(alpha) * cos(alpha) + ws2 * sin(alpha) * sin(alpha);
+    const double sxy = (ls2 - ws2) * sin(alpha) * cos(alpha);
+    const double mxx = sxx + rcv->width * rcv->width;
+    const double myy = syy + rcv->length * rcv->length;
+    const double mxy = sxy;
+    const double det = mxx * myy - mxy * mxy;
+
+    // overlap at the offset between the Gaussians
+
+    const double xs = range * sin(bearing);
+    const double ys = range * cos(bearing);
+    const double quad = (myy * xs * xs - 2.0 * mxy * xs * ys + mxx * ys * ys) /
+                        det;
+    const double expected = 0.25 * 0.5 * src->power[0] * rcv->power[0] *
+                            scatter[0] * exp(-0.5 * quad) / sqrt(det);
+    BOOST_CHECK_CLOSE(list.front()->power[0], expected, 0.01);
+}
+
 /// @}
 
 BOOST_AUTO_TEST_SUITE_END()
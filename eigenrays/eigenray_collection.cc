@@ -6,6 +6,11 @@
 #include <ncvalues.h>
 #include <netcdfcpp.h>
 #include <usml/eigenrays/eigenray_collection.h>
+#include <usml/netcdf/columnar_file.h>
+#include <usml/netcdf/columnar_writer.h>
+#include <usml/netcdf/netcdf_utils.h>
+#include <usml/threads/thread_controller.h>
+#include <usml/threads/thread_pool.h>
 #include <usml/types/wvector1.h>
 #include <usml/ublas/math_traits.h>
 
@@ -15,8 +20,52 @@
 #include <cmath>
 #include <complex>
 #include <list>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
 
 using namespace usml::eigenrays;
+using namespace usml::netcdf;
+using namespace usml::threads;
+
+namespace {
+
+/**
+ * Compute the change in sensor position in the local tangent plane.
+ * Changes smaller than 1 mm are set to zero.
+ *
+ * @param oldpos    Original sensor location.
+ * @param newpos    Updated sensor location.
+ * @param dir       Change in rho, theta, and phi directions (m, output).
+ */
+void position_change(const wposition1 &oldpos, const wposition1 &newpos,
+                     double dir[3]) {
+    dir[0] = newpos.rho() - oldpos.rho();
+    dir[1] = (newpos.theta() - oldpos.theta()) * oldpos.rho();
+    dir[2] = (newpos.phi() - oldpos.phi()) * oldpos.rho() * sin(oldpos.theta());
+    if (dir[0] * dir[0] + dir[1] * dir[1] + dir[2] * dir[2] < 1e-6) {
+        dir[0] = dir[1] = dir[2] = 0.0;
+    }
+}
+
+/**
+ * Compute the component of a position change along the direction of a ray.
+ *
+ * @param dir       Change in rho, theta, and phi directions (m).
+ * @param de        Depression/elevation angle of the ray (deg).
+ * @param az        Azimuthal angle of the ray (deg).
+ * @return          Change in slant range along the ray (m).
+ */
+double range_change(const double dir[3], double de, double az) {
+    de = to_radians(de);
+    az = to_radians(az);
+    const double cos_de = cos(de);
+    return dir[0] * sin(de) - dir[1] * cos_de * cos(az) +
+           dir[2] * cos_de * sin(az);
+}
+
+}  // namespace
 
 /**
  * Initialize the acoustic propagation effects associated
@@ -52,34 +101,58 @@ eigenray_collection::eigenray_collection(const seq_vector::csptr &frequencies,
             } else {
                 _targetIDs(t1, t2) = 0;
             }
+            if (_targetIDs(t1, t2) != 0) {  // first occurrence wins
+                _target_index.emplace(_targetIDs(t1, t2),
+                                      std::make_pair(t1, t2));
+            }
         }
     }
 }
 
+/**
+ * Find the row and column of a single target in the grid.
+ */
+bool eigenray_collection::find_target(uint64_t targetID, size_t *t1,
+                                      size_t *t2) const {
+    if (size1() == 0 || size2() == 0) {
+        return false;
+    }
+    if (targetID == 0) {
+        *t1 = 0;
+        *t2 = 0;
+        return true;
+    }
+    auto found = _target_index.find(targetID);
+    if (found == _target_index.end()) {
+        return false;
+    }
+    *t1 = found->second.first;
+    *t2 = found->second.second;
+    return true;
+}
+
 /**
  * Find eigenrays for a single target in the grid.
  */
-eigenray_list eigenray_collection::find_eigenrays(uint64_t targetID) const {
-    for (size_t t1 = 0; t1 < size1(); ++t1) {
-        for (size_t t2 = 0; t2 < size2(); ++t2) {
-            if (_targetIDs(t1, t2) == targetID || targetID == 0) {
-                return eigenrays(t1, t2);
-            }
-        }
+const eigenray_list &eigenray_collection::find_eigenrays(
+    uint64_t targetID) const {
+    static const eigenray_list empty;
+    size_t t1;
+    size_t t2;
+    if (find_target(targetID, &t1, &t2)) {
+        return eigenrays(t1, t2);
     }
-    return {};
+    return empty;
 }
 
 /**
  * Find fastest eigenray for a single target in the grid.
  */
 double eigenray_collection::find_initial_time(uint64_t targetID) const {
-    for (size_t t1 = 0; t1 < size1(); ++t1) {
-        for (size_t t2 = 0; t2 < size2(); ++t2) {
-            if (_targetIDs(t1, t2) == targetID || targetID == 0) {
-                return initial_time(t1, t2);
-            }
-        }
+    size_t t1;
+    size_t t2;
+    if (find_target(targetID, &t1, &t2)) {
+        return initial_time(t1, t2);
     }
     return 0.0;
 }
@@ -105,85 +178,126 @@ void eigenray_collection::add_eigenray(size_t t1, size_t t2,
  * Compute propagation loss summed over all eigenrays.
  */
 void eigenray_collection::sum_eigenrays() {
-    for (size_t t1 = 0; t1 < size1(); ++t1) {
-        for (size_t t2 = 0; t2 < size2(); ++t2) {
-            const eigenray_list &ray_list = eigenrays(t1, t2);
-            eigenray_model &total = _total(t1, t2);
-
-            double time = 0.0;
-            double source_de = 0.0;
-            double source_az_x = 0.0;  // east/west component
-            double source_az_y = 0.0;  // north/south component
-            double target_de = 0.0;
-            double target_az_x = 0.0;  // east/west component
-            double target_az_y = 0.0;  // north/south component
-            int surface = -1;
-            int bottom = -1;
-            int caustic = -1;
-            double wgt = 0.0;
-            double max_a = 0.0;
-
-            // compute at each frequency
-
-            for (size_t f = 0; f < _frequencies->size(); ++f) {
-                // sum complex amplitudes over eigenrays
-
-                std::complex<double> phasor(0.0, 0.0);
-                for (const auto &ray : ray_list) {
-                    // pressure amplitude
-
-                    double a =
-                        pow(10.0, ray->intensity(f) / -20.0);  // pressure
-                    if (_coherent) {
-                        double p =
-                            TWO_PI * (*_frequencies)(f)*ray->travel_time +
-                            ray->phase(f);
-                        p = fmod(p, TWO_PI);  // large phases bad for cos,sin
-                        std::complex<double> value(a * cos(p), a * sin(p));
-                        phasor += value;
-                    } else {
-                        phasor += a;
-                    }
-
-                    // other eigenray terms
-
-                    a *= a;  // scale by the pressure squared
-                    wgt += a;
-                    time += a * ray->travel_time;
-                    source_de += a * ray->source_de;
-                    source_az_x += a * sin(to_radians(ray->source_az));
-                    source_az_y += a * cos(to_radians(ray->source_az));
-                    target_de += a * ray->target_de;
-                    target_az_x += a * sin(to_radians(ray->target_az));
-                    target_az_y += a * cos(to_radians(ray->target_az));
-                    if (a > max_a) {
-                        max_a = a;
-                        surface = ray->surface;
-                        bottom = ray->bottom;
-                        caustic = ray->caustic;
-                    }
-                }  // end eigenray_list
-
-                // convert back into intensity (dB) and phase (radians) values
-
-                total.intensity(f) = -20.0 * log10(max(1e-15, abs(phasor)));
-                total.phase(f) = arg(phasor);
-            }  // end frequency
-
-            // weighted average of other eigenray terms
-
-            total.travel_time = time / wgt;
-            total.source_de = source_de / wgt;
-            total.source_az =
-                90.0 - to_degrees(atan2(source_az_y, source_az_x));
-            total.target_de = target_de / wgt;
-            total.target_az =
-                90.0 - to_degrees(atan2(target_az_y, target_az_x));
-            total.surface = surface;
-            total.bottom = bottom;
-            total.caustic = caustic;
-        }  // end target size2
-    }      // end target size1
+    const size_t num_targets = size1() * size2();
+    const size_t work = (size_t)_num_eigenrays * _frequencies->size();
+    if (work < min_parallel_size) {
+        sum_targets(0, num_targets);
+        return;
+    }
+
+    // split targets into contiguous blocks for the thread pool
+
+    thread_controller::instance()->run_blocks(
+        num_targets,
+        [this](size_t first, size_t last) { sum_targets(first, last); });
+}
+
+/**
+ * Compute propagation loss summed over all eigenrays for a block of targets.
+ */
+void eigenray_collection::sum_targets(size_t first, size_t last) {
+    static const double DB_TO_PRESSURE = -log(10.0) / 20.0;
+    const size_t num_freq = _frequencies->size();
+    std::vector<double> frequencies(num_freq);
+    for (size_t f = 0; f < num_freq; ++f) {
+        frequencies[f] = (*_frequencies)(f);
+    }
+    std::vector<double> amplitude(num_freq);
+    std::vector<double> phase(num_freq);
+    std::vector<double> real(num_freq);
+    std::vector<double> imag(num_freq);
+
+    for (size_t n = first; n < last; ++n) {
+        const size_t t1 = n / size2();
+        const size_t t2 = n % size2();
+        const eigenray_list &ray_list = eigenrays(t1, t2);
+        eigenray_model &total = _total(t1, t2);
+
+        double time = 0.0;
+        double source_de = 0.0;
+        double source_az_x = 0.0;  // east/west component
+        double source_az_y = 0.0;  // north/south component
+        double target_de = 0.0;
+        double target_az_x = 0.0;  // east/west component
+        double target_az_y = 0.0;  // north/south component
+        int surface = -1;
+        int bottom = -1;
+        int caustic = -1;
+        double wgt = 0.0;
+        double max_a = 0.0;
+        std::fill(real.begin(), real.end(), 0.0);
+        std::fill(imag.begin(), imag.end(), 0.0);
+
+        // sum complex amplitudes over eigenrays
+
+        for (const auto &ray : ray_list) {
+            // pressure amplitude at each frequency
+
+            double weight = 0.0;
+            double peak = 0.0;
+            for (size_t f = 0; f < num_freq; ++f) {
+                const double a = exp(ray->intensity(f) * DB_TO_PRESSURE);
+                amplitude[f] = a;
+                weight += a * a;  // scale by the pressure squared
+                peak = max(peak, a * a);
+            }
+
+            // add phasors at each frequency
+
+            if (_coherent) {
+                for (size_t f = 0; f < num_freq; ++f) {
+                    // large phases bad for cos,sin, so keep fractional cycles
+                    double cycles = frequencies[f] * ray->travel_time;
+                    cycles -= floor(cycles);
+                    phase[f] = TWO_PI * cycles + ray->phase(f);
+                }
+                for (size_t f = 0; f < num_freq; ++f) {
+                    real[f] += amplitude[f] * cos(phase[f]);
+                    imag[f] += amplitude[f] * sin(phase[f]);
+                }
+            } else {
+                for (size_t f = 0; f < num_freq; ++f) {
+                    real[f] += amplitude[f];
+                }
+            }
+
+            // other eigenray terms, weighted once per eigenray
+
+            wgt += weight;
+            time += weight * ray->travel_time;
+            source_de += weight * ray->source_de;
+            source_az_x += weight * sin(to_radians(ray->source_az));
+            source_az_y += weight * cos(to_radians(ray->source_az));
+            target_de += weight * ray->target_de;
+            target_az_x += weight * sin(to_radians(ray->target_az));
+            target_az_y += weight * cos(to_radians(ray->target_az));
+            if (peak > max_a) {
+                max_a = peak;
+                surface = ray->surface;
+                bottom = ray->bottom;
+                caustic = ray->caustic;
+            }
+        }  // end eigenray_list
+
+        // convert back into intensity (dB) and phase (radians) values
+
+        for (size_t f = 0; f < num_freq; ++f) {
+            const std::complex<double> phasor(real[f], imag[f]);
+            total.intensity(f) = -20.0 * log10(max(1e-15, abs(phasor)));
+            total.phase(f) = arg(phasor);
+        }
+
+        // weighted average of other eigenray terms
+
+        total.travel_time = time / wgt;
+        total.source_de = source_de / wgt;
+        total.source_az = 90.0 - to_degrees(atan2(source_az_y, source_az_x));
+        total.target_de = target_de / wgt;
+        total.target_az = 90.0 - to_degrees(atan2(target_az_y, target_az_x));
+        total.surface = surface;
+        total.bottom = bottom;
+        total.caustic = caustic;
+    }  // end target
 }
 
 /**
@@ -192,6 +306,7 @@ void eigenray_collection::sum_eigenrays() {
 void eigenray_collection::write_netcdf(const char *filename,
                                        const char *long_name) const {
     // clang-format off
+    std::lock_guard<std::mutex> lock(netcdf_utils::mutex());
     auto *nc_file = new NcFile(filename, NcFile::Replace);
     if (long_name != nullptr) {
         nc_file->add_att("long_name", long_name);
@@ -393,6 +508,234 @@ eigenray_list eigenray_collection::dead_reckon(
                            target_new, profile);
 }
 
+/**
+ * Write eigenray_collection data to a columnar file.
+ */
+void eigenray_collection::write_columnar(const char *filename,
+                                         const char *long_name) const {
+    columnar_file file;
+    if (long_name != nullptr) {
+        file.attribute("long_name", long_name);
+    }
+    file.attribute("Conventions", "COARDS");
+
+    // source and target parameters
+
+    const size_t rows = _target_pos.size1();
+    const size_t cols = _target_pos.size2();
+    const size_t num_freqs = _frequencies->size();
+    file.add("sourceID", "count", (int64_t)_sourceID);
+    file.add("source_latitude", "degrees_north", _source_pos.latitude());
+    file.add("source_longitude", "degrees_east", _source_pos.longitude());
+    file.add("source_altitude", "meters", _source_pos.altitude());
+    std::vector<int64_t> targetIDs(_targetIDs.data().begin(),
+                                   _targetIDs.data().end());
+    file.add("targetID", "count", {rows, cols}, targetIDs.data());
+    file.add("latitude", "degrees_north", {rows, cols},
+             _target_pos.latitude().data().begin());
+    file.add("longitude", "degrees_east", {rows, cols},
+             _target_pos.longitude().data().begin());
+    file.add("altitude", "meters", {rows, cols},
+             _target_pos.altitude().data().begin());
+    file.add("initial_time", "seconds", {rows, cols},
+             _initial_time.data().begin());
+    file.add("frequencies", "hertz", {num_freqs},
+             _frequencies->data().begin());
+
+    // summed propagation loss for each target, followed by its eigenrays
+
+    const size_t num_records = _num_eigenrays + rows * cols;
+    std::vector<int64_t> proploss_index;
+    std::vector<int64_t> eigenray_index;
+    std::vector<int64_t> eigenray_num;
+    std::vector<double> intensity;
+    std::vector<double> phase;
+    std::vector<double> travel_time;
+    std::vector<double> source_de;
+    std::vector<double> source_az;
+    std::vector<double> target_de;
+    std::vector<double> target_az;
+    std::vector<int16_t> surface;
+    std::vector<int16_t> bottom;
+    std::vector<int16_t> caustic;
+    std::vector<int16_t> upper;
+    std::vector<int16_t> lower;
+    intensity.reserve(num_records * num_freqs);
+    phase.reserve(num_records * num_freqs);
+    auto add_record = [&](const eigenray_model &ray) {
+        intensity.insert(intensity.end(), ray.intensity.begin(),
+                         ray.intensity.end());
+        phase.insert(phase.end(), ray.phase.begin(), ray.phase.end());
+        travel_time.push_back(ray.travel_time);
+        source_de.push_back(ray.source_de);
+        source_az.push_back(ray.source_az);
+        target_de.push_back(ray.target_de);
+        target_az.push_back(ray.target_az);
+        surface.push_back((int16_t)ray.surface);
+        bottom.push_back((int16_t)ray.bottom);
+        caustic.push_back((int16_t)ray.caustic);
+        upper.push_back((int16_t)ray.upper);
+        lower.push_back((int16_t)ray.lower);
+    };
+    for (size_t t1 = 0; t1 < rows; ++t1) {
+        for (size_t t2 = 0; t2 < cols; ++t2) {
+            proploss_index.push_back((int64_t)travel_time.size());
+            eigenray_index.push_back((int64_t)travel_time.size() + 1);
+            eigenray_num.push_back((int64_t)_eigenrays(t1, t2).size());
+            add_record(_total(t1, t2));
+            for (const auto &ray : _eigenrays(t1, t2)) {
+                add_record(*ray);
+            }
+        }
+    }
+    const size_t records = travel_time.size();
+    file.add("proploss_index", "count", {rows, cols}, proploss_index.data());
+    file.add("eigenray_index", "count", {rows, cols}, eigenray_index.data());
+    file.add("eigenray_num", "count", {rows, cols}, eigenray_num.data());
+    file.add("intensity", "dB", {records, num_freqs}, intensity.data());
+    file.add("phase", "radians", {records, num_freqs}, phase.data());
+    file.add("travel_time", "seconds", travel_time);
+    file.add("source_de", "degrees", source_de);
+    file.add("source_az", "degrees_true", source_az);
+    file.add("target_de", "degrees", target_de);
+    file.add("target_az", "degrees_true", target_az);
+    file.add("surface", "count", surface);
+    file.add("bottom", "count", bottom);
+    file.add("caustic", "count", caustic);
+    file.add("upper", "count", upper);
+    file.add("lower", "count", lower);
+    columnar_writer::instance()->write(filename, std::move(file));
+}
+
+/**
+ * Reverse the sense of source and target for a list of eigenrays.
+ * Each copy still allocates its own intensity and phase vectors.
+ */
+eigenray_list eigenray_collection::reciprocal(const eigenray_list &eigenrays) {
+    auto pool = std::make_shared<std::vector<eigenray_model> >();
+    pool->reserve(eigenrays.size());
+    for (const auto &ray : eigenrays) {
+        pool->push_back(*ray);
+    }
+    eigenray_list result;
+    for (auto &ray : *pool) {
+        std::swap(ray.source_de, ray.target_de);
+        std::swap(ray.source_az, ray.target_az);
+        result.push_back(eigenray_model::csptr(pool, &ray));
+    }
+    return result;
+}
+
+/**
+ * Adjust eigenrays for small changes in the geometry of the source and
+ * all targets.
+ */
+matrix<eigenray_list> eigenray_collection::dead_reckon(
+    const wposition1 &source_new, const wposition &target_new,
+    const profile_model::csptr &profile) const {
+    const size_t num_targets = size1() * size2();
+    matrix<eigenray_list> result(size1(), size2());
+
+    // compute sound speed at original source and target positions
+
+    wposition position(num_targets + 1, 1);
+    position.rho(0, 0, _source_pos.rho());
+    position.theta(0, 0, _source_pos.theta());
+    position.phi(0, 0, _source_pos.phi());
+    for (size_t n = 0; n < num_targets; ++n) {
+        const size_t t1 = n / size2();
+        const size_t t2 = n % size2();
+        position.rho(n + 1, 0, _target_pos.rho(t1, t2));
+        position.theta(n + 1, 0, _target_pos.theta(t1, t2));
+        position.phi(n + 1, 0, _target_pos.phi(t1, t2));
+    }
+    matrix<double> speed(num_targets + 1, 1);
+    profile->sound_speed(position, &speed);
+
+    // copy eigenrays into a single pool
+
+    auto pool = std::make_shared<std::vector<eigenray_model> >();
+    pool->reserve(_num_eigenrays);
+    for (size_t n = 0; n < num_targets; ++n) {
+        for (const auto &ray : _eigenrays(n / size2(), n % size2())) {
+            pool->push_back(*ray);
+        }
+    }
+    const size_t num_rays = pool->size();
+    if (num_rays == 0) {
+        return result;
+    }
+
+    // adjust travel times for source motion, then target motion,
+    // and record the ranges before and after each adjustment
+
+    double source_dir[3];
+    position_change(_source_pos, source_new, source_dir);
+    const double source_speed = speed(0, 0);
+    wposition location(num_rays, 4);
+    matrix<double> distance(num_rays, 4);
+    size_t index = 0;
+    for (size_t n = 0; n < num_targets; ++n) {
+        const size_t t1 = n / size2();
+        const size_t t2 = n % size2();
+        double target_dir[3];
+        position_change(wposition1(_target_pos, t1, t2),
+                        wposition1(target_new, t1, t2), target_dir);
+        const double target_speed = speed(n + 1, 0);
+        for (size_t count = _eigenrays(t1, t2).size(); count > 0; --count) {
+            eigenray_model &ray = (*pool)[index];
+            const double dr_source =
+                range_change(source_dir, ray.source_de, ray.source_az);
+            const double dr_target =
+                range_change(target_dir, ray.source_de, ray.source_az);
+            distance(index, 0) = ray.travel_time * source_speed;
+            distance(index, 1) = distance(index, 0) + dr_source;
+            ray.travel_time += dr_source / source_speed;
+            distance(index, 2) = ray.travel_time * target_speed;
+            distance(index, 3) = distance(index, 2) + dr_target;
+            ray.travel_time += dr_target / target_speed;
+            for (size_t c = 0; c < 4; ++c) {
+                const size_t p = (c < 2) ? 0 : n + 1;
+                location.rho(index, c, position.rho(p, 0));
+                location.theta(index, c, position.theta(p, 0));
+                location.phi(index, c, position.phi(p, 0));
+            }
+            ++index;
+        }
+    }
+
+    // replace spreading and attenuation loss at each range
+
+    matrix<vector<double> > atten(num_rays, 4);
+    profile->attenuation(location, _frequencies, distance, &atten);
+    for (index = 0; index < num_rays; ++index) {
+        eigenray_model &ray = (*pool)[index];
+        const double spreading =
+            20.0 * log10((distance(index, 1) / distance(index, 0)) *
+                         (distance(index, 3) / distance(index, 2)));
+        const vector<double> &a0 = atten(index, 0);
+        const vector<double> &a1 = atten(index, 1);
+        const vector<double> &a2 = atten(index, 2);
+        const vector<double> &a3 = atten(index, 3);
+        for (size_t f = 0; f < ray.intensity.size(); ++f) {
+            ray.intensity[f] += spreading + (a1[f] - a0[f]) + (a3[f] - a2[f]);
+        }
+    }
+
+    // share the pool between the eigenrays for each target
+
+    index = 0;
+    for (size_t n = 0; n < num_targets; ++n) {
+        const size_t t1 = n / size2();
+        const size_t t2 = n % size2();
+        for (size_t count = _eigenrays(t1, t2).size(); count > 0; --count) {
+            result(t1, t2).push_back(
+                eigenray_model::csptr(pool, &(*pool)[index++]));
+        }
+    }
+    return result;
+}
+
 /**
  * Adjust eigenrays for small changes in the geometry of a single sensor.
  */
@@ -401,71 +744,51 @@ eigenray_list eigenray_collection::dead_reckon_one(
     const wposition1 &newpos, const profile_model::csptr &profile) {
     // compute position change in local tangent plane
 
-    double dir[3] = {newpos.rho() - oldpos.rho(),
-                     newpos.theta() - oldpos.theta(),
-                     newpos.phi() - oldpos.phi()};
-    dir[1] *= oldpos.rho();
-    dir[2] *= oldpos.rho() * sin(oldpos.theta());
+    double dir[3];
+    position_change(oldpos, newpos, dir);
 
     // short cut if change very small
 
-    if (dir[0] * dir[0] + dir[1] * dir[1] + dir[2] * dir[2] < 1e-6) {
+    if (dir[0] == 0.0 && dir[1] == 0.0 && dir[2] == 0.0) {
         return eigenrays;
     }
 
     // compute sound speed at original position
 
-    matrix<double> c(1, 1);
-    wposition position(1, 1);
-    position.rho(0, 0, oldpos.rho());
-    position.theta(0, 0, oldpos.theta());
-    position.phi(0, 0, oldpos.phi());
+    matrix<double> c(1, 2);
+    wposition position(1, 2);
+    for (size_t n = 0; n < 2; ++n) {
+        position.rho(0, n, oldpos.rho());
+        position.theta(0, n, oldpos.theta());
+        position.phi(0, n, oldpos.phi());
+    }
     profile->sound_speed(position, &c);
     const double sound_speed = c(0, 0);
 
     // apply changes to each eigenray
 
     eigenray_list new_list;
+    matrix<double> distance(1, 2);
+    matrix<vector<double> > atten(1, 2);
     for (const auto &ray : eigenrays) {
         auto *new_ray = new eigenray_model(*ray);
 
-        // compute ray direction in local tangent plane
-
-        const double de = to_radians(ray->source_de);
-        const double az = to_radians(ray->source_az);
-        const double cos_de = cos(de);
-        const double sin_de = sin(de);
-        const double cos_az = cos(az);
-        const double sin_az = sin(az);
-        const double raydir[3] = {sin_de, -cos_de * cos_az, cos_de * sin_az};
-
         // change in range is proportional to the component of
         // slant range along the direction of the ray
 
-        const double dr =
-            (dir[0] * raydir[0] + dir[1] * raydir[1] + dir[2] * raydir[2]);
+        const double dr = range_change(dir, ray->source_de, ray->source_az);
         new_ray->travel_time = ray->travel_time + dr / sound_speed;
 
         // compute change in intensity along ray path
         // approximating TL = 20*log10(r) + alpha * r + b
 
-        matrix<double> distance(1, 1);
-        matrix<vector<double> > atten(1, 1);
-        atten(0, 0).resize(ray->frequencies->size());
-        const double r1 = ray->travel_time * sound_speed;
-        const double r2 = r1 + dr;
-
-        for (int f = 0; f < ray->frequencies->size(); ++f) {
-            // remove old spreading and attenuation
-            distance(0, 0) = r1;
-            profile->attenuation(position, ray->frequencies, distance, &atten);
-            const double offset =
-                ray->intensity[f] - 20.0 * log10(r1) - atten(0, 0)[f];
-
-            // add new spreading and attenuation
-            distance(0, 0) = r2;
-            profile->attenuation(position, ray->frequencies, distance, &atten);
-            new_ray->intensity[f] = 20.0 * log10(r2) + atten(0, 0)[f] + offset;
+        distance(0, 0) = ray->travel_time * sound_speed;
+        distance(0, 1) = distance(0, 0) + dr;
+        profile->attenuation(position, ray->frequencies, distance, &atten);
+        const double spreading = 20.0 * log10(distance(0, 1) / distance(0, 0));
+        for (size_t f = 0; f < ray->frequencies->size(); ++f) {
+            new_ray->intensity[f] =
+                ray->intensity[f] + spreading + atten(0, 1)[f] - atten(0, 0)[f];
         }
         new_list.push_back(eigenray_model::csptr(new_ray));
     }
@@ -16,6 +16,8 @@
 #include <boost/numeric/ublas/matrix.hpp>
 #include <cstddef>
 #include <memory>
+#include <unordered_map>
+#include <utility>
 
 namespace usml {
 namespace eigenrays {
@@ -117,13 +119,27 @@ class USML_DECLSPEC eigenray_collection : public eigenray_listener {
         return _initial_time(t1, t2);
     }
 
+    /**
+     * Find the row and column of a single target in the grid. Uses a hash
+     * table built during construction, so the cost of this lookup does not
+     * depend on the number of targets. A targetID of zero matches the first
+     * target in the grid.
+     *
+     * @param   targetID	  Platform ID number for this target.
+     * @param   t1  		Row number of target (output).
+     * @param   t2  		Column number of target (output).
+     * @return  False if this target is not in the grid.
+     */
+    bool find_target(uint64_t targetID, size_t *t1, size_t *t2) const;
+
     /**
      * Find eigenrays for a single target in the grid.
      *
      * @param   targetID	  Platform ID number for this target.
      * @return  List of acoustic paths between a source and target.
+     *          Empty list if target not found.
      */
-    eigenray_list find_eigenrays(uint64_t targetID = 0) const;
+    const eigenray_list &find_eigenrays(uint64_t targetID = 0) const;
 
     /**
      * Find fastest eigenray for a single target in the grid.
@@ -163,7 +179,14 @@ class USML_DECLSPEC eigenray_collection : public eigenray_listener {
     void add_eigenray(size_t t1, size_t t2, eigenray_model::csptr ray,
                       size_t runID = 0);
     /**
-     * Compute propagation loss summed over all eigenrays.
+     * Compute propagation loss summed over all eigenrays. Terms that do not
+     * depend on frequency, like the weighted averages of travel time and
+     * angles, are computed once per eigenray. Pressure amplitudes and
+     * phases are computed in contiguous arrays across frequency, so that
+     * the inner loops can be vectorized. Large collections are split into
+     * blocks of targets that are summed on the thread_controller pool.
+     * When called from a pool task, the targets are summed on the calling
+     * thread instead.
      */
     void sum_eigenrays();
 
@@ -290,6 +313,22 @@ class USML_DECLSPEC eigenray_collection : public eigenray_listener {
     void write_netcdf(const char *filename,
                       const char *long_name = nullptr) const;
 
+    /**
+     * Write eigenray_collection data to a columnar file, using the same
+     * variable names, ragged array structure, and units as write_netcdf().
+     * Copies the data into a columnar_file, then returns while the file is
+     * written by the columnar_writer on a background I/O thread. Use
+     * columnar_writer::instance()->flush() to wait for the file to finish.
+     *
+     * The user is responsible for ensuring that sum_eigenrays() has been
+     * called prior to this routine.
+     *
+     * @param filename  Filename used to store this data.
+     * @param long_name Optional global attribute for identifying data-set.
+     */
+    void write_columnar(const char *filename,
+                        const char *long_name = nullptr) const;
+
     /**
      * Adjust eigenrays for small changes in source/target geometry. Adjusts the
      * travel time and intensity using the component of position change along
@@ -313,13 +352,53 @@ class USML_DECLSPEC eigenray_collection : public eigenray_listener {
                               const wposition1 &target_new,
                               const profile_model::csptr &profile) const;
 
+    /**
+     * Reverse the sense of source and target for a list of eigenrays. Used
+     * when eigenrays computed from a receiver's wavefront are used as the
+     * direct paths for a bistatic source. The eigenray_model copies are
+     * stored in a single pool, which is released when the last of them is
+     * released. This is still a deep copy: the intensity and phase vectors
+     * of each eigenray are allocated separately. Callers that do not need
+     * reversed angles should share the original list instead.
+     *
+     * @param eigenrays     List of acoustic paths to reverse.
+     * @return              Eigenrays with source and target angles swapped.
+     */
+    static eigenray_list reciprocal(const eigenray_list &eigenrays);
+
+    /**
+     * Adjust eigenrays for small changes in the geometry of the source and
+     * all of the targets in this collection. Produces the same results as
+     * calling dead_reckon() for each target, but makes a single sound speed
+     * query for all of the sensors, and a single attenuation query for all
+     * of the eigenrays. The adjusted eigenrays are stored in a single pool,
+     * which is released when the last of them is released. Assumes that all
+     * eigenrays use the frequencies of this collection.
+     *
+     * @param source_new 	Updated source location.
+     * @param target_new 	Updated target locations. Must be the same size as
+     *                      the targets in this collection.
+     * @param profile       Ocean profile model used to extract sound speed.
+     * @return              Adjusted eigenrays for each target.
+     */
+    matrix<eigenray_list> dead_reckon(
+        const wposition1 &source_new, const wposition &target_new,
+        const profile_model::csptr &profile) const;
+
    private:
+    /// Lookup table from target ID to its row and column in the target grid.
+    typedef std::unordered_map<uint64_t, std::pair<size_t, size_t>>
+        target_index_type;
+
     /// Value to find source in platform_manager. Set to zero if unknown.
     const uint64_t _sourceID;
 
     /// Value to find targets in platform_manager. Set to zero if unknown.
     matrix<uint64_t> _targetIDs;
 
+    /// Lookup table from target ID to its row and column in the target grid.
+    target_index_type _target_index;
+
     /**
      * Location of the wavefront source in spherical earth coordinates.
      * Linked from wavefront object so we can write it to a netCDF file.
@@ -359,6 +438,19 @@ class USML_DECLSPEC eigenray_collection : public eigenray_listener {
     /// Compute coherent propagation totals if true, and incoherent if false.
     bool _coherent;
 
+    /// Minimum number of eigenray frequencies needed to sum in parallel.
+    static const size_t min_parallel_size = 100000;
+
+    /**
+     * Compute propagation loss summed over all eigenrays for a block of
+     * targets. Each block writes to a separate set of totals, so blocks
+     * can be computed in parallel.
+     *
+     * @param first     Row major index of the first target in the block.
+     * @param last      Row major index one past the last target in the block.
+     */
+    void sum_targets(size_t first, size_t last);
+
     /**
      * Adjust eigenrays for small changes in the geometry of a single sensor.
      * Adjusts the travel time and intensity using the component of position
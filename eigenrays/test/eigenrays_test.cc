@@ -2,9 +2,13 @@
  * @example eigenrays/test/eigenrays_test.cc
  */
 #include <usml/eigenrays/eigenrays.h>
+#include <usml/netcdf/columnar_writer.h>
+#include <usml/ocean/profile_linear.h>
 #include <usml/types/types.h>
 
 #include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <complex>
 #include <fstream>
 #include <iostream>
 
@@ -12,6 +16,8 @@ BOOST_AUTO_TEST_SUITE(eigenrays_test)
 
 using namespace boost::unit_test;
 using namespace usml::eigenrays;
+using namespace usml::netcdf;
+using namespace usml::ocean;
 
 /**
  * Factory that builds eigenrays and notify listeners.
@@ -53,6 +59,7 @@ class USML_DECLSPEC eigenray_factory : public eigenray_notifier {
 BOOST_AUTO_TEST_CASE(create_eigenray) {
     cout << "=== eigenrays_test: create_eigenray ===" << endl;
     const char* ncname = USML_TEST_DIR "/eigenrays/test/create_eigenray.nc";
+    const char* colname = USML_TEST_DIR "/eigenrays/test/create_eigenray.col";
 
     // create collection with references to wave front information
 
@@ -84,6 +91,238 @@ BOOST_AUTO_TEST_CASE(create_eigenray) {
     BOOST_CHECK_CLOSE(total.intensity(0), -9.54, 0.1);
 
     collection.write_netcdf(ncname);
+    collection.write_columnar(colname);
+    columnar_writer::instance()->flush();
+    BOOST_CHECK_EQUAL(columnar_writer::instance()->num_errors(), 0);
+}
+
+/**
+ * This test searches for eigenrays by target ID in a grid of targets.
+ * Checks that each target ID maps to its own row and column, that a target ID
+ * of zero maps to the first target, and that unknown targets produce
+ * an empty eigenray list.
+ */
+BOOST_AUTO_TEST_CASE(find_eigenray) {
+    cout << "=== eigenrays_test: find_eigenray ===" << endl;
+
+    seq_vector::csptr frequencies(new seq_linear(3000.0, 1.0, 1));
+    wposition1 source_pos(15.0, 35.0);
+    wposition targets(3, 2, 12.0, 37.0);
+    matrix<uint64_t> targetIDs(3, 2);
+    for (size_t t1 = 0; t1 < targets.size1(); ++t1) {
+        for (size_t t2 = 0; t2 < targets.size2(); ++t2) {
+            targetIDs(t1, t2) = 100 + 10 * t1 + t2;
+        }
+    }
+    eigenray_collection collection(frequencies, source_pos, targets, 1,
+                                   targetIDs);
+
+    // add a different number of eigenrays to each target
+
+    for (size_t t1 = 0; t1 < targets.size1(); ++t1) {
+        for (size_t t2 = 0; t2 < targets.size2(); ++t2) {
+            for (size_t n = 0; n <= t1 + t2; ++n) {
+                auto* ray = new eigenray_model();
+                ray->travel_time = 1.0 + double(n);
+                ray->frequencies = frequencies;
+                ray->intensity = vector<double>(frequencies->size(), 0.0);
+                ray->phase = vector<double>(frequencies->size(), 0.0);
+                collection.add_eigenray(t1, t2, eigenray_model::csptr(ray));
+            }
+        }
+    }
+
+    // search for each target by ID
+
+    for (size_t t1 = 0; t1 < targets.size1(); ++t1) {
+        for (size_t t2 = 0; t2 < targets.size2(); ++t2) {
+            size_t r = 99;
+            size_t c = 99;
+            BOOST_CHECK(collection.find_target(targetIDs(t1, t2), &r, &c));
+            BOOST_CHECK_EQUAL(r, t1);
+            BOOST_CHECK_EQUAL(c, t2);
+            BOOST_CHECK_EQUAL(
+                collection.find_eigenrays(targetIDs(t1, t2)).size(),
+                t1 + t2 + 1);
+            BOOST_CHECK_CLOSE(
+                collection.find_initial_time(targetIDs(t1, t2)), 1.0, 1e-10);
+        }
+    }
+    BOOST_CHECK_EQUAL(collection.find_eigenrays(0).size(), 1);
+    BOOST_CHECK_EQUAL(collection.find_eigenrays(999).size(), 0);
+    BOOST_CHECK_EQUAL(collection.find_initial_time(999), 0.0);
+}
+
+/**
+ * This test sums a pair of eigenrays for each target in a grid large enough
+ * to be summed in parallel. The weaker ray arrives later by an amount that
+ * is different for each target, so that mistakes in the assignment of
+ * targets to blocks produce errors in the coherent sum. The azimuths of the
+ * two rays straddle north, so that their weighted average tests the
+ * east/west and north/south components of the average.
+ */
+BOOST_AUTO_TEST_CASE(sum_eigenray_grid) {
+    cout << "=== eigenrays_test: sum_eigenray_grid ===" << endl;
+
+    seq_vector::csptr frequencies(new seq_linear(1000.0, 10.0, 5));
+    wposition1 source_pos(15.0, 35.0);
+    wposition targets(200, 100, 12.0, 37.0);
+    eigenray_collection collection(frequencies, source_pos, targets);
+    const double weak = 0.5;  // pressure amplitude of weaker ray
+
+    for (size_t t1 = 0; t1 < targets.size1(); ++t1) {
+        for (size_t t2 = 0; t2 < targets.size2(); ++t2) {
+            const double delay = 1e-5 * double(t1 * targets.size2() + t2);
+            for (int n = 0; n < 2; ++n) {
+                auto* ray = new eigenray_model();
+                ray->travel_time = 1.0 + n * delay;
+                ray->source_de = n ? 10.0 : -10.0;
+                ray->source_az = n ? 10.0 : 350.0;
+                ray->target_de = n ? -10.0 : 10.0;
+                ray->target_az = n ? 350.0 : 10.0;
+                ray->surface = n;
+                ray->bottom = n;
+                ray->caustic = n;
+                ray->frequencies = frequencies;
+                ray->intensity = vector<double>(
+                    frequencies->size(), n ? -20.0 * log10(weak) : 0.0);
+                ray->phase = vector<double>(frequencies->size(), 0.0);
+                collection.add_eigenray(t1, t2, eigenray_model::csptr(ray));
+            }
+        }
+    }
+    collection.sum_eigenrays();
+
+    // weighted averages are the same for every target
+
+    const double w = weak * weak;
+    const double x = sin(to_radians(350.0)) + w * sin(to_radians(10.0));
+    const double y = cos(to_radians(350.0)) + w * cos(to_radians(10.0));
+    const double source_az = 90.0 - to_degrees(atan2(y, x));
+    const double target_az = 90.0 - to_degrees(atan2(y, -x));
+
+    for (size_t t1 = 0; t1 < targets.size1(); ++t1) {
+        for (size_t t2 = 0; t2 < targets.size2(); ++t2) {
+            const double delay = 1e-5 * double(t1 * targets.size2() + t2);
+            const eigenray_model& total = collection.total(t1, t2);
+            for (size_t f = 0; f < frequencies->size(); ++f) {
+                const std::complex<double> phasor =
+                    1.0 + std::polar(weak, TWO_PI * (*frequencies)(f)*delay);
+                BOOST_CHECK_SMALL(
+                    total.intensity(f) + 20.0 * log10(abs(phasor)), 1e-8);
+            }
+            BOOST_CHECK_CLOSE(total.travel_time,
+                              (1.0 + w * (1.0 + delay)) / (1.0 + w), 1e-10);
+            BOOST_CHECK_CLOSE(total.source_de, -10.0 * (1 - w) / (1 + w),
+                              1e-10);
+            BOOST_CHECK_CLOSE(total.source_az, source_az, 1e-10);
+            BOOST_CHECK_CLOSE(total.target_az, target_az, 1e-10);
+            BOOST_CHECK_EQUAL(total.surface, 0);
+        }
+    }
+}
+
+/**
+ * This test dead reckons a grid of targets with the batch version of
+ * dead_reckon(), and compares the results to the single target version.
+ * Moves the source and each target by a different amount, and uses
+ * eigenrays with a range of launch angles, so that each eigenray
+ * has a different change in travel time and intensity.
+ */
+BOOST_AUTO_TEST_CASE(dead_reckon_grid) {
+    cout << "=== eigenrays_test: dead_reckon_grid ===" << endl;
+
+    seq_vector::csptr frequencies(new seq_linear(1000.0, 1000.0, 4));
+    profile_model::csptr profile(new profile_linear(1500.0));
+    wposition1 source_pos(15.0, 35.0, -100.0);
+    wposition1 source_new(15.001, 35.0, -110.0);
+    wposition targets(3, 4, 15.1, 35.1, -50.0);
+    wposition new_targets(3, 4, 15.1, 35.1, -50.0);
+    eigenray_collection collection(frequencies, source_pos, targets);
+
+    for (size_t t1 = 0; t1 < targets.size1(); ++t1) {
+        for (size_t t2 = 0; t2 < targets.size2(); ++t2) {
+            wposition1 target(targets, t1, t2);
+            new_targets.latitude(t1, t2, target.latitude() + 0.001 * t1);
+            new_targets.longitude(t1, t2, target.longitude() - 0.001 * t2);
+            for (size_t n = 0; n <= t1 + t2; ++n) {
+                auto* ray = new eigenray_model();
+                ray->travel_time = 10.0 + double(n);
+                ray->source_de = -30.0 + 10.0 * double(n);
+                ray->source_az = 45.0 * double(t2);
+                ray->target_de = -ray->source_de;
+                ray->target_az = ray->source_az;
+                ray->frequencies = frequencies;
+                ray->intensity =
+                    vector<double>(frequencies->size(), 60.0 + double(n));
+                ray->phase = vector<double>(frequencies->size(), 0.0);
+                collection.add_eigenray(t1, t2, eigenray_model::csptr(ray));
+            }
+        }
+    }
+
+    matrix<eigenray_list> batch =
+        collection.dead_reckon(source_new, new_targets, profile);
+    for (size_t t1 = 0; t1 < targets.size1(); ++t1) {
+        for (size_t t2 = 0; t2 < targets.size2(); ++t2) {
+            eigenray_list single = collection.dead_reckon(
+                t1, t2, source_new, wposition1(new_targets, t1, t2), profile);
+            BOOST_REQUIRE_EQUAL(batch(t1, t2).size(), single.size());
+            auto expected = single.begin();
+            double n = 0.0;
+            for (const auto& ray : batch(t1, t2)) {
+                BOOST_CHECK_CLOSE(ray->travel_time, (*expected)->travel_time,
+                                  1e-10);
+                BOOST_CHECK_NE(ray->travel_time, 10.0 + n);
+                n += 1.0;
+                for (size_t f = 0; f < frequencies->size(); ++f) {
+                    BOOST_CHECK_CLOSE(ray->intensity(f),
+                                      (*expected)->intensity(f), 1e-10);
+                }
+                BOOST_CHECK_EQUAL(ray->source_de, (*expected)->source_de);
+                ++expected;
+            }
+        }
+    }
+}
+
+/**
+ * This test reverses the sense of source and target for a list of
+ * eigenrays. Checks that the angles are swapped in the copies, that the
+ * original eigenrays are unchanged, and that the copies share a single pool.
+ */
+BOOST_AUTO_TEST_CASE(reciprocal_eigenray) {
+    cout << "=== eigenrays_test: reciprocal_eigenray ===" << endl;
+
+    seq_vector::csptr frequencies(new seq_linear(3000.0, 1.0, 2));
+    eigenray_list original;
+    for (size_t n = 0; n < 3; ++n) {
+        auto* ray = new eigenray_model();
+        ray->travel_time = 1.0 + double(n);
+        ray->source_de = -10.0 * double(n);
+        ray->source_az = 20.0 * double(n);
+        ray->target_de = 5.0 * double(n);
+        ray->target_az = 180.0 + double(n);
+        ray->frequencies = frequencies;
+        ray->intensity = vector<double>(frequencies->size(), 60.0);
+        ray->phase = vector<double>(frequencies->size(), 0.0);
+        original.push_back(eigenray_model::csptr(ray));
+    }
+
+    eigenray_list reversed = eigenray_collection::reciprocal(original);
+    BOOST_REQUIRE_EQUAL(reversed.size(), original.size());
+    auto ray = original.begin();
+    for (const auto& copy : reversed) {
+        BOOST_CHECK_EQUAL(copy->travel_time, (*ray)->travel_time);
+        BOOST_CHECK_EQUAL(copy->source_de, (*ray)->target_de);
+        BOOST_CHECK_EQUAL(copy->source_az, (*ray)->target_az);
+        BOOST_CHECK_EQUAL(copy->target_de, (*ray)->source_de);
+        BOOST_CHECK_EQUAL(copy->target_az, (*ray)->source_az);
+        BOOST_CHECK_EQUAL(copy->intensity(1), (*ray)->intensity(1));
+        BOOST_CHECK_EQUAL(copy.use_count(), (long)reversed.size());
+        ++ray;
+    }
+    BOOST_CHECK_EQUAL(original.back()->source_de, -20.0);
 }
 
 /// @}
@@ -6,6 +6,9 @@
 #include <ncvalues.h>
 #include <netcdfcpp.h>
 #include <usml/eigenverbs/eigenverb_collection.h>
+#include <usml/netcdf/columnar_file.h>
+#include <usml/netcdf/columnar_writer.h>
+#include <usml/netcdf/netcdf_utils.h>
 #include <usml/types/seq_data.h>
 #include <usml/types/seq_vector.h>
 #include <usml/types/wposition1.h>
@@ -18,14 +21,24 @@
 #include <boost/numeric/ublas/storage.hpp>
 #include <boost/numeric/ublas/vector.hpp>
 #include <boost/numeric/ublas/vector_expression.hpp>
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
 #include <iostream>
-#include <iterator>
-#include <list>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <utility>
+#include <vector>
 
 using namespace usml::eigenverbs;
+using namespace usml::netcdf;
 
 /**
  * Scale factor for size of search area in find_eigenverbs().
@@ -33,15 +46,192 @@ using namespace usml::eigenverbs;
 double eigenverb_collection::search_scale = 1.5;
 
 /**
- * Creates list of eigenverbs for a specific interface.
+ * Maximum difference in travel time for eigenverbs merged by merge().
  */
-eigenverb_list eigenverb_collection::eigenverbs(size_t interface) const {
-    read_lock_guard guard(_mutex);
-    eigenverb_list list;
-    for (const auto& pair : _collection[interface]) {
-        list.push_back(pair.second);
+double eigenverb_collection::merge_time = 0.01;
+
+/**
+ * Maximum difference in grazing angle and direction for eigenverbs merged
+ * by merge().
+ */
+double eigenverb_collection::merge_angle = to_radians(2.0);
+
+/**
+ * Identifier at the start of each eigenverb snapshot.
+ */
+const char eigenverb_collection::snapshot_magic[8] = "USMLVRB";
+
+namespace {
+
+/**
+ * Fixed size record for each eigenverb in a snapshot. Power and
+ * frequencies are stored in separate tables, because their size varies.
+ */
+struct snapshot_record {
+    double travel_time;  ///< Travel time (sec).
+    double length;       ///< Length of the eigenverb (meters).
+    double width;        ///< Width of the eigenverb (meters).
+    double latitude;     ///< Latitude of the center (degrees).
+    double longitude;    ///< Longitude of the center (degrees).
+    double altitude;     ///< Altitude of the center (meters).
+    double direction;    ///< Direction of the length axis (radians).
+    double grazing;      ///< Grazing angle (radians).
+    double sound_speed;  ///< Sound speed at the interface (m/s).
+    double source_de;    ///< Launch D/E angle (radians).
+    double source_az;    ///< Launch AZ angle (radians).
+    int32_t de_index;    ///< Index of the launch D/E angle.
+    int32_t az_index;    ///< Index of the launch AZ angle.
+    int32_t surface;     ///< Number of surface reflections.
+    int32_t bottom;      ///< Number of bottom reflections.
+    int32_t caustic;     ///< Number of caustics.
+    int32_t upper;       ///< Number of upper vertices.
+    int32_t lower;       ///< Number of lower vertices.
+    int32_t reserved;    ///< Pads the record to an 8 byte boundary.
+};
+static_assert(sizeof(snapshot_record) == 120,
+              "eigenverb snapshot record must not be padded");
+
+/**
+ * Power weighted moments of a group of Gaussian eigenverbs. Positions are
+ * offsets north and east of the first eigenverb, in a plane tangent to
+ * the interface at that point. Each eigenverb contributes its own covariance,
+ * with length along its direction and width across it, plus the spread
+ * of its center from the weighted mean. The direction of the merged
+ * Gaussian is the weighted mean of the member directions, because it
+ * defines the D/E axis used for scattering and overlap calculations.
+ */
+struct gaussian_moments {
+    double weight{0.0};    ///< Sum of weights.
+    double north{0.0};     ///< Weighted sum of offsets to north.
+    double east{0.0};      ///< Weighted sum of offsets to east.
+    double nn{0.0};        ///< Weighted sum of second moment north-north.
+    double ne{0.0};        ///< Weighted sum of second moment north-east.
+    double ee{0.0};        ///< Weighted sum of second moment east-east.
+    double cos_dir{0.0};   ///< Weighted sum of cosine of direction.
+    double sin_dir{0.0};   ///< Weighted sum of sine of direction.
+    double area{0.0};      ///< Weighted sum of length times width.
+    double time{0.0};      ///< Weighted sum of travel time.
+    double grazing{0.0};   ///< Weighted sum of grazing angle.
+    double speed{0.0};     ///< Weighted sum of sound speed.
+
+    /**
+     * Add an eigenverb to these moments.
+     *
+     * @param origin    Eigenverb at the origin of the tangent plane.
+     * @param verb      Eigenverb to add.
+     * @param w         Weight of this eigenverb.
+     */
+    void add(const eigenverb_model& origin, const eigenverb_model& verb,
+             double w) {
+        const double radius = wposition::earth_radius + origin.position.altitude();
+        const double lat = to_radians(origin.position.latitude());
+        const double dn =
+            radius * to_radians(verb.position.latitude() -
+                                origin.position.latitude());
+        const double de =
+            radius * cos(lat) *
+            to_radians(remainder(verb.position.longitude() -
+                                     origin.position.longitude(),
+                                 360.0));
+        const double c = cos(verb.direction);
+        const double s = sin(verb.direction);
+        const double L2 = verb.length * verb.length;
+        const double W2 = verb.width * verb.width;
+        weight += w;
+        north += w * dn;
+        east += w * de;
+        nn += w * (L2 * c * c + W2 * s * s + dn * dn);
+        ee += w * (L2 * s * s + W2 * c * c + de * de);
+        ne += w * ((L2 - W2) * c * s + dn * de);
+        cos_dir += w * c;
+        sin_dir += w * s;
+        area += w * verb.length * verb.width;
+        time += w * verb.travel_time;
+        grazing += w * verb.grazing;
+        speed += w * verb.sound_speed;
     }
-    return list;
+
+    /**
+     * Compute the length, width, and direction of the merged Gaussian.
+     * The direction is the weighted mean direction of its members. The
+     * length and width are the standard deviations of the covariance
+     * along and across that direction.
+     *
+     * @param length    Length of the merged Gaussian (output).
+     * @param width     Width of the merged Gaussian (output).
+     * @param direction Direction of the merged Gaussian (output).
+     */
+    void axes(double* length, double* width, double* direction) const {
+        const double mn = north / weight;
+        const double me = east / weight;
+        const double cnn = nn / weight - mn * mn;
+        const double cee = ee / weight - me * me;
+        const double cne = ne / weight - mn * me;
+        *direction = atan2(sin_dir, cos_dir);
+        const double c = cos(*direction);
+        const double s = sin(*direction);
+        *length = sqrt(std::max(c * c * cnn + 2.0 * c * s * cne + s * s * cee,
+                                0.0));
+        *width = sqrt(std::max(s * s * cnn - 2.0 * c * s * cne + c * c * cee,
+                               0.0));
+    }
+
+    /**
+     * Ratio of the area of the merged Gaussian to the weighted average area
+     * of its components. The peak intensity of the merged Gaussian is
+     * reduced by this factor.
+     */
+    double growth() const {
+        double length, width, direction;
+        axes(&length, &width, &direction);
+        return length * width / (area / weight);
+    }
+
+    /**
+     * Build a new eigenverb from these moments.
+     *
+     * @param origin    Eigenverb at the origin of the tangent plane. Source
+     *                  angles, indices, and path counts are copied from
+     *                  this eigenverb.
+     * @param list      List of eigenverbs for this interface.
+     * @param members   Index of the eigenverbs that were merged. Their
+     *                  power is summed, because the weights only shape
+     *                  the moments.
+     * @return          Merged eigenverb.
+     */
+    eigenverb_model::csptr build(const eigenverb_model& origin,
+                                 const eigenverb_list& list,
+                                 const std::vector<size_t>& members) const {
+        auto* verb = new eigenverb_model(origin);
+        verb->power = zero_vector<double>(origin.power.size());
+        for (size_t n : members) {
+            verb->power += list[n]->power;
+        }
+        axes(&verb->length, &verb->width, &verb->direction);
+        verb->travel_time = time / weight;
+        verb->grazing = grazing / weight;
+        verb->sound_speed = speed / weight;
+
+        const double radius = wposition::earth_radius + origin.position.altitude();
+        const double lat = to_radians(origin.position.latitude());
+        verb->position.latitude(origin.position.latitude() +
+                                to_degrees(north / weight / radius));
+        verb->position.longitude(
+            origin.position.longitude() +
+            to_degrees(east / weight / (radius * cos(lat))));
+        return eigenverb_model::csptr(verb);
+    }
+};
+
+}  // namespace
+
+/**
+ * Read-only view of the eigenverbs for a specific interface.
+ */
+eigenverb_span eigenverb_collection::eigenverbs(size_t interface) const {
+    read_lock_guard guard(_mutex);
+    return eigenverb_span(_collection[interface].begin(),
+                          _collection[interface].end());
 }
 
 /**
@@ -50,9 +240,35 @@ eigenverb_list eigenverb_collection::eigenverbs(size_t interface) const {
 void eigenverb_collection::add_eigenverb(eigenverb_model::csptr verb,
                                          size_t interface) {
     write_lock_guard guard(_mutex);
-    eigenverb_collection::point center(verb->position.latitude(),
-                                       verb->position.longitude());
-    _collection[interface].insert(eigenverb_collection::pair(center, verb));
+    _collection[interface].push_back(std::move(verb));
+}
+
+/**
+ * Bulk load the spatial index for all interfaces with new eigenverbs.
+ */
+void eigenverb_collection::index() const {
+    write_lock_guard guard(_mutex);
+    for (size_t interface = 0; interface < _collection.size(); ++interface) {
+        index(interface);
+    }
+}
+
+/**
+ * Bulk load the spatial index for an interface.
+ */
+void eigenverb_collection::index(size_t interface) const {
+    const eigenverb_list& list = _collection[interface];
+    if (_index[interface].size() == list.size()) {
+        return;
+    }
+    std::vector<pair> values;
+    values.reserve(list.size());
+    for (size_t n = 0; n < list.size(); ++n) {
+        values.emplace_back(point(list[n]->position.latitude(),
+                                  list[n]->position.longitude()),
+                            n);
+    }
+    _index[interface] = rtree(values.begin(), values.end());
 }
 
 /**
@@ -60,37 +276,144 @@ void eigenverb_collection::add_eigenverb(eigenverb_model::csptr verb,
  */
 eigenverb_list eigenverb_collection::find_eigenverbs(
     const eigenverb_model::csptr& bounding_verb, size_t interface) const {
+    {
+        read_lock_guard guard(_mutex);
+        if (_index[interface].size() != _collection[interface].size()) {
+            guard.unlock();
+            write_lock_guard write_guard(_mutex);
+            index(interface);
+        }
+    }
     read_lock_guard guard(_mutex);
 
-    // compute size of search area
+    // find eigenverbs whose position is within the search area
 
-    auto& pos = bounding_verb->position;
-    auto direction = bounding_verb->direction;
-    wposition1 posA(pos, search_scale * bounding_verb->length, direction);
-    wposition1 posB(pos, search_scale * bounding_verb->width,
-                    direction + M_PI_2);
-    wposition1 posC(pos, search_scale * bounding_verb->length,
-                    direction + M_PI);
-    wposition1 posD(pos, search_scale * bounding_verb->width,
-                    direction + M_PI + M_PI_2);
-    bgm::polygon<point> search_area{{{posA.latitude(), posA.longitude()},
-                                     {posB.latitude(), posB.longitude()},
-                                     {posC.latitude(), posC.longitude()},
-                                     {posD.latitude(), posD.longitude()}}};
+    const eigenverb_list& verbs = _collection[interface];
+    eigenverb_list list;
+    for (auto iter = _index[interface].qbegin(
+             bgi::within(search_area(*bounding_verb)));
+         iter != _index[interface].qend(); ++iter) {
+        list.push_back(verbs[iter->second]);
+    }
+    return list;
+}
 
-    // find eigenverbs whose position is within this box
+/**
+ * True if an eigenverb is inside the search area of a bounding eigenverb.
+ */
+bool eigenverb_collection::in_search_area(const eigenverb_model& bounding_verb,
+                                          const eigenverb_model& verb) {
+    const point position(verb.position.latitude(), verb.position.longitude());
+    return bg::within(position, search_area(bounding_verb));
+}
 
-    std::list<eigenverb_collection::pair> pair_list;
-    _collection[interface].query(bgi::within(search_area),
-                                 std::back_inserter(pair_list));
+/**
+ * Merges co-located eigenverbs into equivalent larger Gaussians.
+ */
+size_t eigenverb_collection::merge(double tolerance) {
+    write_lock_guard guard(_mutex);
+    const double max_growth = pow(10.0, tolerance / 10.0);
+    size_t removed = 0;
+    for (size_t interface = 0; interface < _collection.size(); ++interface) {
+        index(interface);
+        const eigenverb_list& list = _collection[interface];
+        const size_t num_verbs = list.size();
+
+        // use strongest eigenverbs as the seeds for each merge
+
+        std::vector<double> weight(num_verbs);
+        std::vector<size_t> order(num_verbs);
+        for (size_t n = 0; n < num_verbs; ++n) {
+            weight[n] = std::max(sum(list[n]->power),
+                                 std::numeric_limits<double>::min());
+            order[n] = n;
+        }
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return weight[a] > weight[b];
+        });
+
+        // merge compatible neighbors of each seed, until the merged
+        // Gaussian grows more than the tolerance allows
+
+        std::vector<bool> used(num_verbs, false);
+        eigenverb_list result;
+        result.reserve(num_verbs);
+        for (size_t seed : order) {
+            if (used[seed]) {
+                continue;
+            }
+            used[seed] = true;
+            const eigenverb_model& verb = *list[seed];
+            gaussian_moments moments;
+            moments.add(verb, verb, weight[seed]);
+            std::vector<size_t> members(1, seed);
+            for (auto iter = _index[interface].qbegin(
+                     bgi::within(search_area(verb)));
+                 iter != _index[interface].qend(); ++iter) {
+                const size_t n = iter->second;
+                if (used[n] || !compatible(verb, *list[n])) {
+                    continue;
+                }
+                gaussian_moments trial = moments;
+                trial.add(verb, *list[n], weight[n]);
+                if (trial.growth() > max_growth) {
+                    continue;
+                }
+                moments = trial;
+                used[n] = true;
+                members.push_back(n);
+            }
+            if (members.size() == 1) {
+                result.push_back(list[seed]);
+            } else {
+                result.push_back(moments.build(verb, list, members));
+            }
+        }
 
-    // translate to output structure
+        // replace eigenverbs with merged list, index rebuilt on next search
 
-    eigenverb_list list;
-    for (const auto& pair : pair_list) {
-        list.push_back(pair.second);
+        removed += num_verbs - result.size();
+        _collection[interface] = std::move(result);
+        _index[interface].clear();
     }
-    return list;
+    return removed;
+}
+
+/**
+ * Polygon that surrounds the search area for an eigenverb.
+ */
+bgm::polygon<eigenverb_collection::point> eigenverb_collection::search_area(
+    const eigenverb_model& verb) {
+    const auto& pos = verb.position;
+    const double direction = verb.direction;
+    wposition1 posA(pos, search_scale * verb.length, direction);
+    wposition1 posB(pos, search_scale * verb.width, direction + M_PI_2);
+    wposition1 posC(pos, search_scale * verb.length, direction + M_PI);
+    wposition1 posD(pos, search_scale * verb.width,
+                    direction + M_PI + M_PI_2);
+    bgm::polygon<point> area{{{posA.latitude(), posA.longitude()},
+                              {posB.latitude(), posB.longitude()},
+                              {posC.latitude(), posC.longitude()},
+                              {posD.latitude(), posD.longitude()}}};
+
+    // corners are counter-clockwise in (latitude, longitude) coordinates,
+    // but boost geometry expects clockwise polygons, and accepted points up
+    // to twice the search radius before the winding was corrected
+
+    bg::correct(area);
+    return area;
+}
+
+/**
+ * True if two eigenverbs are similar enough to be merged.
+ */
+bool eigenverb_collection::compatible(const eigenverb_model& verb,
+                                      const eigenverb_model& other) {
+    return other.power.size() == verb.power.size() &&
+           std::abs(other.travel_time - verb.travel_time) <= merge_time &&
+           std::abs(other.grazing - verb.grazing) <= merge_angle &&
+           std::abs(remainder(other.direction - verb.direction, 2.0 * M_PI)) <=
+               merge_angle;
 }
 
 /**
@@ -98,34 +421,14 @@ eigenverb_list eigenverb_collection::find_eigenverbs(
  */
 void eigenverb_collection::write_netcdf(const char* filename,
                                         size_t interface) const {
+    eigenverb_span list = eigenverbs(interface);
+    std::lock_guard<std::mutex> lock(netcdf_utils::mutex());
     NcFile nc_file(filename, NcFile::Replace);
-    eigenverb_list list = eigenverbs(interface);
 
-    switch (interface) {
-        case eigenverb_model::BOTTOM:
-            nc_file.add_att("long_name", "bottom eigenverbs");
-            break;
-        case eigenverb_model::SURFACE:
-            nc_file.add_att("long_name", "surface eigenverbs");
-            break;
-        case eigenverb_model::VOLUME_UPPER:
-            nc_file.add_att("long_name", "upper volume eigenverbs");
-            nc_file.add_att("layer", 1);
-            break;
-        case eigenverb_model::VOLUME_LOWER:
-            nc_file.add_att("long_name", "lower volume eigenverbs");
-            nc_file.add_att("layer", 1);
-            break;
-        default: {
-            size_t layer = interface - eigenverb_model::VOLUME_UPPER;
-            size_t side = layer % 2;
-            layer = (layer / 2) + 1;
-            std::ostringstream oss;
-            oss << ((side) != 0U ? "lower" : "upper") << " volume " << layer
-                << " eigenverbs";
-            nc_file.add_att("long_name", oss.str().c_str());
-            nc_file.add_att("layer", (long)layer);
-        } break;
+    size_t layer = 0;
+    nc_file.add_att("long_name", interface_name(interface, &layer).c_str());
+    if (layer > 0) {
+        nc_file.add_att("layer", (long)layer);
     }
 
     if (!list.empty()) {
@@ -256,12 +559,309 @@ void eigenverb_collection::write_netcdf(const char* filename,
     }
 }
 
+/**
+ * Writes the eigenverbs for all interfaces to a binary snapshot.
+ */
+void eigenverb_collection::write_snapshot(const char* filename) const {
+    read_lock_guard guard(_mutex);
+    std::ofstream stream(filename, std::ios::binary | std::ios::trunc);
+    if (!stream) {
+        throw std::invalid_argument("unable to create file");
+    }
+    const uint32_t header[2] = {snapshot_byte_order, snapshot_version};
+    const uint64_t num_interfaces = _collection.size();
+    stream.write(snapshot_magic, sizeof(snapshot_magic));
+    stream.write((const char*)header, sizeof(header));
+    stream.write((const char*)&num_interfaces, sizeof(num_interfaces));
+    for (const auto& list : _collection) {
+        const uint64_t num[2] = {
+            list.size(), list.empty() ? 0 : list.front()->frequencies->size()};
+        stream.write((const char*)num, sizeof(num));
+        if (list.empty()) {
+            continue;
+        }
+        stream.write((const char*)list.front()->frequencies->data().begin(),
+                     (std::streamsize)(sizeof(double) * num[1]));
+
+        std::vector<snapshot_record> records(list.size());
+        std::vector<double> power(num[0] * num[1]);
+        for (size_t n = 0; n < list.size(); ++n) {
+            const eigenverb_model& verb = *list[n];
+            snapshot_record& record = records[n];
+            record.travel_time = verb.travel_time;
+            record.length = verb.length;
+            record.width = verb.width;
+            record.latitude = verb.position.latitude();
+            record.longitude = verb.position.longitude();
+            record.altitude = verb.position.altitude();
+            record.direction = verb.direction;
+            record.grazing = verb.grazing;
+            record.sound_speed = verb.sound_speed;
+            record.source_de = verb.source_de;
+            record.source_az = verb.source_az;
+            record.de_index = (int32_t)verb.de_index;
+            record.az_index = (int32_t)verb.az_index;
+            record.surface = verb.surface;
+            record.bottom = verb.bottom;
+            record.caustic = verb.caustic;
+            record.upper = verb.upper;
+            record.lower = verb.lower;
+            record.reserved = 0;
+            std::copy(verb.power.begin(), verb.power.end(),
+                      power.begin() + (std::ptrdiff_t)(n * num[1]));
+        }
+        stream.write((const char*)records.data(),
+                     (std::streamsize)(sizeof(snapshot_record) * num[0]));
+        stream.write((const char*)power.data(),
+                     (std::streamsize)(sizeof(double) * power.size()));
+    }
+    if (!stream) {
+        throw std::invalid_argument("unable to write file");
+    }
+}
+
+/**
+ * Replaces all of the eigenverbs in this collection with those from a
+ * binary snapshot.
+ */
+void eigenverb_collection::read_snapshot(const char* filename) {
+    std::ifstream stream(filename, std::ios::binary | std::ios::ate);
+    if (!stream) {
+        throw std::invalid_argument("file not found");
+    }
+    const auto file_size = (uint64_t)stream.tellg();
+    stream.seekg(0);
+
+    // validate header
+
+    char magic[sizeof(snapshot_magic)];
+    uint32_t header[2];
+    uint64_t num_interfaces;
+    if (!stream.read(magic, sizeof(magic)) ||
+        std::memcmp(magic, snapshot_magic, sizeof(magic)) != 0 ||
+        !stream.read((char*)header, sizeof(header)) ||
+        !stream.read((char*)&num_interfaces, sizeof(num_interfaces))) {
+        throw std::invalid_argument("unrecognized file type");
+    }
+    if (header[0] != snapshot_byte_order) {
+        throw std::invalid_argument("snapshot has a different byte order");
+    }
+    if (header[1] != snapshot_version) {
+        throw std::invalid_argument("unsupported snapshot version");
+    }
+    if (num_interfaces < 2 || num_interfaces % 2 != 0) {
+        throw std::invalid_argument("unrecognized file type");
+    }
+
+    // read eigenverbs for each interface into a single allocation
+
+    std::vector<eigenverb_list> collection(num_interfaces);
+    std::vector<double> freq;
+    std::vector<snapshot_record> records;
+    std::vector<double> power;
+    for (auto& list : collection) {
+        uint64_t num[2];
+        if (!stream.read((char*)num, sizeof(num))) {
+            throw std::invalid_argument("unrecognized file type");
+        }
+        if (num[0] == 0) {
+            continue;
+        }
+        if (num[1] < 1 || num[0] > file_size / sizeof(snapshot_record) ||
+            num[1] > file_size / sizeof(double)) {
+            throw std::invalid_argument("unrecognized file type");
+        }
+        freq.resize(num[1]);
+        records.resize(num[0]);
+        power.resize(num[0] * num[1]);
+        if (!stream.read((char*)freq.data(),
+                         (std::streamsize)(sizeof(double) * freq.size())) ||
+            !stream.read((char*)records.data(),
+                         (std::streamsize)(sizeof(snapshot_record) *
+                                           records.size())) ||
+            !stream.read((char*)power.data(),
+                         (std::streamsize)(sizeof(double) * power.size()))) {
+            throw std::invalid_argument("unrecognized file type");
+        }
+
+        seq_vector::csptr frequencies =
+            seq_vector::build_best(freq.data(), num[1]);
+        auto pool = std::make_shared<std::vector<eigenverb_model>>(num[0]);
+        list.reserve(num[0]);
+        for (size_t n = 0; n < num[0]; ++n) {
+            const snapshot_record& record = records[n];
+            eigenverb_model& verb = (*pool)[n];
+            verb.travel_time = record.travel_time;
+            verb.frequencies = frequencies;
+            verb.power.resize(num[1], false);
+            std::copy(power.begin() + (std::ptrdiff_t)(n * num[1]),
+                      power.begin() + (std::ptrdiff_t)((n + 1) * num[1]),
+                      verb.power.begin());
+            verb.length = record.length;
+            verb.width = record.width;
+            verb.position.latitude(record.latitude);
+            verb.position.longitude(record.longitude);
+            verb.position.altitude(record.altitude);
+            verb.direction = record.direction;
+            verb.grazing = record.grazing;
+            verb.sound_speed = record.sound_speed;
+            verb.de_index = (size_t)record.de_index;
+            verb.az_index = (size_t)record.az_index;
+            verb.source_de = record.source_de;
+            verb.source_az = record.source_az;
+            verb.surface = record.surface;
+            verb.bottom = record.bottom;
+            verb.caustic = record.caustic;
+            verb.upper = record.upper;
+            verb.lower = record.lower;
+            list.push_back(eigenverb_model::csptr(pool, &verb));
+        }
+    }
+    if (stream.peek() != std::char_traits<char>::eof()) {
+        throw std::invalid_argument("unrecognized file type");
+    }
+
+    // replace contents of collection and build spatial index
+
+    write_lock_guard guard(_mutex);
+    _collection = std::move(collection);
+    _index = std::vector<rtree>(num_interfaces);
+    for (size_t interface = 0; interface < num_interfaces; ++interface) {
+        index(interface);
+    }
+}
+
+/**
+ * Writes the eigenverbs for an individual interface to a columnar file.
+ */
+void eigenverb_collection::write_columnar(const char* filename,
+                                          size_t interface) const {
+    columnar_file file;
+    eigenverb_span list = eigenverbs(interface);
+    size_t layer = 0;
+    file.attribute("long_name", interface_name(interface, &layer));
+    if (layer > 0) {
+        file.attribute("layer", std::to_string(layer));
+    }
+
+    if (!list.empty()) {
+        const auto& frequencies = *list.begin()->get()->frequencies;
+        const size_t num_verbs = list.size();
+        const size_t num_freqs = frequencies.size();
+        std::vector<double> travel_time;
+        std::vector<double> power;
+        std::vector<double> length;
+        std::vector<double> width;
+        std::vector<double> latitude;
+        std::vector<double> longitude;
+        std::vector<double> altitude;
+        std::vector<double> direction;
+        std::vector<double> grazing;
+        std::vector<double> sound_speed;
+        std::vector<int16_t> de_index;
+        std::vector<int16_t> az_index;
+        std::vector<double> source_de;
+        std::vector<double> source_az;
+        std::vector<int16_t> surface;
+        std::vector<int16_t> bottom;
+        std::vector<int16_t> caustic;
+        std::vector<int16_t> upper;
+        std::vector<int16_t> lower;
+        power.reserve(num_verbs * num_freqs);
+        for (const auto& verb : list) {
+            travel_time.push_back(verb->travel_time);
+            for (size_t f = 0; f < num_freqs; ++f) {
+                const double p = std::max(verb->power[f], 1e-30);
+                power.push_back(10.0 * std::log10(p));
+            }
+            length.push_back(verb->length);
+            width.push_back(verb->width);
+            latitude.push_back(verb->position.latitude());
+            longitude.push_back(verb->position.longitude());
+            altitude.push_back(verb->position.altitude());
+            direction.push_back(to_degrees(verb->direction));
+            grazing.push_back(to_degrees(verb->grazing));
+            sound_speed.push_back(verb->sound_speed);
+            de_index.push_back((int16_t)verb->de_index);
+            az_index.push_back((int16_t)verb->az_index);
+            source_de.push_back(to_degrees(verb->source_de));
+            source_az.push_back(to_degrees(verb->source_az));
+            surface.push_back((int16_t)verb->surface);
+            bottom.push_back((int16_t)verb->bottom);
+            caustic.push_back((int16_t)verb->caustic);
+            upper.push_back((int16_t)verb->upper);
+            lower.push_back((int16_t)verb->lower);
+        }
+        file.add("travel_time", "seconds", travel_time);
+        file.add("frequencies", "hertz", {num_freqs},
+                 frequencies.data().begin());
+        file.add("power", "dB", {num_verbs, num_freqs}, power.data());
+        file.add("length", "meters", length);
+        file.add("width", "meters", width);
+        file.add("latitude", "degrees_north", latitude);
+        file.add("longitude", "degrees_east", longitude);
+        file.add("altitude", "meters", altitude);
+        file.add("direction", "degrees_true", direction);
+        file.add("grazing", "degrees", grazing);
+        file.add("sound_speed", "m/s", sound_speed);
+        file.add("de_index", "count", de_index);
+        file.add("az_index", "count", az_index);
+        file.add("source_de", "degrees", source_de);
+        file.add("source_az", "degrees_true", source_az);
+        file.add("surface", "count", surface);
+        file.add("bottom", "count", bottom);
+        file.add("caustic", "count", caustic);
+        file.add("upper", "count", upper);
+        file.add("lower", "count", lower);
+    }
+    columnar_writer::instance()->write(filename, std::move(file));
+}
+
+/**
+ * Descriptive name for an interface.
+ */
+std::string eigenverb_collection::interface_name(size_t interface,
+                                                 size_t* layer) {
+    size_t volume = 0;
+    std::string name;
+    switch (interface) {
+        case eigenverb_model::BOTTOM:
+            name = "bottom eigenverbs";
+            break;
+        case eigenverb_model::SURFACE:
+            name = "surface eigenverbs";
+            break;
+        case eigenverb_model::VOLUME_UPPER:
+            name = "upper volume eigenverbs";
+            volume = 1;
+            break;
+        case eigenverb_model::VOLUME_LOWER:
+            name = "lower volume eigenverbs";
+            volume = 1;
+            break;
+        default: {
+            volume = interface - eigenverb_model::VOLUME_UPPER;
+            size_t side = volume % 2;
+            volume = (volume / 2) + 1;
+            std::ostringstream oss;
+            oss << ((side) != 0U ? "lower" : "upper") << " volume " << volume
+                << " eigenverbs";
+            name = oss.str();
+        } break;
+    }
+    if (layer != nullptr) {
+        *layer = volume;
+    }
+    return name;
+}
+
 /**
  * Reads the eigenverbs for a single interface from a netcdf file.
  */
 void eigenverb_collection::read_netcdf(const char* filename, size_t interface) {
     // open file
 
+    std::lock_guard<std::mutex> lock(netcdf_utils::mutex());
     NcFile nc_file(filename, NcFile::ReadOnly);
     if (nc_file.is_valid() == 0U) {
         cout << "Could not open " << filename << endl;
@@ -11,11 +11,14 @@
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#include <boost/geometry/geometries/polygon.hpp>
 #include <boost/geometry/geometry.hpp>
 #pragma GCC diagnostic pop
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -45,6 +48,15 @@ namespace bgm = boost::geometry::model;
  *
  * In addition to structures for storing eigenverbs, it also includes the
  * algorithms for eigenverb searches and writing eigenverbs to disk.
+ *
+ * Eigenverbs are appended to a list for each interface as they are created,
+ * without updating the spatial index. The index for an interface is built
+ * all at once, using the packing algorithm of the rtree constructor, the
+ * first time that it is searched after new eigenverbs are added. Bulk
+ * loading is much faster than inserting the eigenverbs one at a time, and
+ * produces a tree with less overlap between nodes, which speeds up the
+ * searches. The wavefront_generator calls index() when propagation is
+ * complete, so that the index is ready before the collection is shared.
  */
 class USML_DECLSPEC eigenverb_collection : public eigenverb_listener {
    public:
@@ -57,6 +69,18 @@ class USML_DECLSPEC eigenverb_collection : public eigenverb_listener {
      */
     static double search_scale;
 
+    /**
+     * Maximum difference in travel time between eigenverbs that can be
+     * merged by merge() (sec). Defaults to 0.01 seconds.
+     */
+    static double merge_time;
+
+    /**
+     * Maximum difference in grazing angle and direction between eigenverbs
+     * that can be merged by merge() (radians). Defaults to 2 degrees.
+     */
+    static double merge_angle;
+
     /**
      * Construct a collection for a series of interfaces. Creates a minimum
      * of interfaces (index 0=bottom, 1=surface), plus two for each
@@ -65,7 +89,7 @@ class USML_DECLSPEC eigenverb_collection : public eigenverb_listener {
      * @param num_volumes    Number of volume scattering layers in the ocean.
      */
     eigenverb_collection(size_t num_volumes = 0)
-        : _collection((1 + num_volumes) * 2) {}
+        : _collection((1 + num_volumes) * 2), _index((1 + num_volumes) * 2) {}
 
     /**
      * Number of interfaces in this collection.
@@ -78,24 +102,42 @@ class USML_DECLSPEC eigenverb_collection : public eigenverb_listener {
      * @param interface Interface number of the desired list of eigenverbs.
      */
     size_t size(size_t interface) const {
+        read_lock_guard guard(_mutex);
         return _collection[interface].size();
     }
 
     /**
-     * Creates list of eigenverbs for a specific interface.
+     * Read-only view of the eigenverbs for a specific interface, in the
+     * order that they were added. The view refers to storage inside this
+     * collection, and is only valid while the collection is unchanged:
+     *
+     * - add_eigenverb() and read_netcdf() for this interface may
+     *   reallocate that storage.
+     * - merge() and read_snapshot() replace it.
+     * - Destroying the collection releases it.
+     *
+     * Use the view once the collection is complete, like after the
+     * wavefront_generator has finished, or copy it into an eigenverb_list
+     * if the collection may still change on another thread.
      *
      * @param interface Interface number of the desired list of eigenverbs.
      */
-    eigenverb_list eigenverbs(size_t interface) const;
+    eigenverb_span eigenverbs(size_t interface) const;
 
     /**
-     * Adds a new eigenverb to this collection.
+     * Adds a new eigenverb to this collection. The spatial index is not
+     * updated until the next search, or the next call to index().
      *
      * @param verb      Eigenverb reference to add to the eigenverb_collection.
      * @param interface Interface number for this addition.
      */
     void add_eigenverb(eigenverb_model::csptr verb, size_t interface);
 
+    /**
+     * Bulk load the spatial index for all interfaces with new eigenverbs.
+     */
+    void index() const;
+
     /**
      * Finds all of the eigenverbs near another eigenverb. Computes a ploygonal
      * search area that is roughly 3 times as big as the major and minor axes
@@ -110,6 +152,44 @@ class USML_DECLSPEC eigenverb_collection : public eigenverb_listener {
     eigenverb_list find_eigenverbs(const eigenverb_model::csptr& bounding_verb,
                                    size_t interface) const;
 
+    /**
+     * True if the position of an eigenverb is inside the area that
+     * find_eigenverbs() searches for a bounding eigenverb. Tells whether
+     * a search in the opposite direction would find a pair of eigenverbs,
+     * without running that search.
+     *
+     * @param bounding_verb     Eigenverb that defines the search area.
+     * @param verb              Eigenverb whose position is tested.
+     */
+    static bool in_search_area(const eigenverb_model& bounding_verb,
+                               const eigenverb_model& verb);
+
+    /**
+     * Merges co-located eigenverbs into equivalent larger Gaussians. Dense
+     * ray fans produce many eigenverbs that overlap each other, and the
+     * cost of the biverb_generator grows with the product of the number of
+     * source and receiver eigenverbs.
+     *
+     * Starting with the strongest eigenverb, this searches the same area as
+     * find_eigenverbs() for neighbors whose travel time, grazing angle, and
+     * direction are within merge_time and merge_angle of the first. Each
+     * neighbor is added to the group if the power weighted covariance of
+     * the group, including the spread of the eigenverb centers, produces a
+     * Gaussian whose area is no more than the tolerance larger than the
+     * average area of its members. The merged eigenverb has the total power
+     * of the group, and the weighted mean position, travel time, grazing
+     * angle, sound speed, and direction of the group. Its length and width
+     * are the spread of the group's covariance along and across that
+     * direction. Source angles, indices, and path counts are copied from
+     * the strongest member.
+     *
+     * @param tolerance     Maximum reduction in peak intensity of a merged
+     *                      eigenverb, caused by spreading its power over a
+     *                      larger area (dB).
+     * @return              Number of eigenverbs removed by merging.
+     */
+    size_t merge(double tolerance);
+
     /**
      * Writes the eigenverbs for an individual interface to a netcdf file. There
      * are separate variables for each eigenverb component, and each eigenverb
@@ -206,6 +286,29 @@ class USML_DECLSPEC eigenverb_collection : public eigenverb_listener {
      */
     void write_netcdf(const char* filename, size_t interface) const;
 
+    /**
+     * Writes the eigenverbs for an individual interface to a columnar file,
+     * using the same variable names and units as write_netcdf(). Copies the
+     * data into a columnar_file, then returns while the file is written by
+     * the columnar_writer on a background I/O thread.
+     *
+     * @param filename      Filename used to store this data.
+     * @param interface     Interface number for this list of eigenverbs.
+     */
+    void write_columnar(const char* filename, size_t interface) const;
+
+    /**
+     * Descriptive name for an interface, like "bottom eigenverbs". Used as
+     * the long_name attribute of the files for each interface.
+     *
+     * @param interface     Interface number for this list of eigenverbs.
+     * @param layer         Volume layer number, or zero for the surface and
+     *                      bottom interfaces (output).
+     * @return              Descriptive name for this interface.
+     */
+    static std::string interface_name(size_t interface,
+                                      size_t* layer = nullptr);
+
     /**
      * Reads the eigenverbs for a single interface from a NetCDF file.
      *
@@ -214,13 +317,66 @@ class USML_DECLSPEC eigenverb_collection : public eigenverb_listener {
      */
     void read_netcdf(const char* filename, size_t interface);
 
+    /**
+     * Writes the eigenverbs for all interfaces to a binary snapshot, so that
+     * reverberation can be computed for new receivers or pings without
+     * re-propagating the wavefront. The file layout is:
+     *
+     * - 8 byte identifier "USMLVRB" followed by a null.
+     * - byte order mark 0x01020304 as a 32 bit unsigned integer.
+     * - version of the format as a 32 bit unsigned integer.
+     * - number of interfaces as a 64 bit unsigned integer.
+     * - for each interface:
+     *   - number of eigenverbs and frequencies as 64 bit unsigned integers.
+     *   - frequencies (hertz) as 64 bit floating point numbers.
+     *   - fixed size record for each eigenverb, with the travel_time, length,
+     *     width, latitude, longitude, altitude, direction, grazing,
+     *     sound_speed, source_de, and source_az as 64 bit floating point
+     *     numbers, followed by the de_index, az_index, surface, bottom,
+     *     caustic, upper, lower, and a reserved zero as 32 bit integers.
+     *   - power for each eigenverb and frequency, as 64 bit floating point
+     *     numbers, in eigenverb major order.
+     *
+     * Values are stored in the same units as eigenverb_model, and in the
+     * native byte order of the machine that wrote the file. The byte order
+     * mark lets read_snapshot() reject files written on a machine with a
+     * different byte order.
+     *
+     * @param filename      Filename used to store this data.
+     * @throws std::invalid_argument if the file can not be created.
+     */
+    void write_snapshot(const char* filename) const;
+
+    /**
+     * Replaces all of the eigenverbs in this collection with those from a
+     * binary snapshot created by write_snapshot(). The records for each
+     * interface are read with a single call, and their eigenverbs are
+     * copied into a single allocation. The spatial index for each interface is bulk loaded before this returns,
+     * so that find_eigenverbs() is ready to use.
+     *
+     * @param filename      Filename used to retrieve this data.
+     * @throws std::invalid_argument if the file can not be opened, does
+     *                      not have the expected layout, or was written
+     *                      with a different byte order or version.
+     */
+    void read_snapshot(const char* filename);
+
    private:
+    /// Identifier at the start of each eigenverb snapshot.
+    static const char snapshot_magic[8];
+
+    /// Byte order mark, read back as a different number on other machines.
+    static const uint32_t snapshot_byte_order = 0x01020304;
+
+    /// Version number written to each snapshot.
+    static const uint32_t snapshot_version = 2;
+
     /// Point in geographic coordinates, based on degrees.
     typedef bgm::point<double, 2, bg::cs::spherical_equatorial<bg::degree>>
         point;
 
-    /// Eigenverb paired with its geographic coordinate.
-    typedef std::pair<point, eigenverb_model::csptr> pair;
+    /// Geographic coordinate paired with the eigenverb's position in its list.
+    typedef std::pair<point, size_t> pair;
 
     /// Spatial index for eigenverbs in geographic coordinates.
     typedef bgi::rtree<pair, bgi::rstar<8>> rtree;
@@ -228,8 +384,38 @@ class USML_DECLSPEC eigenverb_collection : public eigenverb_listener {
     /// Mutex to that locks object during changes.
     mutable read_write_lock _mutex;
 
-    /// Spatial index for each interface.
-    std::vector<rtree> _collection;
+    /// List of eigenverbs for each interface, in the order they were added.
+    std::vector<eigenverb_list> _collection;
+
+    /// Spatial index for each interface, built when it is first searched.
+    mutable std::vector<rtree> _index;
+
+    /**
+     * Bulk load the spatial index for an interface if it does not include
+     * all of the eigenverbs in the list. Caller must hold a write lock.
+     *
+     * @param interface Interface number of the index to be built.
+     */
+    void index(size_t interface) const;
+
+    /**
+     * Polygon that surrounds the search area for an eigenverb. Uses
+     * search_scale times the length and width of the eigenverb.
+     *
+     * @param verb      Eigenverb that defines the search area.
+     * @return          Clockwise polygon around the search area.
+     */
+    static bgm::polygon<point> search_area(const eigenverb_model& verb);
+
+    /**
+     * True if the travel time, grazing angle, and direction of two
+     * eigenverbs are within merge_time and merge_angle of each other.
+     *
+     * @param verb      Eigenverb at the center of the merge.
+     * @param other     Neighbor that may be merged with it.
+     */
+    static bool compatible(const eigenverb_model& verb,
+                           const eigenverb_model& other);
 };
 
 /// @}
@@ -8,9 +8,10 @@
 #include <usml/types/wposition1.h>
 
 #include <boost/numeric/ublas/vector.hpp>
+#include <boost/range/iterator_range.hpp>
 #include <cstddef>
-#include <list>
 #include <memory>
+#include <vector>
 
 namespace usml {
 namespace eigenverbs {
@@ -153,7 +154,13 @@ struct eigenverb_model {
 /*
  * List of Gaussian projections used for reverberation.
  */
-typedef std::list<eigenverb_model::csptr> eigenverb_list;
+typedef std::vector<eigenverb_model::csptr> eigenverb_list;
+
+/*
+ * Read-only view of a list of Gaussian projections, without copying them.
+ * Only valid while the list that it refers to is unchanged.
+ */
+typedef boost::iterator_range<eigenverb_list::const_iterator> eigenverb_span;
 
 /// @}
 }  // end of namespace eigenverbs
@@ -2,17 +2,22 @@
  * @example eigenverbs/test/eigenverbs_test.cc
  */
 #include <usml/eigenverbs/eigenverbs.h>
+#include <usml/netcdf/columnar_file.h>
+#include <usml/netcdf/columnar_writer.h>
 #include <usml/types/types.h>
 
 #include <boost/geometry/geometry.hpp>
 #include <boost/test/unit_test.hpp>
+#include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <iterator>
 
 BOOST_AUTO_TEST_SUITE(eigenverbs_test)
 
 using namespace boost::unit_test;
 using namespace usml::eigenverbs;
+using namespace usml::netcdf;
 
 static const double de_spacing = 10.0;
 static const double az_spacing = 10.0;
@@ -72,6 +77,8 @@ BOOST_AUTO_TEST_CASE(create_eigenverbs) {
 
     const char* ncname1 = USML_TEST_DIR "/eigenverbs/test/create_eigenverbs.nc";
     const char* ncname2 = USML_TEST_DIR "/eigenverbs/test/find_eigenverbs.nc";
+    const char* colname =
+        USML_TEST_DIR "/eigenverbs/test/create_eigenverbs.col";
 
     seq_vector::csptr frequencies(new seq_linear(3000.0, 1.0, 1));
     wposition1 source_pos(36.0, 16.0, 0.0);
@@ -89,13 +96,24 @@ BOOST_AUTO_TEST_CASE(create_eigenverbs) {
     }
     cout << "writing full set of eigenverbs to " << ncname1 << endl;
     collection.write_netcdf(ncname1, eigenverb_model::BOTTOM);
+    collection.write_columnar(colname, eigenverb_model::BOTTOM);
 
     // extract eigenverbs and test entries in collection
 
-    eigenverb_list full_list = collection.eigenverbs(eigenverb_model::BOTTOM);
+    eigenverb_span full_list = collection.eigenverbs(eigenverb_model::BOTTOM);
     BOOST_CHECK_EQUAL(full_list.size(), 80);
     BOOST_CHECK_EQUAL(collection.size(eigenverb_model::BOTTOM), 80);
 
+    // check columnar copy of the full set
+
+    columnar_writer::instance()->flush();
+    columnar_file copy = columnar_file::read(colname);
+    BOOST_CHECK_EQUAL(copy.attributes().at("long_name"), "bottom eigenverbs");
+    const auto* power = copy.find("power");
+    BOOST_REQUIRE(power != nullptr);
+    BOOST_CHECK_EQUAL(power->shape[0], 80);
+    BOOST_CHECK_EQUAL(power->shape[1], 1);
+
     // query collection for all eigenverb near a specific area
 
     eigenverb_model::csptr bounding_verb =
@@ -119,6 +137,265 @@ BOOST_AUTO_TEST_CASE(create_eigenverbs) {
                    collection.size(eigenverb_model::BOTTOM));
 }
 
+/**
+ * Checks that the spatial index is rebuilt when eigenverbs are added after
+ * it has been bulk loaded. Searches a collection, checks that all of the
+ * eigenverbs found are inside the search area, adds the bounding eigenverb
+ * at the center of the search area, and checks that the second search finds
+ * exactly one more eigenverb. Also checks that eigenverbs()
+ * returns the eigenverbs in the order that they were added.
+ */
+BOOST_AUTO_TEST_CASE(index_eigenverbs) {
+    cout << "=== eigenverbs_test: index_eigenverbs ===" << endl;
+
+    seq_vector::csptr frequencies(new seq_linear(3000.0, 1.0, 1));
+    wposition1 source_pos(36.0, 16.0, 0.0);
+    double depth = 1000;
+
+    eigenverb_collection collection(0);
+    for (double az = 0.0; az <= 90.0; az += az_spacing) {
+        for (double de = -90.0 + de_spacing; de < 0.0; de += de_spacing) {
+            collection.add_eigenverb(
+                create_eigenverb(source_pos, depth, de, az, frequencies),
+                eigenverb_model::BOTTOM);
+        }
+    }
+    collection.index();
+
+    eigenverb_model::csptr bounding_verb =
+        create_eigenverb(source_pos, depth, -40.0, 30.0, frequencies);
+    eigenverb_list found_list =
+        collection.find_eigenverbs(bounding_verb, eigenverb_model::BOTTOM);
+    BOOST_CHECK(!found_list.empty());
+    const double max_range =
+        eigenverb_collection::search_scale *
+        std::max(bounding_verb->length, bounding_verb->width);
+    for (const auto& verb : found_list) {
+        BOOST_CHECK_LE(bounding_verb->position.gc_range(verb->position),
+                       max_range);
+    }
+
+    collection.add_eigenverb(bounding_verb, eigenverb_model::BOTTOM);
+    eigenverb_span full_list = collection.eigenverbs(eigenverb_model::BOTTOM);
+    BOOST_CHECK_EQUAL(full_list.size(), 81);
+    BOOST_CHECK(full_list.back() == bounding_verb);
+
+    eigenverb_list found_again =
+        collection.find_eigenverbs(bounding_verb, eigenverb_model::BOTTOM);
+    BOOST_CHECK_EQUAL(found_again.size(), found_list.size() + 1);
+    BOOST_CHECK(std::find(found_again.begin(), found_again.end(),
+                          bounding_verb) != found_again.end());
+}
+
+/**
+ * Tests the ability to save eigenverbs in a binary snapshot and reload them.
+ * Writes a collection with one volume layer, where only the bottom and upper
+ * volume interfaces have eigenverbs, and reads it into a collection with
+ * no volume layers. Checks that the number of interfaces, the contents of
+ * each eigenverb, and the results of find_eigenverbs() are unchanged.
+ * Also checks that files in other formats, or written with a different
+ * byte order, are rejected.
+ */
+BOOST_AUTO_TEST_CASE(snapshot_eigenverbs) {
+    cout << "=== eigenverbs_test: snapshot_eigenverbs ===" << endl;
+    const char* filename = USML_TEST_DIR "/eigenverbs/test/snapshot.vrb";
+    const char* colname = USML_TEST_DIR "/eigenverbs/test/snapshot.col";
+    const char* swapname = USML_TEST_DIR "/eigenverbs/test/snapshot_swap.vrb";
+
+    seq_vector::csptr frequencies(new seq_linear(3000.0, 500.0, 3));
+    wposition1 source_pos(36.0, 16.0, 0.0);
+    double depth = 1000;
+
+    eigenverb_collection collection(1);
+    for (double az = 0.0; az <= 90.0; az += az_spacing) {
+        for (double de = -90.0 + de_spacing; de < 0.0; de += de_spacing) {
+            collection.add_eigenverb(
+                create_eigenverb(source_pos, depth, de, az, frequencies),
+                eigenverb_model::BOTTOM);
+        }
+    }
+    collection.add_eigenverb(
+        create_eigenverb(source_pos, 100.0, -30.0, 45.0, frequencies),
+        eigenverb_model::VOLUME_UPPER);
+    collection.write_snapshot(filename);
+
+    eigenverb_collection copy(0);
+    copy.read_snapshot(filename);
+    BOOST_CHECK_EQUAL(copy.num_interfaces(), collection.num_interfaces());
+    for (size_t interface = 0; interface < collection.num_interfaces();
+         ++interface) {
+        eigenverb_span original = collection.eigenverbs(interface);
+        eigenverb_span loaded = copy.eigenverbs(interface);
+        BOOST_REQUIRE_EQUAL(loaded.size(), original.size());
+        for (size_t n = 0; n < original.size(); ++n) {
+            const eigenverb_model& a = *original[n];
+            const eigenverb_model& b = *loaded[n];
+            BOOST_CHECK_EQUAL(b.travel_time, a.travel_time);
+            BOOST_CHECK_EQUAL(b.frequencies->size(), a.frequencies->size());
+            BOOST_CHECK_EQUAL(b.power.size(), a.power.size());
+            for (size_t f = 0; f < a.power.size(); ++f) {
+                BOOST_CHECK_EQUAL((*b.frequencies)(f), (*a.frequencies)(f));
+                BOOST_CHECK_EQUAL(b.power[f], a.power[f]);
+            }
+            BOOST_CHECK_EQUAL(b.length, a.length);
+            BOOST_CHECK_EQUAL(b.width, a.width);
+            BOOST_CHECK_EQUAL(b.position.latitude(), a.position.latitude());
+            BOOST_CHECK_EQUAL(b.position.longitude(), a.position.longitude());
+            BOOST_CHECK_CLOSE(b.position.altitude(), a.position.altitude(),
+                              1e-6);
+            BOOST_CHECK_EQUAL(b.direction, a.direction);
+            BOOST_CHECK_EQUAL(b.grazing, a.grazing);
+            BOOST_CHECK_EQUAL(b.sound_speed, a.sound_speed);
+            BOOST_CHECK_EQUAL(b.de_index, a.de_index);
+            BOOST_CHECK_EQUAL(b.az_index, a.az_index);
+            BOOST_CHECK_EQUAL(b.source_de, a.source_de);
+            BOOST_CHECK_EQUAL(b.source_az, a.source_az);
+            BOOST_CHECK_EQUAL(b.surface, a.surface);
+            BOOST_CHECK_EQUAL(b.bottom, a.bottom);
+            BOOST_CHECK_EQUAL(b.caustic, a.caustic);
+            BOOST_CHECK_EQUAL(b.upper, a.upper);
+            BOOST_CHECK_EQUAL(b.lower, a.lower);
+        }
+    }
+
+    // search reloaded collection without adding eigenverbs
+
+    eigenverb_model::csptr bounding_verb =
+        create_eigenverb(source_pos, depth, -40.0, 30.0, frequencies);
+    eigenverb_list expected =
+        collection.find_eigenverbs(bounding_verb, eigenverb_model::BOTTOM);
+    eigenverb_list found =
+        copy.find_eigenverbs(bounding_verb, eigenverb_model::BOTTOM);
+    BOOST_CHECK(!found.empty());
+    BOOST_CHECK_EQUAL(found.size(), expected.size());
+
+    // reject files that are not eigenverb snapshots, using a columnar file
+    // written synchronously, so that it exists before it is read
+
+    columnar_file other;
+    other.attribute("long_name", "bottom eigenverbs");
+    other.add("travel_time", "seconds", std::vector<double>(10, 1.0));
+    other.write(colname);
+    BOOST_REQUIRE(std::ifstream(colname).good());
+    BOOST_CHECK_THROW(copy.read_snapshot(colname), std::invalid_argument);
+    BOOST_CHECK_EQUAL(copy.size(eigenverb_model::BOTTOM), 80);
+
+    // reject snapshots written with a different byte order, by reversing
+    // the byte order mark that follows the identifier
+
+    std::string bytes;
+    {
+        std::ifstream stream(filename, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(stream),
+                     std::istreambuf_iterator<char>());
+    }
+    std::reverse(bytes.begin() + 8, bytes.begin() + 12);
+    std::ofstream(swapname, std::ios::binary) << bytes;
+    BOOST_CHECK_THROW(copy.read_snapshot(swapname), std::invalid_argument);
+    BOOST_CHECK_EQUAL(copy.size(eigenverb_model::BOTTOM), 80);
+}
+
+/**
+ * Tests the ability to merge overlapping eigenverbs. Builds two copies of
+ * each eigenverb from create_eigenverbs, with the second copy shifted by
+ * a small fraction of its width, and merges them. Neighboring eigenverbs
+ * differ by 10 degrees in grazing angle or direction, so only the copies
+ * should be merged. Checks that the number of eigenverbs is cut in half,
+ * that the total power is preserved, and that the merged Gaussians are
+ * centered between the copies.
+ */
+BOOST_AUTO_TEST_CASE(merge_eigenverbs) {
+    cout << "=== eigenverbs_test: merge_eigenverbs ===" << endl;
+
+    seq_vector::csptr frequencies(new seq_linear(3000.0, 1.0, 1));
+    wposition1 source_pos(36.0, 16.0, 0.0);
+    double depth = 1000;
+
+    eigenverb_collection collection(0);
+    for (double az = 0.0; az <= 90.0; az += az_spacing) {
+        for (double de = -90.0 + de_spacing; de < 0.0; de += de_spacing) {
+            eigenverb_model::csptr verb =
+                create_eigenverb(source_pos, depth, de, az, frequencies);
+            auto* copy = new eigenverb_model(*verb);
+            copy->position = wposition1(verb->position, 0.1 * verb->width,
+                                        verb->direction + M_PI_2);
+            copy->position.altitude(-depth);
+            collection.add_eigenverb(verb, eigenverb_model::BOTTOM);
+            collection.add_eigenverb(eigenverb_model::csptr(copy),
+                                     eigenverb_model::BOTTOM);
+        }
+    }
+    BOOST_CHECK_EQUAL(collection.size(eigenverb_model::BOTTOM), 160);
+
+    const size_t removed = collection.merge(0.5);
+    BOOST_CHECK_EQUAL(removed, 80);
+    BOOST_CHECK_EQUAL(collection.size(eigenverb_model::BOTTOM), 80);
+
+    for (const auto& verb : collection.eigenverbs(eigenverb_model::BOTTOM)) {
+        BOOST_CHECK_CLOSE(verb->power[0], 2.0, 1e-10);
+        double de = -to_degrees(verb->grazing);
+        double az = to_degrees(verb->direction);
+        eigenverb_model::csptr orig =
+            create_eigenverb(source_pos, depth, de, az, frequencies);
+        wposition1 center(orig->position, 0.05 * orig->width,
+                          orig->direction + M_PI_2);
+        BOOST_CHECK_SMALL(center.gc_range(verb->position), 0.01 * orig->width);
+        BOOST_CHECK_CLOSE(verb->length, orig->length, 1e-3);
+        BOOST_CHECK_GE(verb->width, orig->width);
+    }
+
+    // a second merge should find nothing to combine
+
+    BOOST_CHECK_EQUAL(collection.merge(0.5), 0);
+}
+
+/**
+ * Tests that merging eigenverbs spread across-track preserves the direction
+ * of their D/E axis. Builds an eigenverb whose width is almost as large as
+ * its length, and two copies shifted to either side of it. The spread of
+ * the copies makes the merged covariance wider than it is long. Checks
+ * that the merged eigenverb keeps the original direction, its length, and
+ * that its width grows to cover the copies.
+ */
+BOOST_AUTO_TEST_CASE(merge_across_track) {
+    cout << "=== eigenverbs_test: merge_across_track ===" << endl;
+
+    seq_vector::csptr frequencies(new seq_linear(3000.0, 1.0, 1));
+    wposition1 source_pos(36.0, 16.0, 0.0);
+    double depth = 1000;
+
+    eigenverb_model::csptr verb =
+        create_eigenverb(source_pos, depth, -40.0, 30.0, frequencies);
+    auto* center = new eigenverb_model(*verb);
+    center->length = 100.0;
+    center->width = 95.0;
+
+    eigenverb_collection collection(0);
+    collection.add_eigenverb(eigenverb_model::csptr(center),
+                             eigenverb_model::BOTTOM);
+    for (double side : {-1.0, 1.0}) {
+        auto* copy = new eigenverb_model(*center);
+        copy->position = wposition1(center->position, 0.6 * center->width,
+                                    center->direction + side * M_PI_2);
+        copy->position.altitude(-depth);
+        collection.add_eigenverb(eigenverb_model::csptr(copy),
+                                 eigenverb_model::BOTTOM);
+    }
+
+    BOOST_CHECK_EQUAL(collection.merge(1.0), 2);
+    eigenverb_span list = collection.eigenverbs(eigenverb_model::BOTTOM);
+    BOOST_REQUIRE_EQUAL(list.size(), 1);
+    const eigenverb_model& merged = *list[0];
+    BOOST_CHECK_SMALL(remainder(merged.direction - center->direction,
+                                2.0 * M_PI),
+                      1e-9);
+    BOOST_CHECK_CLOSE(merged.length, center->length, 1e-3);
+    BOOST_CHECK_CLOSE(merged.width,
+                      center->width * sqrt(1.0 + 2.0 / 3.0 * 0.36), 0.1);
+    BOOST_CHECK_GT(merged.width, merged.length);
+    BOOST_CHECK_CLOSE(merged.power[0], 3.0, 1e-10);
+}
+
 /// @}
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,231 @@
+/**
+ * @file columnar_file.cc
+ * Flat binary file of named data columns.
+ */
+
+#include <usml/netcdf/columnar_file.h>
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+using namespace usml::netcdf;
+
+namespace {
+
+/// Identifies columnar files.
+const char MAGIC[8] = {'U', 'S', 'M', 'L', 'C', 'O', 'L', '\0'};
+
+/**
+ * Append a number to a header, in little-endian order.
+ */
+template <class T>
+void put(std::vector<char>* header, T value) {
+    for (size_t n = 0; n < sizeof(T); ++n) {
+        header->push_back(char((value >> (8 * n)) & 0xff));
+    }
+}
+
+/**
+ * Append a length prefixed string to a header.
+ */
+void put(std::vector<char>* header, const std::string& value) {
+    put(header, (uint32_t)value.size());
+    header->insert(header->end(), value.begin(), value.end());
+}
+
+/**
+ * Extract a little-endian number from a file.
+ */
+template <class T>
+T get(std::istream& stream) {
+    unsigned char bytes[sizeof(T)];
+    if (!stream.read((char*)bytes, sizeof(T))) {
+        throw std::runtime_error("truncated columnar file");
+    }
+    T value = 0;
+    for (size_t n = 0; n < sizeof(T); ++n) {
+        value |= T(bytes[n]) << (8 * n);
+    }
+    return value;
+}
+
+/**
+ * Extract a length prefixed string from a file.
+ */
+std::string get_string(std::istream& stream) {
+    std::string value(get<uint32_t>(stream), '\0');
+    if (!stream.read(&value[0], (std::streamsize)value.size())) {
+        throw std::runtime_error("truncated columnar file");
+    }
+    return value;
+}
+
+/**
+ * Round a file offset up to the next 8 byte boundary.
+ */
+uint64_t align(uint64_t offset) { return (offset + 7) & ~uint64_t(7); }
+
+/**
+ * True if this computer stores numbers in little-endian order.
+ */
+bool little_endian() {
+    const uint16_t one = 1;
+    char first;
+    std::memcpy(&first, &one, 1);
+    return first == 1;
+}
+
+/**
+ * Number of bytes in each element of a NumPy type string like "<f8".
+ */
+size_t element_size(const std::string& dtype) {
+    return std::stoul(dtype.substr(2));
+}
+
+/**
+ * Reverse the order of the bytes in each element of a column, to convert
+ * between native and little-endian order on big-endian computers.
+ */
+void swap_bytes(std::vector<char>* data, size_t width) {
+    for (size_t n = 0; n + width <= data->size(); n += width) {
+        std::reverse(data->begin() + n, data->begin() + n + width);
+    }
+}
+
+}  // namespace
+
+/**
+ * Find a column by name.
+ */
+const columnar_file::column* columnar_file::find(
+    const std::string& name) const {
+    for (const auto& col : _columns) {
+        if (col.name == name) {
+            return &col;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * Write this file to disk.
+ */
+void columnar_file::write(const std::string& filename) const {
+    // compute size of header, with placeholders for data offsets
+
+    std::vector<char> header(MAGIC, MAGIC + sizeof(MAGIC));
+    put(&header, version);
+    put(&header, (uint32_t)_attributes.size());
+    put(&header, (uint32_t)_columns.size());
+    put(&header, (uint32_t)0);
+    for (const auto& attr : _attributes) {
+        put(&header, attr.first);
+        put(&header, attr.second);
+    }
+    std::vector<size_t> offset_pos;
+    for (const auto& col : _columns) {
+        put(&header, col.name);
+        put(&header, col.units);
+        put(&header, col.dtype);
+        put(&header, (uint32_t)col.shape.size());
+        for (auto size : col.shape) {
+            put(&header, size);
+        }
+        offset_pos.push_back(header.size());
+        put(&header, (uint64_t)0);
+    }
+
+    // fill in data offsets
+
+    std::vector<uint64_t> offsets;
+    uint64_t offset = align(header.size());
+    for (size_t n = 0; n < _columns.size(); ++n) {
+        offsets.push_back(offset);
+        for (size_t b = 0; b < sizeof(uint64_t); ++b) {
+            header[offset_pos[n] + b] = char((offset >> (8 * b)) & 0xff);
+        }
+        offset = align(offset + _columns[n].data.size());
+    }
+
+    // write header and data with padding between them
+
+    std::ofstream stream(filename, std::ios::binary | std::ios::trunc);
+    static const char padding[8] = {0};
+    const bool swap = !little_endian();
+    stream.write(header.data(), (std::streamsize)header.size());
+    uint64_t position = header.size();
+    for (size_t n = 0; n < _columns.size(); ++n) {
+        stream.write(padding, (std::streamsize)(offsets[n] - position));
+        const auto& data = _columns[n].data;
+        if (swap) {
+            std::vector<char> swapped(data);
+            swap_bytes(&swapped, element_size(_columns[n].dtype));
+            stream.write(swapped.data(), (std::streamsize)swapped.size());
+        } else {
+            stream.write(data.data(), (std::streamsize)data.size());
+        }
+        position = offsets[n] + data.size();
+    }
+    if (!stream) {
+        throw std::runtime_error("unable to write " + filename);
+    }
+}
+
+/**
+ * Read a file from disk.
+ */
+columnar_file columnar_file::read(const std::string& filename) {
+    std::ifstream stream(filename, std::ios::binary);
+    char magic[sizeof(MAGIC)];
+    if (!stream.read(magic, sizeof(magic)) ||
+        std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("not a columnar file: " + filename);
+    }
+    if (get<uint32_t>(stream) != version) {
+        throw std::runtime_error("unsupported columnar version: " + filename);
+    }
+    const auto num_attributes = get<uint32_t>(stream);
+    const auto num_columns = get<uint32_t>(stream);
+    get<uint32_t>(stream);
+
+    columnar_file file;
+    for (uint32_t n = 0; n < num_attributes; ++n) {
+        auto name = get_string(stream);
+        file._attributes[name] = get_string(stream);
+    }
+    std::vector<uint64_t> offsets;
+    for (uint32_t n = 0; n < num_columns; ++n) {
+        column col;
+        col.name = get_string(stream);
+        col.units = get_string(stream);
+        col.dtype = get_string(stream);
+        col.shape.resize(get<uint32_t>(stream));
+        for (auto& size : col.shape) {
+            size = get<uint64_t>(stream);
+        }
+        offsets.push_back(get<uint64_t>(stream));
+        file._columns.push_back(std::move(col));
+    }
+
+    // read data for each column, using the size of its type
+
+    const bool swap = !little_endian();
+    for (size_t n = 0; n < num_columns; ++n) {
+        auto& col = file._columns[n];
+        const size_t width = element_size(col.dtype);
+        size_t count = width;
+        for (auto size : col.shape) {
+            count *= (size_t)size;
+        }
+        col.data.resize(count);
+        stream.seekg((std::streamoff)offsets[n]);
+        if (!stream.read(col.data.data(), (std::streamsize)count)) {
+            throw std::runtime_error("truncated columnar file: " + filename);
+        }
+        if (swap) {
+            swap_bytes(&col.data, width);
+        }
+    }
+    return file;
+}
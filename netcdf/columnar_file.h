@@ -0,0 +1,186 @@
+/**
+ * @file columnar_file.h
+ * Flat binary file of named data columns.
+ */
+#pragma once
+
+#include <usml/usml_config.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace usml {
+namespace netcdf {
+
+/// @ingroup netcdf_files
+/// @{
+
+/**
+ * Flat binary file of named data columns. Used to log model results at a
+ * much higher rate than the NetCDF writers, which build their files record
+ * by record. Each column is a contiguous, row major array that is written
+ * with a single call, and can be read with a single call, or memory mapped,
+ * by other languages. The Python reader is in usml.columnar.
+ *
+ * All numbers in the file are little-endian. Column data is kept in the
+ * native byte order of this computer while in memory, and is converted
+ * to little-endian by write() and read() on big-endian computers. The
+ * file layout is:
+ * <pre>
+ *   char[8]    magic       "USMLCOL" followed by a null
+ *   uint32     version     1
+ *   uint32     num_attributes
+ *   uint32     num_columns
+ *   uint32     reserved    0
+ *   attributes, each:      string name, string value
+ *   columns, each:         string name, string units, string dtype,
+ *                          uint32 ndim, uint64 shape[ndim],
+ *                          uint64 offset of data from start of file
+ *   column data, each aligned on an 8 byte boundary
+ * </pre>
+ * where each string is a uint32 length followed by its characters, and the
+ * dtype is a NumPy type string like "<f8" or "<i2". Scalars have zero
+ * dimensions.
+ *
+ * The file is built in memory, so that the caller can hand it off to the
+ * columnar_writer and continue while it is written in the background.
+ */
+class USML_DECLSPEC columnar_file {
+   public:
+    /// Single named column of data.
+    struct column {
+        /// Name of the column.
+        std::string name;
+
+        /// Units of the data in this column.
+        std::string units;
+
+        /// NumPy type string for each element, like "<f8".
+        std::string dtype;
+
+        /// Size of each dimension, empty for scalars.
+        std::vector<uint64_t> shape;
+
+        /// Raw bytes for the data in row major, native byte order.
+        std::vector<char> data;
+    };
+
+    /// Version number written to each file.
+    static const uint32_t version = 1;
+
+    /**
+     * Add a global attribute to the file, like the "long_name" attribute
+     * in the NetCDF files.
+     *
+     * @param name      Name of the attribute.
+     * @param value     Value of the attribute.
+     */
+    void attribute(const std::string& name, const std::string& value) {
+        _attributes[name] = value;
+    }
+
+    /// Global attributes for this file.
+    const std::map<std::string, std::string>& attributes() const {
+        return _attributes;
+    }
+
+    /**
+     * Add an array of data to the file. Copies the data, so that the caller
+     * may change it before the file is written.
+     *
+     * @param name      Name of the column.
+     * @param units     Units of the data in this column.
+     * @param shape     Size of each dimension.
+     * @param data      Data in row major order.
+     */
+    template <class T>
+    void add(const std::string& name, const std::string& units,
+             const std::vector<uint64_t>& shape, const T* data) {
+        size_t count = 1;
+        for (auto size : shape) {
+            count *= (size_t)size;
+        }
+        column col{name, units, dtype(T()), shape,
+                   std::vector<char>(count * sizeof(T))};
+        if (count > 0) {
+            std::memcpy(col.data.data(), data, col.data.size());
+        }
+        _columns.push_back(std::move(col));
+    }
+
+    /**
+     * Add a one dimensional array of data to the file.
+     *
+     * @param name      Name of the column.
+     * @param units     Units of the data in this column.
+     * @param data      Data to be stored.
+     */
+    template <class T>
+    void add(const std::string& name, const std::string& units,
+             const std::vector<T>& data) {
+        add(name, units, {data.size()}, data.data());
+    }
+
+    /**
+     * Add a scalar to the file.
+     *
+     * @param name      Name of the column.
+     * @param units     Units of the data in this column.
+     * @param value     Value to be stored.
+     */
+    template <class T>
+    void add(const std::string& name, const std::string& units, T value) {
+        add(name, units, {}, &value);
+    }
+
+    /// Columns in the order that they were added.
+    const std::vector<column>& columns() const { return _columns; }
+
+    /**
+     * Find a column by name.
+     *
+     * @param name      Name of the column.
+     * @return          Reference to the column, nullptr if not found.
+     */
+    const column* find(const std::string& name) const;
+
+    /**
+     * Write this file to disk.
+     *
+     * @param filename  Name of the file to write.
+     * @throws          std::runtime_error if the file can not be written.
+     */
+    void write(const std::string& filename) const;
+
+    /**
+     * Read a file from disk.
+     *
+     * @param filename  Name of the file to read.
+     * @throws          std::runtime_error if the file can not be read,
+     *                  or is not a columnar file.
+     */
+    static columnar_file read(const std::string& filename);
+
+   private:
+    /// Global attributes for this file.
+    std::map<std::string, std::string> _attributes;
+
+    /// Columns in the order that they were added.
+    std::vector<column> _columns;
+
+    /// NumPy type strings for each supported element type.
+    static const char* dtype(double) { return "<f8"; }
+    static const char* dtype(float) { return "<f4"; }
+    static const char* dtype(int64_t) { return "<i8"; }
+    static const char* dtype(uint64_t) { return "<u8"; }
+    static const char* dtype(int32_t) { return "<i4"; }
+    static const char* dtype(int16_t) { return "<i2"; }
+};
+
+/// @}
+}  // end of namespace netcdf
+}  // end of namespace usml
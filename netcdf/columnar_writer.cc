@@ -0,0 +1,124 @@
+/**
+ * @file columnar_writer.cc
+ * Writes columnar files on a background I/O thread.
+ */
+
+#include <usml/netcdf/columnar_writer.h>
+
+#include <exception>
+#include <iostream>
+
+using namespace usml::netcdf;
+
+/** Initializes empty reference to singleton. */
+std::unique_ptr<columnar_writer> columnar_writer::_instance;
+
+/** Initializes mutex for singleton construction. */
+read_write_lock columnar_writer::_instance_mutex;
+
+/**
+ * Singleton constructor, implemented using double-checked locking pattern.
+ */
+columnar_writer* columnar_writer::instance() {
+    columnar_writer* writer = _instance.get();
+    if (writer == nullptr) {
+        write_lock_guard guard(_instance_mutex);
+        writer = _instance.get();
+        if (writer == nullptr) {
+            writer = new columnar_writer();
+            _instance.reset(writer);
+        }
+    }
+    return writer;
+}
+
+/**
+ * Writes all queued files and destroys the singleton.
+ */
+void columnar_writer::reset() {
+    write_lock_guard guard(_instance_mutex);
+    _instance.reset();
+}
+
+/**
+ * Writes all queued files and stops the I/O thread.
+ */
+columnar_writer::~columnar_writer() {
+    {
+        std::lock_guard<std::mutex> guard(_mutex);
+        _stop = true;
+    }
+    _ready.notify_all();
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+}
+
+/**
+ * Queue a file to be written in the background.
+ */
+void columnar_writer::write(const std::string& filename,
+                            columnar_file&& file) {
+    {
+        std::lock_guard<std::mutex> guard(_mutex);
+        _queue.emplace_back(filename, std::move(file));
+        if (!_thread.joinable()) {
+            _thread = std::thread(&columnar_writer::run, this);
+        }
+    }
+    _ready.notify_one();
+}
+
+/**
+ * Wait until all of the queued files have been written.
+ */
+void columnar_writer::flush() {
+    std::unique_lock<std::mutex> guard(_mutex);
+    _idle.wait(guard, [this] { return _queue.empty() && !_busy; });
+}
+
+/**
+ * Number of files that are waiting to be written.
+ */
+size_t columnar_writer::num_pending() const {
+    std::lock_guard<std::mutex> guard(_mutex);
+    return _queue.size() + (_busy ? 1 : 0);
+}
+
+/**
+ * Number of files that could not be written.
+ */
+size_t columnar_writer::num_errors() const {
+    std::lock_guard<std::mutex> guard(_mutex);
+    return _num_errors;
+}
+
+/**
+ * Write files until the singleton is destroyed.
+ */
+void columnar_writer::run() {
+    std::unique_lock<std::mutex> guard(_mutex);
+    while (true) {
+        _ready.wait(guard, [this] { return _stop || !_queue.empty(); });
+        if (_queue.empty()) {
+            return;  // stop requested and all files written
+        }
+        auto entry = std::move(_queue.front());
+        _queue.pop_front();
+        _busy = true;
+        guard.unlock();
+        bool failed = false;
+        try {
+            entry.second.write(entry.first);
+        } catch (const std::exception& ex) {
+            std::cout << "columnar_writer: " << ex.what() << std::endl;
+            failed = true;
+        }
+        guard.lock();
+        _busy = false;
+        _num_errors += failed ? 1 : 0;
+        if (_queue.empty()) {
+            _idle.notify_all();
+        }
+    }
+}
@@ -0,0 +1,121 @@
+/**
+ * @file columnar_writer.h
+ * Writes columnar files on a background I/O thread.
+ */
+#pragma once
+
+#include <usml/netcdf/columnar_file.h>
+#include <usml/threads/read_write_lock.h>
+#include <usml/usml_config.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace usml {
+namespace netcdf {
+
+using namespace usml::threads;
+
+/// @ingroup netcdf_files
+/// @{
+
+/**
+ * Writes columnar files on a background I/O thread. The write_columnar()
+ * methods of the eigenray, eigenverb, biverb, and rvbts collections copy
+ * their results into a columnar_file, and pass it to this singleton, so
+ * that compute threads do not wait for the disk. Files are written in the
+ * order that they are queued. The I/O thread is started when the first
+ * file is queued.
+ *
+ * Errors are reported on the console, and counted by num_errors(), because
+ * there is no caller to receive an exception.
+ */
+class USML_DECLSPEC columnar_writer {
+   public:
+    /**
+     * Provides a reference to the columnar_writer singleton. If this is the
+     * first time that this has been invoked, the singleton is automatically
+     * constructed.
+     *
+     * @return  Reference to the columnar_writer singleton.
+     */
+    static columnar_writer* instance();
+
+    /**
+     * Writes all queued files and destroys the singleton.
+     */
+    static void reset();
+
+    /**
+     * Writes all queued files and stops the I/O thread.
+     */
+    ~columnar_writer();
+
+    /**
+     * Queue a file to be written in the background.
+     *
+     * @param filename  Name of the file to write.
+     * @param file      Contents of the file.
+     */
+    void write(const std::string& filename, columnar_file&& file);
+
+    /**
+     * Wait until all of the queued files have been written.
+     */
+    void flush();
+
+    /** Number of files that are waiting to be written. */
+    size_t num_pending() const;
+
+    /** Number of files that could not be written. */
+    size_t num_errors() const;
+
+   private:
+    /// Reference to singleton.
+    static std::unique_ptr<columnar_writer> _instance;
+
+    /// Mutex for singleton access.
+    static read_write_lock _instance_mutex;
+
+    /// Mutex used to lock the queue of files.
+    mutable std::mutex _mutex;
+
+    /// Signals the I/O thread that a file is ready, or that it should stop.
+    std::condition_variable _ready;
+
+    /// Signals flush() that the queue is empty.
+    std::condition_variable _idle;
+
+    /// Files waiting to be written.
+    std::deque<std::pair<std::string, columnar_file>> _queue;
+
+    /// True while the I/O thread is writing a file.
+    bool _busy{false};
+
+    /// Flag that stops the I/O thread once the queue is empty.
+    bool _stop{false};
+
+    /// Number of files that could not be written.
+    size_t _num_errors{0};
+
+    /// Thread that writes files to disk.
+    std::thread _thread;
+
+    /// Hide default constructor to prevent incorrect use of singleton.
+    columnar_writer() {}
+
+    /**
+     * Write files until the singleton is destroyed.
+     */
+    void run();
+};
+
+/// @}
+}  // end of namespace netcdf
+}  // end of namespace usml
@@ -4,6 +4,7 @@
  */
 
 #include <usml/netcdf/netcdf_bathy.h>
+#include <usml/netcdf/netcdf_utils.h>
 #include <usml/types/seq_linear.h>
 #include <usml/types/seq_vector.h>
 #include <usml/ublas/math_traits.h>
@@ -12,6 +13,7 @@
 #include <cmath>
 #include <cstddef>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 
 using namespace usml::netcdf;
@@ -24,6 +26,7 @@ netcdf_bathy::netcdf_bathy(const char* filename, double south, double north,
                            double west, double east, double earth_radius) {
     // initialize access to NetCDF file.
 
+    std::lock_guard<std::mutex> lock(netcdf_utils::mutex());
     NcFile file(filename);
     if (file.is_valid() == 0) {
         throw std::invalid_argument("file not found");
@@ -32,30 +35,29 @@ netcdf_bathy::netcdf_bathy(const char* filename, double south, double north,
     NcVar* latitude;
     NcVar* altitude;
     decode_filetype(file, &latitude, &longitude, &altitude);
+    const auto lngs = netcdf_utils::read_axis(longitude);
+    const auto lats = netcdf_utils::read_axis(latitude);
 
     double offset = 0.0;
     long duplicate = 0;
-    long n = longitude->num_vals() - 1;
+    long n = long(lngs.size()) - 1;
 
     // Is the data set bounds 0 to 359(360)
-    bool zero_to_360 =
-        longitude->as_double(0) == 0.0 && longitude->as_double(n) >= 359.0;
+    bool zero_to_360 = lngs[0] == 0.0 && lngs[n] >= 359.0;
 
     // Is the data set bounds -180 to 179(180)
-    bool bounds_180 =
-        longitude->as_double(n) >= 179.0 && longitude->as_double(0) == -180.0;
+    bool bounds_180 = lngs[n] >= 179.0 && lngs[0] == -180.0;
 
     // Is this set a global data set
     bool global = (zero_to_360 || bounds_180);
     if (global) {
         // check to see if database has duplicate data at cut point
-        if (abs(longitude->as_double(0) + 360 - longitude->as_double(n)) <
-            1e-4) {
+        if (abs(lngs[0] + 360 - lngs[n]) < 1e-4) {
             duplicate = 1;
         }
 
         // manage wrap-around between eastern and western hemispheres
-        if (longitude->as_double(0) < 0.0) {
+        if (lngs[0] < 0.0) {
             // if database has a range (-180,180)
             // make western longitudes into negative numbers
             // unless they span the 180 latitude
@@ -70,11 +72,11 @@ netcdf_bathy::netcdf_bathy(const char* filename, double south, double north,
             }
         }
     } else {
-        if (longitude->as_double(0) > 180.0) {
+        if (lngs[0] > 180.0) {
             if (west < 0.0) {
                 offset = 360.0;
             }
-        } else if (longitude->as_double(0) < 0.0) {
+        } else if (lngs[0] < 0.0) {
             if (east > 180.0) {
                 offset = -360.0;
             }
@@ -88,9 +90,9 @@ netcdf_bathy::netcdf_bathy(const char* filename, double south, double north,
     // lat_first and lat_last are the integer offsets along this axis
     // _axis[0] is expressed as co-latitude in radians [0,PI]
 
-    double a = latitude->as_double(0);
-    n = latitude->num_vals() - 1;
-    double inc = double(latitude->as_double(n) - a) / double(n);
+    double a = lats[0];
+    n = long(lats.size()) - 1;
+    double inc = double(lats[n] - a) / double(n);
     const long lat_first = max(0L, long(floor(1e-6 + (south - a) / inc)));
     const long lat_last = min(n, long(floor(0.5 + (north - a) / inc)));
     const long lat_num = lat_last - lat_first + 1;
@@ -102,9 +104,9 @@ netcdf_bathy::netcdf_bathy(const char* filename, double south, double north,
     // lng_first and lng_last are the integer offsets along this axis
     // _axis[1] is expressed as longitude in radians [-PI,2*PI]
 
-    a = longitude->as_double(0);
-    n = longitude->num_vals() - 1;
-    inc = double(longitude->as_double(n) - a) / double(n);
+    a = lngs[0];
+    n = long(lngs.size()) - 1;
+    inc = double(lngs[n] - a) / double(n);
     auto index = long(floor(1e-6 + (west - a) / inc));
     const long lng_first = (global) ? index : max(0L, index);
     index = long(floor(0.5 + (east - a) / inc));
@@ -120,31 +122,20 @@ netcdf_bathy::netcdf_bathy(const char* filename, double south, double north,
     _writeable_data = std::shared_ptr<double[]>(data);
     _data = _writeable_data;
 
-    if (longitude->num_vals() > lng_last || !global) {
-        altitude->set_cur(lat_first, lng_first);
-        altitude->get(data, lat_num, lng_num);
+    if (long(lngs.size()) > lng_last || !global) {
+        const long corner[] = {lat_first, lng_first};
+        const long count[] = {lat_num, lng_num};
+        netcdf_utils::read_hyperslab(altitude, corner, count, data);
 
         // support datasets that cross the unwrapping longitude
         // assumes that bathy data is repeated on both sides of cut point
 
     } else {
-        long M = lng_last - longitude->num_vals() + 1;  // # pts on east side
-        long N = lng_num - M;                           // # pts on west side
-        double* ptr = data;
-        for (long lat = lat_first; lat <= lat_last; ++lat) {
-            // the west side of the block is the portion from
-            // lng_first to the last latitude
-            altitude->set_cur(lat, lng_first);
-            altitude->get(ptr, 1, N);
-            ptr += N;
-
-            // the missing points on the east side of the block
-            // are read from zero until the right # of points are read
-            // skip first longitude if it is a duplicate
-            altitude->set_cur(lat, duplicate);
-            altitude->get(ptr, 1, M);
-            ptr += M;
-        }
+        const long M = lng_last - long(lngs.size()) + 1;  // # pts on east side
+        const long corner[] = {lat_first, lng_first};
+        const long count[] = {lat_num, lng_num};
+        netcdf_utils::read_wrapped(altitude, corner, count, lng_num - M,
+                                   duplicate, data);
     }
 
     // convert depth to rho coordinate of spherical earth system
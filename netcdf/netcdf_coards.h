@@ -6,12 +6,14 @@
 
 #include <ncvalues.h>
 #include <netcdfcpp.h>
+#include <usml/netcdf/netcdf_utils.h>
 #include <usml/types/gen_grid.h>
 #include <usml/types/seq_vector.h>
 
 #include <cmath>
 #include <cstddef>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <vector>
 
@@ -27,6 +29,9 @@ using namespace usml::types;
 /**
  * Reads a single COARDS data grid from a netCDF file.
  * Assumes that the entire file should be read into memory.
+ * Dimensions after the first NUM_DIMS must have a size of one,
+ * like a time dimension with a single entry. Holds netcdf_utils::mutex()
+ * while reading from the file.
  *
  * The Cooperative Ocean/Atmosphere Research Data Service
  * (COARDS) is a NOAA/university cooperative for the sharing
@@ -61,14 +66,8 @@ class netcdf_coards : public gen_grid<NUM_DIMS> {
             throw std::invalid_argument("NetCDF variable not found");
         }
 
-        const int N = (int)axis->num_vals();
-        std::vector<double> data;
-
-        // Convert to std::vector
-        for (int n = 0; n < N; ++n) {
-            double p = axis->as_double(n);
-            data.push_back(p);
-        }
+        // read all values with a single call
+        std::vector<double> data = netcdf_utils::read_axis(axis);
 
         // build and return
         // best fit for seq_linear or seq_log or worst case seq_data
@@ -85,16 +84,35 @@ class netcdf_coards : public gen_grid<NUM_DIMS> {
      * @param  name         Name of the data grid to extract (case sensitive).
      * @param  read_fill    Read _FillValue from NetCDF file if true.
      *                         Use NAN as fill value if false.
+     * @throws invalid_argument if the variable is not found, if its
+     *                         extra dimensions are not singletons, or if
+     *                         it can not be read.
      */
     netcdf_coards(NcFile& file, NcToken name, bool read_fill = false) {
         this->_zero = 0.0;  // avoid uninitialized values in gen_grid class
 
         // search for this grid in the NetCDF file
+        // dimensions after the first NUM_DIMS must be singletons
 
+        std::lock_guard<std::mutex> lock(netcdf_utils::mutex());
         NcVar* variable = file.get_var(name);
         if (variable == 0) {
             throw std::invalid_argument("NetCDF variable not found");
         }
+        const int num_dims = variable->num_dims();
+        if (num_dims < NUM_DIMS) {
+            throw std::invalid_argument(
+                "NetCDF variable has too few dimensions");
+        }
+        std::vector<long> corner(num_dims, 0L);
+        std::vector<long> count(num_dims, 1L);
+        for (int n = 0; n < num_dims; ++n) {
+            count[n] = variable->get_dim(n)->size();
+            if (n >= NUM_DIMS && count[n] != 1) {
+                throw std::invalid_argument(
+                    "NetCDF variable has too many dimensions");
+            }
+        }
 
         // read axis data from NetCDF file.
 
@@ -136,16 +154,13 @@ class netcdf_coards : public gen_grid<NUM_DIMS> {
         this->_writeable_data = std::shared_ptr<double[]>(data);
         this->_data = this->_writeable_data;
 
-        NcValues* values = variable->values();
-        for (size_t n = 0; n < N; ++n) {
-            data[n] = (double)values->as_double((long)n);
-            if (!std::isnan(missing)) {
-                if (data[n] == missing) {
-                    data[n] = filling;
-                }
+        netcdf_utils::read_hyperslab(variable, corner.data(), count.data(),
+                                     data);
+        if (!std::isnan(missing)) {
+            for (size_t n = 0; n < N; ++n) {
+                data[n] = (data[n] == missing) ? filling : data[n];
             }
         }
-        delete values;
     }
 };
 
@@ -12,7 +12,10 @@
  */
 #pragma once
 
+#include <usml/netcdf/columnar_file.h>
+#include <usml/netcdf/columnar_writer.h>
 #include <usml/netcdf/netcdf_bathy.h>
 #include <usml/netcdf/netcdf_coards.h>
 #include <usml/netcdf/netcdf_profile.h>
+#include <usml/netcdf/netcdf_utils.h>
 #include <usml/netcdf/netcdf_woa.h>
@@ -3,11 +3,13 @@
  * Extracts ocean profile data from world-wide databases.
  */
 #include <usml/netcdf/netcdf_profile.h>
+#include <usml/netcdf/netcdf_utils.h>
 #include <usml/types/seq_data.h>
 #include <usml/types/seq_linear.h>
 #include <usml/types/seq_vector.h>
 
 #include <boost/algorithm/string/predicate.hpp>
+#include <mutex>
 
 using namespace usml::netcdf;
 
@@ -28,6 +30,7 @@ netcdf_profile::netcdf_profile(const char *profile, double date, double south,
     NcVar *latitude;
     NcVar *longitude;
     NcVar *value;
+    std::lock_guard<std::mutex> lock(netcdf_utils::mutex());
     NcFile pfile(profile);
     if (pfile.is_valid() == 0) {
         throw std::invalid_argument("file not found");
@@ -37,10 +40,11 @@ netcdf_profile::netcdf_profile(const char *profile, double date, double south,
 
     // find the time closest to the specified value
 
+    const auto times = netcdf_utils::read_axis(time);
     long time_index = 0;
-    double old_diff = abs(date - time->as_double(0));
-    for (long t = 1; t < time->num_vals(); ++t) {
-        double diff = abs(date - time->as_double(t));
+    double old_diff = abs(date - times[0]);
+    for (long t = 1; t < long(times.size()); ++t) {
+        double diff = abs(date - times[t]);
         if (old_diff > diff) {
             old_diff = diff;
             time_index = t;
@@ -49,35 +53,35 @@ netcdf_profile::netcdf_profile(const char *profile, double date, double south,
 
     // read altitude axis data from NetCDF variable
 
-    const auto alt_num = long(altitude->num_vals());
+    const auto alts = netcdf_utils::read_axis(altitude);
+    const auto alt_num = long(alts.size());
     vector<double> vect(alt_num);
     for (long d = 0; d < alt_num; ++d) {
-        vect[d] = wposition::earth_radius - abs(altitude->as_double(d));
+        vect[d] = wposition::earth_radius - abs(alts[d]);
     }
     _axis[0] = seq_vector::csptr(new seq_data(vect));
 
     // manage wrap-around between eastern and western hemispheres
 
+    const auto lngs = netcdf_utils::read_axis(longitude);
+    const auto lats = netcdf_utils::read_axis(latitude);
     double offset = 0.0;
     long duplicate = 0;
-    long n = longitude->num_vals() - 1;
+    long n = long(lngs.size()) - 1;
     // Is the data set bounds 0 to 359(360)
-    bool zero_to_360 =
-        longitude->as_double(0) <= 1.0 && longitude->as_double(n) >= 359.0;
+    bool zero_to_360 = lngs[0] <= 1.0 && lngs[n] >= 359.0;
     // Is the data set bounds -180 to 179(180)
-    bool bounds_180 =
-        longitude->as_double(n) >= 179.0 && longitude->as_double(0) == -180.0;
+    bool bounds_180 = lngs[n] >= 179.0 && lngs[0] == -180.0;
     // Is this set a global data set
     bool global = (zero_to_360 || bounds_180);
     if (global) {
         // check to see if database has duplicate data at cut point
-        if (abs(longitude->as_double(0) + 360 - longitude->as_double(n)) <
-            1e-4) {
+        if (abs(lngs[0] + 360 - lngs[n]) < 1e-4) {
             duplicate = 1;
         }
 
         // manage wrap-around between eastern and western hemispheres
-        if (longitude->as_double(0) < 0.0) {
+        if (lngs[0] < 0.0) {
             // if database has a range (-180,180)
             // make western longitudes into negative numbers
             // unless they span the 180 latitude
@@ -92,11 +96,11 @@ netcdf_profile::netcdf_profile(const char *profile, double date, double south,
             }
         }
     } else {
-        if (longitude->as_double(0) > 180.0) {
+        if (lngs[0] > 180.0) {
             if (west < 0.0) {
                 offset = 360.0;
             }
-        } else if (longitude->as_double(0) < 0.0) {
+        } else if (lngs[0] < 0.0) {
             if (east > 180.0) {
                 offset = -360.0;
             }
@@ -110,9 +114,9 @@ netcdf_profile::netcdf_profile(const char *profile, double date, double south,
     // lat_first and lat_last are the integer offsets along this axis
     // _axis[1] is expressed as co-latitude in radians [0,PI]
 
-    double a = latitude->as_double(0);
-    n = latitude->num_vals() - 1;
-    double inc = double(latitude->as_double(n) - a) / double(n);
+    double a = lats[0];
+    n = long(lats.size()) - 1;
+    double inc = double(lats[n] - a) / double(n);
     const long lat_first = max(0L, long(floor(1e-6 + (south - a) / inc)));
     const long lat_last = min(n, long(floor(0.5 + (north - a) / inc)));
     const long lat_num = lat_last - lat_first + 1;
@@ -124,9 +128,9 @@ netcdf_profile::netcdf_profile(const char *profile, double date, double south,
     // lng_first and lng_last are the integer offsets along this axis
     // _axis[2] is expressed as longitude in radians [-PI,2*PI]
 
-    a = longitude->as_double(0);
-    n = long(longitude->num_vals() - 1);
-    inc = double(longitude->as_double(n) - a) / double(n);
+    a = lngs[0];
+    n = long(lngs.size()) - 1;
+    inc = double(lngs[n] - a) / double(n);
     auto index = long(floor(1e-6 + (west - a) / inc));
     const long lng_first = (global) ? index : max(0L, index);
     index = long(floor(0.5 + (east - a) / inc));
@@ -142,51 +146,28 @@ netcdf_profile::netcdf_profile(const char *profile, double date, double south,
     _writeable_data = std::shared_ptr<double[]>(data);
     _data = _writeable_data;
 
-    if (longitude->num_vals() > lng_last) {
-        value->set_cur(time_index, 0, lat_first, lng_first);
-        value->get(data, 1, alt_num, lat_num, lng_num);
+    if (long(lngs.size()) > lng_last) {
+        const long corner[] = {time_index, 0, lat_first, lng_first};
+        const long count[] = {1, alt_num, lat_num, lng_num};
+        netcdf_utils::read_hyperslab(value, corner, count, data);
 
         // support datasets that cross the unwrapping longitude
         // assumes that bathy data is NOT repeated on both sides of cut point
+        // the missing points on the east side of the block are read from
+        // zero, skipping the first longitude if it is a duplicate
 
     } else {
-        long M = lng_last - longitude->num_vals() + 1;  // # pts on east side
-        long N = lng_num - M;                           // # pts on west side
-        double *ptr = data;
-        for (long alt = 0; alt < alt_num; ++alt) {
-            for (long lat = lat_first; lat <= lat_last; ++lat) {
-                // the west side of the block is the portion from
-                // lng_first to the last latitude
-                value->set_cur(time_index, alt, lat, lng_first);
-                value->get(ptr, 1, 1, 1, N);
-                ptr += N;
-
-                // the missing points on the east side of the block
-                // are read from zero until the right # of points are read
-                // skip first longitude if it is a duplicate
-                value->set_cur(time_index, alt, lat, duplicate);
-                value->get(ptr, 1, 1, 1, M);
-                ptr += M;
-            }
-        }
+        const long M = lng_last - long(lngs.size()) + 1;  // # pts on east side
+        const long corner[] = {time_index, 0, lat_first, lng_first};
+        const long count[] = {1, alt_num, lat_num, lng_num};
+        netcdf_utils::read_wrapped(value, corner, count, lng_num - M,
+                                   duplicate, data);
     }
 
     // apply logic for missing, scale_factor, and add_offset
-    if (!std::isnan(missing) || !std::isnan(scale_factor * add_offset)) {
-        const long N = alt_num * lat_num * lng_num;
-        double *ptr = data;
-        while (ptr < data + N) {
-            // NOLINTNEXTLINE(clang-analyzer-core.UndefinedBinaryOperatorResult)
-            if (!std::isnan(missing) && *ptr == missing) {
-                *ptr = NAN;
-            }
-            if (!std::isnan(scale_factor * add_offset)) {
-                // NOLINTNEXTLINE(clang-analyzer-core.UndefinedBinaryOperatorResult)
-                *ptr = *ptr * scale_factor + add_offset;
-            }
-            ++ptr;
-        }
-    }
+
+    netcdf_utils::decode(data, size_t(alt_num * lat_num * lng_num), missing,
+                         scale_factor, add_offset);
 }
 
 /**
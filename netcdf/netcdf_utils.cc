@@ -0,0 +1,95 @@
+/**
+ * @file netcdf_utils.cc
+ * Bulk read utilities shared by the NetCDF file readers.
+ */
+#include <usml/netcdf/netcdf_utils.h>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace usml::netcdf;
+
+/** Mutex that serializes access to the NetCDF library. */
+std::mutex netcdf_utils::_mutex;
+
+/**
+ * Read all of the values of a 1-D variable with a single call.
+ */
+std::vector<double> netcdf_utils::read_axis(NcVar* var) {
+    std::vector<double> values(var->num_vals());
+    var->set_cur(0L);
+    if (var->get(values.data(), var->num_vals()) == 0) {
+        throw std::invalid_argument("unable to read NetCDF variable");
+    }
+    return values;
+}
+
+/**
+ * Read a hyperslab with a single call.
+ */
+void netcdf_utils::read_hyperslab(NcVar* var, const long* corner,
+                                  const long* count, double* data) {
+    std::vector<long> cur(corner, corner + var->num_dims());
+    if (var->set_cur(cur.data()) == 0 || var->get(data, count) == 0) {
+        throw std::invalid_argument("unable to read NetCDF variable");
+    }
+}
+
+/**
+ * Read a hyperslab whose last dimension wraps around the end of the
+ * variable.
+ */
+void netcdf_utils::read_wrapped(NcVar* var, const long* corner,
+                                const long* count, long west_count,
+                                long east_first, double* data) {
+    const int ndims = var->num_dims();
+    const int last = ndims - 1;
+    const long east_count = count[last] - west_count;
+    long rows = 1;
+    for (int n = 0; n < last; ++n) {
+        rows *= count[n];
+    }
+
+    // read each side of the region with a single call
+
+    std::vector<long> cur(corner, corner + ndims);
+    std::vector<long> edges(count, count + ndims);
+    std::vector<double> west(rows * west_count);
+    std::vector<double> east(rows * east_count);
+
+    edges[last] = west_count;
+    read_hyperslab(var, cur.data(), edges.data(), west.data());
+
+    cur[last] = east_first;
+    edges[last] = east_count;
+    read_hyperslab(var, cur.data(), edges.data(), east.data());
+
+    // interleave the west and east sides of each row
+
+    const double* w = west.data();
+    const double* e = east.data();
+    for (long r = 0; r < rows; ++r) {
+        data = std::copy_n(w, west_count, data);
+        data = std::copy_n(e, east_count, data);
+        w += west_count;
+        e += east_count;
+    }
+}
+
+/**
+ * Replace missing values with NaN, and unpack scaled values.
+ */
+void netcdf_utils::decode(double* data, size_t num, double missing,
+                          double scale, double offset) {
+    if (!std::isnan(missing)) {
+        for (size_t n = 0; n < num; ++n) {
+            data[n] = (data[n] == missing) ? NAN : data[n];
+        }
+    }
+    if (!std::isnan(scale * offset)) {
+        for (size_t n = 0; n < num; ++n) {
+            data[n] = data[n] * scale + offset;
+        }
+    }
+}
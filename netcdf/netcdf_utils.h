@@ -0,0 +1,114 @@
+/**
+ * @file netcdf_utils.h
+ * Bulk read utilities shared by the NetCDF file readers.
+ */
+#pragma once
+
+#include <netcdfcpp.h>
+#include <usml/usml_config.h>
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace usml {
+namespace netcdf {
+
+/// @ingroup netcdf_files
+/// @{
+
+/**
+ * Bulk read utilities shared by the NetCDF file readers. The legacy NetCDF
+ * C++ API re-reads the whole variable each time that as_double() is invoked,
+ * and reading a region one row at a time is dominated by per-call overhead.
+ * These utilities read each axis and each hyperslab with a single call, in
+ * the on-disk order of the variable, so that large regions load at disk
+ * bandwidth.
+ *
+ * The NetCDF library is not thread safe. Readers lock mutex() while they
+ * access their files, so that independent variables, like temperature and
+ * salinity, can be loaded from separate threads. The netcdf_bathy,
+ * netcdf_profile, and reflect_loss_netcdf readers, the eigenverb reader,
+ * and the write_netcdf() writers hold the lock while their files are open.
+ * The wave_queue holds it for each access to its wavefront log.
+ * The netcdf_coards reader holds it while reading from a file that its
+ * caller has opened, so the caller must serialize its own NcFile
+ * construction. Only the library calls are serialized; post-processing
+ * like netcdf_profile::fill_missing() runs concurrently.
+ */
+class USML_DECLSPEC netcdf_utils {
+   public:
+    // Hide constructor.
+    netcdf_utils() = delete;
+
+    /**
+     * Mutex that serializes access to the NetCDF library.
+     */
+    static std::mutex& mutex() { return _mutex; }
+
+    /**
+     * Read all of the values of a 1-D variable with a single call.
+     *
+     * @param  var      NetCDF variable for the axis.
+     * @return          Axis values converted to double precision.
+     */
+    static std::vector<double> read_axis(NcVar* var);
+
+    /**
+     * Read a hyperslab with a single call.
+     *
+     * @param  var      NetCDF variable to read.
+     * @param  corner   First index in each dimension.
+     * @param  count    Number of values in each dimension.
+     * @param  data     Output buffer, sized for the product of count.
+     * @throws invalid_argument if the NetCDF library can not read the
+     *                  hyperslab.
+     */
+    static void read_hyperslab(NcVar* var, const long* corner,
+                               const long* count, double* data);
+
+    /**
+     * Read a hyperslab whose last dimension wraps around the end of the
+     * variable, as happens for a global longitude axis. The west side of
+     * the region is read from corner to the end of the variable, and the
+     * east side is read starting from east_first. Each side is read with
+     * a single call, and the two sides are interleaved in memory afterwards.
+     *
+     * @param  var          NetCDF variable to read.
+     * @param  corner       First index in each dimension.
+     * @param  count        Number of values in each dimension, including
+     *                      both sides of the last dimension.
+     * @param  west_count   Number of values in the last dimension that
+     *                      are read from the west side of the region.
+     * @param  east_first   Index in last dimension at which the east side
+     *                      of the region starts.
+     * @param  data         Output buffer, sized for the product of count.
+     * @throws invalid_argument if the NetCDF library can not read either
+     *                      side of the region.
+     */
+    static void read_wrapped(NcVar* var, const long* corner,
+                             const long* count, long west_count,
+                             long east_first, double* data);
+
+    /**
+     * Replace missing values with NaN, and unpack scaled values. Each step
+     * is a separate branch-free pass over the data, so that the compiler
+     * can vectorize it.
+     *
+     * @param  data     Data to be decoded in place.
+     * @param  num      Number of values in the data.
+     * @param  missing  Value used to indicate missing data, or NaN if none.
+     * @param  scale    Value used to scale packed values, or NaN if none.
+     * @param  offset   Value used to offset packed values, or NaN if none.
+     */
+    static void decode(double* data, size_t num, double missing, double scale,
+                       double offset);
+
+   private:
+    /// Mutex that serializes access to the NetCDF library.
+    static std::mutex _mutex;
+};
+
+/// @}
+}  // end of namespace netcdf
+}  // end of namespace usml
@@ -0,0 +1,137 @@
+/**
+ * @example netcdf/test/columnar_test.cc
+ */
+#include <usml/netcdf/netcdf_files.h>
+
+#include <boost/test/unit_test.hpp>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(columnar_test)
+
+using namespace boost::unit_test;
+using namespace usml::netcdf;
+
+/**
+ * @ingroup netcdf_test
+ * @{
+ */
+
+/**
+ * Writes scalars, vectors, and matrices of each supported type to a columnar
+ * file on the background I/O thread, then reads them back and checks that
+ * the names, units, types, shapes, and values are unchanged. Also checks
+ * that a missing file throws an exception instead of producing empty data.
+ */
+BOOST_AUTO_TEST_CASE(columnar_round_trip) {
+    cout << "=== columnar_test: columnar_round_trip ===" << endl;
+    const char* filename = USML_TEST_DIR "/netcdf/test/columnar_round_trip.col";
+
+    const std::vector<double> travel_time = {0.1, 0.2, 0.3};
+    const std::vector<int16_t> bottom = {0, 1, 2};
+    const double intensity[2][3] = {{-10.0, -20.0, -30.0},
+                                    {-40.0, -50.0, -60.0}};
+
+    columnar_file file;
+    file.attribute("long_name", "round trip");
+    file.add("sourceID", "count", (int64_t)42);
+    file.add("travel_time", "seconds", travel_time);
+    file.add("bottom", "count", bottom);
+    file.add("intensity", "dB", {2, 3}, &intensity[0][0]);
+    file.add("empty", "meters", std::vector<float>());
+
+    columnar_writer::instance()->write(filename, std::move(file));
+    columnar_writer::instance()->flush();
+    BOOST_CHECK_EQUAL(columnar_writer::instance()->num_pending(), 0);
+    BOOST_CHECK_EQUAL(columnar_writer::instance()->num_errors(), 0);
+
+    // read file back and compare to original
+
+    columnar_file copy = columnar_file::read(filename);
+    BOOST_CHECK_EQUAL(copy.attributes().at("long_name"), "round trip");
+    BOOST_CHECK_EQUAL(copy.columns().size(), 5);
+
+    const auto* id = copy.find("sourceID");
+    BOOST_REQUIRE(id != nullptr);
+    BOOST_CHECK_EQUAL(id->dtype, "<i8");
+    BOOST_CHECK(id->shape.empty());
+    int64_t id_value;
+    std::memcpy(&id_value, id->data.data(), sizeof(id_value));
+    BOOST_CHECK_EQUAL(id_value, 42);
+
+    const auto* time = copy.find("travel_time");
+    BOOST_REQUIRE(time != nullptr);
+    BOOST_CHECK_EQUAL(time->units, "seconds");
+    BOOST_CHECK_EQUAL(time->dtype, "<f8");
+    BOOST_REQUIRE_EQUAL(time->shape.size(), 1);
+    BOOST_CHECK_EQUAL(time->shape[0], 3);
+    const auto* time_data = (const double*)time->data.data();
+    for (size_t n = 0; n < travel_time.size(); ++n) {
+        BOOST_CHECK_EQUAL(time_data[n], travel_time[n]);
+    }
+
+    const auto* bot = copy.find("bottom");
+    BOOST_REQUIRE(bot != nullptr);
+    BOOST_CHECK_EQUAL(bot->dtype, "<i2");
+    const auto* bot_data = (const int16_t*)bot->data.data();
+    for (size_t n = 0; n < bottom.size(); ++n) {
+        BOOST_CHECK_EQUAL(bot_data[n], bottom[n]);
+    }
+
+    const auto* loss = copy.find("intensity");
+    BOOST_REQUIRE(loss != nullptr);
+    BOOST_REQUIRE_EQUAL(loss->shape.size(), 2);
+    BOOST_CHECK_EQUAL(loss->shape[0], 2);
+    BOOST_CHECK_EQUAL(loss->shape[1], 3);
+    const auto* loss_data = (const double*)loss->data.data();
+    for (size_t r = 0; r < 2; ++r) {
+        for (size_t c = 0; c < 3; ++c) {
+            BOOST_CHECK_EQUAL(loss_data[r * 3 + c], intensity[r][c]);
+        }
+    }
+
+    const auto* empty = copy.find("empty");
+    BOOST_REQUIRE(empty != nullptr);
+    BOOST_CHECK_EQUAL(empty->dtype, "<f4");
+    BOOST_CHECK(empty->data.empty());
+    BOOST_CHECK(copy.find("missing") == nullptr);
+
+    BOOST_CHECK_THROW(
+        columnar_file::read(USML_TEST_DIR "/netcdf/test/missing.col"),
+        std::runtime_error);
+}
+
+/**
+ * Checks that column data is stored in little-endian order, as documented
+ * for the Python reader, regardless of the byte order of this computer.
+ * Writes a single integer, which is the last thing in the file, and
+ * checks its bytes on disk.
+ */
+BOOST_AUTO_TEST_CASE(columnar_byte_order) {
+    cout << "=== columnar_test: columnar_byte_order ===" << endl;
+    const char* filename = USML_TEST_DIR "/netcdf/test/columnar_byte_order.col";
+
+    columnar_file file;
+    file.add("value", "count", (int64_t)0x0102030405060708);
+    file.write(filename);
+
+    std::ifstream stream(filename, std::ios::binary);
+    stream.seekg(-8, std::ios::end);
+    unsigned char bytes[8];
+    BOOST_REQUIRE(stream.read((char*)bytes, sizeof(bytes)));
+    for (size_t n = 0; n < sizeof(bytes); ++n) {
+        BOOST_CHECK_EQUAL((int)bytes[n], 8 - (int)n);
+    }
+
+    columnar_file copy = columnar_file::read(filename);
+    int64_t value;
+    std::memcpy(&value, copy.find("value")->data.data(), sizeof(value));
+    BOOST_CHECK_EQUAL(value, 0x0102030405060708);
+}
+
+/// @}
+
+BOOST_AUTO_TEST_SUITE_END()
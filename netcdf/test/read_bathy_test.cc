@@ -6,6 +6,7 @@
 #include <boost/test/unit_test.hpp>
 #include <fstream>
 #include <iostream>
+#include <vector>
 
 BOOST_AUTO_TEST_SUITE(read_bathy_test)
 
@@ -376,6 +377,49 @@ BOOST_AUTO_TEST_CASE(nonglobal_database) {
     BOOST_CHECK_CLOSE(lng2, -74.0, 1e-6);
 }
 
+/**
+ * Tests the bulk read of a hyperslab that does not wrap around the
+ * longitude axis. Reads a block from the middle of the flstrts_bathymetry.nc
+ * depth variable with netcdf_utils::read_hyperslab(), and compares it to the
+ * same values read one at a time. Also checks that a block that extends
+ * past the end of the variable throws an exception instead of returning
+ * uninitialized data.
+ */
+BOOST_AUTO_TEST_CASE(read_hyperslab) {
+    cout << "=== read_bathy_test: read_hyperslab ===" << endl;
+    NcError nc_error(NcError::silent_nonfatal);
+    NcFile file(USML_TEST_DIR "/netcdf/test/flstrts_bathymetry.nc");
+    BOOST_REQUIRE(file.is_valid());
+    NcVar* depth = nullptr;
+    for (int n = 0; n < file.num_vars(); ++n) {
+        if (file.get_var(n)->num_dims() == 2) {
+            depth = file.get_var(n);
+        }
+    }
+    BOOST_REQUIRE(depth != nullptr);
+    const long num_lng = depth->get_dim(1)->size();
+
+    const long corner[] = {100, 200};
+    const long count[] = {5, 7};
+    std::vector<double> data(count[0] * count[1]);
+    netcdf_utils::read_hyperslab(depth, corner, count, data.data());
+
+    NcValues* values = depth->values();
+    for (long r = 0; r < count[0]; ++r) {
+        for (long c = 0; c < count[1]; ++c) {
+            const long index = (corner[0] + r) * num_lng + corner[1] + c;
+            BOOST_CHECK_EQUAL(data[r * count[1] + c],
+                              values->as_double(index));
+        }
+    }
+    delete values;
+
+    const long past_end[] = {100, num_lng - 3};
+    BOOST_CHECK_THROW(
+        netcdf_utils::read_hyperslab(depth, past_end, count, data.data()),
+        std::invalid_argument);
+}
+
 /**
  * Test for issue #114 - data_grid linear interpolation produces unpredictable
  * results in Win64 release builds.  When running usml_test using a Win x64
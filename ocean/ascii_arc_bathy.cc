@@ -4,19 +4,61 @@
  */
 
 #include <usml/ocean/ascii_arc_bathy.h>
+#include <usml/ocean/ascii_reader.h>
 #include <usml/types/seq_linear.h>
 #include <usml/types/seq_vector.h>
 #include <usml/types/wposition.h>
 #include <usml/ublas/math_traits.h>
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
-#include <iostream>
 #include <memory>
+#include <string>
+#include <system_error>
+#include <vector>
 
 using namespace usml::ocean;
 using namespace usml::types;
 
+/** Identifier at the start of each binary sidecar file. */
+static const char sidecar_magic[8] = "USMLARC";
+
+/** Version number written to each binary sidecar file. */
+static const uint32_t sidecar_version = 2;
+
+/**
+ * True if this computer stores numbers in little-endian order.
+ */
+static bool little_endian() {
+    const uint16_t one = 1;
+    char first;
+    std::memcpy(&first, &one, 1);
+    return first == 1;
+}
+
+/**
+ * Convert an array of numbers between native and little-endian order,
+ * in place. Does nothing on little-endian computers.
+ */
+template <class T>
+static void to_little_endian(T* values, size_t num) {
+    if (little_endian()) {
+        return;
+    }
+    for (size_t n = 0; n < num; ++n) {
+        auto* bytes = (char*)(values + n);
+        std::reverse(bytes, bytes + sizeof(T));
+    }
+}
+
+/** Minimum size of an ASCII file that gets a binary sidecar (bytes). */
+size_t ascii_arc_bathy::sidecar_size = 16 * 1024 * 1024;
+
 /**
  * Load bathymetry from disk.
  */
@@ -26,21 +68,49 @@ ascii_arc_bathy::ascii_arc_bathy(const char* filename) {
     double xllcorner;
     double yllcorner;
     double cellsize;
-    double nodata_value;
-    static char label[80];
     const auto R = (double)wposition::earth_radius;
+    const std::string sidecar = sidecar_name(filename);
+    double* data = nullptr;
+
+    // use the binary sidecar if it is newer than the ASCII file
+
+    if (!read_sidecar(filename, sidecar, &ncols, &nrows, &xllcorner,
+                      &yllcorner, &cellsize, &data)) {
+        ascii_reader reader(filename);
+        const char* ptr = reader.begin();
+        std::string label;
+        double value;
 
-    std::ifstream fi(filename);
-    fi >> std::skipws;
+        // read the file header
 
-    // read the file header
+        ptr = reader.read(ptr, &label);
+        ptr = reader.read(ptr, &value);
+        ncols = (size_t)value;
+        ptr = reader.read(ptr, &label);
+        ptr = reader.read(ptr, &value);
+        nrows = (size_t)value;
+        ptr = reader.read(ptr, &label);
+        ptr = reader.read(ptr, &xllcorner);
+        ptr = reader.read(ptr, &label);
+        ptr = reader.read(ptr, &yllcorner);
+        ptr = reader.read(ptr, &label);
+        ptr = reader.read(ptr, &cellsize);
+        ptr = reader.read(ptr, &label);
+        ptr = reader.read(ptr, &value);  // nodata_value
 
-    fi >> label >> ncols;
-    fi >> label >> nrows;
-    fi >> label >> xllcorner;
-    fi >> label >> yllcorner;
-    fi >> label >> cellsize;
-    fi >> label >> nodata_value;
+        // read depths, rows are stored from north to south
+
+        data = new double[ncols * nrows];
+        this->_writeable_data = std::shared_ptr<double[]>(data);
+        reader.read(ptr, data, ncols * nrows);
+        if (reader.size() >= sidecar_size) {
+            write_sidecar(sidecar, ncols, nrows, xllcorner, yllcorner,
+                          cellsize, data);
+        }
+    } else {
+        this->_writeable_data = std::shared_ptr<double[]>(data);
+    }
+    this->_data = this->_writeable_data;  // read only reference
 
     // construct latitude and longitude axes in spherical coordinates
     // note that axis[0] starts in the south and moves north
@@ -51,19 +121,12 @@ ascii_arc_bathy::ascii_arc_bathy(const char* filename) {
     this->_axis[1] = seq_vector::csptr(
         new seq_linear(to_radians(xllcorner), to_radians(cellsize), ncols));
 
-    // read depths and convert to rho coordinate of spherical earth system
-    // flip latitude direction upside down during the read.
+    // convert depths to rho coordinate of spherical earth system
 
-    auto* data = new double[ncols * nrows];
-    for (int r = 0; r < nrows; ++r) {
-        double* ptr = &(data[r * ncols]);
-        for (int c = 0; c < ncols; ++c) {
-            fi >> *ptr;
-            *(ptr++) += R;
-        }
+    const size_t N = ncols * nrows;
+    for (size_t n = 0; n < N; ++n) {
+        data[n] += R;
     }
-    this->_writeable_data = std::shared_ptr<double[]>(data);
-    this->_data = this->_writeable_data;  // read only reference
 
     // set interp type and edge limit
 
@@ -72,3 +135,118 @@ ascii_arc_bathy::ascii_arc_bathy(const char* filename) {
         this->_edge_limit[n] = true;
     }
 }
+
+/**
+ * Name of the binary sidecar for an ASCII file.
+ */
+std::string ascii_arc_bathy::sidecar_name(const char* filename) {
+    return std::string(filename) + ".cache";
+}
+
+/**
+ * Read the header and depths from the binary sidecar.
+ */
+bool ascii_arc_bathy::read_sidecar(const char* filename,
+                                   const std::string& sidecar, size_t* ncols,
+                                   size_t* nrows, double* xllcorner,
+                                   double* yllcorner, double* cellsize,
+                                   double** data) {
+    namespace fs = std::filesystem;
+    std::error_code error;
+    const auto source_time = fs::last_write_time(filename, error);
+    if (error) {
+        return false;
+    }
+    const auto sidecar_time = fs::last_write_time(sidecar, error);
+    if (error || sidecar_time < source_time) {
+        return false;
+    }
+
+    // map the sidecar and validate its layout
+
+    std::unique_ptr<ascii_reader> mapping;
+    try {
+        mapping = std::make_unique<ascii_reader>(sidecar.c_str());
+    } catch (const std::invalid_argument&) {
+        return false;
+    }
+    const ascii_reader& reader = *mapping;
+    const char* ptr = reader.begin();
+    const size_t header_size = sizeof(sidecar_magic) + 2 * sizeof(uint32_t) +
+                               2 * sizeof(uint64_t) + 3 * sizeof(double);
+    if (reader.size() < header_size ||
+        std::memcmp(ptr, sidecar_magic, sizeof(sidecar_magic)) != 0) {
+        return false;
+    }
+    ptr += sizeof(sidecar_magic);
+    uint32_t version[2];
+    uint64_t num[2];
+    double corner[3];
+    std::memcpy(version, ptr, sizeof(version));
+    ptr += sizeof(version);
+    std::memcpy(num, ptr, sizeof(num));
+    ptr += sizeof(num);
+    std::memcpy(corner, ptr, sizeof(corner));
+    ptr += sizeof(corner);
+    to_little_endian(version, 2);
+    to_little_endian(num, 2);
+    to_little_endian(corner, 3);
+    if (version[0] != sidecar_version ||
+        reader.size() != header_size + sizeof(double) * num[0] * num[1]) {
+        return false;
+    }
+
+    // copy depths out of the mapping
+
+    *ncols = num[0];
+    *nrows = num[1];
+    *xllcorner = corner[0];
+    *yllcorner = corner[1];
+    *cellsize = corner[2];
+    *data = new double[num[0] * num[1]];
+    std::memcpy(*data, ptr, sizeof(double) * num[0] * num[1]);
+    to_little_endian(*data, num[0] * num[1]);
+    return true;
+}
+
+/**
+ * Write the header and depths to the binary sidecar.
+ */
+void ascii_arc_bathy::write_sidecar(const std::string& sidecar, size_t ncols,
+                                    size_t nrows, double xllcorner,
+                                    double yllcorner, double cellsize,
+                                    const double* data) {
+    const std::string temp = sidecar + ".tmp";
+    {
+        std::ofstream stream(temp, std::ios::binary | std::ios::trunc);
+        if (!stream) {
+            return;  // directory is read-only, skip the sidecar
+        }
+        uint32_t version[2] = {sidecar_version, 0};
+        uint64_t num[2] = {ncols, nrows};
+        double corner[3] = {xllcorner, yllcorner, cellsize};
+        to_little_endian(version, 2);
+        to_little_endian(num, 2);
+        to_little_endian(corner, 3);
+        stream.write(sidecar_magic, sizeof(sidecar_magic));
+        stream.write((const char*)version, sizeof(version));
+        stream.write((const char*)num, sizeof(num));
+        stream.write((const char*)corner, sizeof(corner));
+        if (little_endian()) {
+            stream.write((const char*)data,
+                         (std::streamsize)(sizeof(double) * ncols * nrows));
+        } else {
+            std::vector<double> swapped(data, data + ncols * nrows);
+            to_little_endian(swapped.data(), swapped.size());
+            stream.write((const char*)swapped.data(),
+                         (std::streamsize)(sizeof(double) * swapped.size()));
+        }
+        if (!stream) {
+            stream.close();
+            std::remove(temp.c_str());
+            return;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(temp, sidecar, error);
+}
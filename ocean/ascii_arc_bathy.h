@@ -7,6 +7,9 @@
 #include <usml/types/gen_grid.h>
 #include <usml/usml_config.h>
 
+#include <cstddef>
+#include <string>
+
 namespace usml {
 namespace ocean {
 
@@ -58,6 +61,60 @@ class USML_DECLSPEC ascii_arc_bathy : public gen_grid<2> {
      *
      */
     ascii_arc_bathy(const char* filename);
+
+    /// Minimum size of an ASCII file that gets a binary sidecar (bytes).
+    static size_t sidecar_size;
+
+    /**
+     * Name of the binary sidecar for an ASCII file.
+     *
+     * @param  filename     Name of the ASCII ARC file.
+     * @return              Name of the binary sidecar.
+     */
+    static std::string sidecar_name(const char* filename);
+
+   private:
+    /**
+     * Read the header and depths from the binary sidecar.
+     *
+     * @param  filename     Name of the ASCII ARC file.
+     * @param  sidecar      Name of the binary sidecar.
+     * @param  ncols        Number of longitudes (output).
+     * @param  nrows        Number of latitudes (output).
+     * @param  xllcorner    Western longitude (output).
+     * @param  yllcorner    Southern latitude (output).
+     * @param  cellsize     Spacing between grid points (output).
+     * @param  data         Newly allocated depths (output).
+     * @return              False if sidecar is missing, stale, invalid,
+     *                      or written with a different version.
+     */
+    static bool read_sidecar(const char* filename, const std::string& sidecar,
+                             size_t* ncols, size_t* nrows, double* xllcorner,
+                             double* yllcorner, double* cellsize,
+                             double** data);
+
+    /**
+     * Write the header and depths to the binary sidecar. Writes to a
+     * temporary file first, so that other processes never see a
+     * partial sidecar. The sidecar starts with the identifier "USMLARC"
+     * and a null, followed by a 32 bit version number, 32 reserved bits,
+     * the number of columns and rows as 64 bit unsigned integers, and
+     * the corner and cell size as 64 bit floating point numbers. All
+     * numbers are little-endian, so that sidecars in shared data
+     * directories can be read on any computer.
+     *
+     * @param  sidecar      Name of the binary sidecar.
+     * @param  ncols        Number of longitudes.
+     * @param  nrows        Number of latitudes.
+     * @param  xllcorner    Western longitude.
+     * @param  yllcorner    Southern latitude.
+     * @param  cellsize     Spacing between grid points.
+     * @param  data         Depths in file order.
+     */
+    static void write_sidecar(const std::string& sidecar, size_t ncols,
+                              size_t nrows, double xllcorner,
+                              double yllcorner, double cellsize,
+                              const double* data);
 };
 
 /// @}
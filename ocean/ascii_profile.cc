@@ -4,16 +4,15 @@
  */
 
 #include <usml/ocean/ascii_profile.h>
+#include <usml/ocean/ascii_reader.h>
 #include <usml/types/seq_data.h>
 #include <usml/types/seq_vector.h>
 #include <usml/types/wposition.h>
 
-#include <cctype>
 #include <cstddef>
-#include <fstream>
-#include <iostream>
 #include <memory>
-#include <string>
+#include <stdexcept>
+#include <vector>
 
 using namespace usml::ocean;
 
@@ -21,34 +20,26 @@ using namespace usml::ocean;
  * Read a 1-D profile from a text file.
  */
 ascii_profile::ascii_profile(const char *filename) {
-    // count the number of lines in the input file
-
-    std::ifstream infile(filename);
-    size_t size = 0;
-    std::string line;
-    while (getline(infile, line)) {
-        ++size;
+    // read depth and speed pairs from input file
+
+    ascii_reader reader(filename);
+    std::vector<double> values;
+    values.reserve(reader.size() / 8);
+    const char *ptr = reader.skip(reader.begin());
+    while (ptr < reader.end()) {
+        double value;
+        ptr = reader.skip(reader.read(ptr, &value));
+        values.push_back(value);
     }
-    infile.clear();
-    infile.seekg(0);
-
-    // read data from input file
-
-    double depth;
+    if (values.size() % 2 != 0) {
+        throw std::invalid_argument("depth without a matching speed");
+    }
+    const size_t size = values.size() / 2;
     auto *height = new double[size];
     auto *speed = new double[size];
-    int c;
     for (size_t n = 0; n < size; ++n) {
-        infile >> depth;
-        while (true) {  // skip comma and space delimiters
-            c = infile.peek();
-            if (c != ',' && (isspace(c) == 0)) {
-                break;
-            }
-            infile.get();
-        }
-        infile >> speed[n];
-        height[n] = wposition::earth_radius - depth;
+        height[n] = wposition::earth_radius - values[2 * n];
+        speed[n] = values[2 * n + 1];
     }
 
     // load into data_grid variables
@@ -25,6 +25,8 @@ class USML_DECLSPEC ascii_profile : public gen_grid<1> {
      * Read a 1-D profile from a file.
      *
      * @param filename  File to be named.
+     * @throws std::invalid_argument if the file does not contain an even
+     *                  number of values.
      */
     ascii_profile(const char* filename);
 };
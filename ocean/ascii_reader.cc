@@ -0,0 +1,227 @@
+/**
+ * @file ascii_reader.cc
+ * Fast reader for numeric text files.
+ */
+
+#include <usml/ocean/ascii_reader.h>
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace usml::ocean;
+
+namespace {
+
+/**
+ * True if this character separates numbers in the file.
+ */
+inline bool is_delimiter(char c) {
+    return c == ' ' || c == ',' || c == '\n' || c == '\r' || c == '\t' ||
+           c == '\v' || c == '\f';
+}
+
+}  // namespace
+
+/** Minimum number of values needed to read a block in parallel. */
+size_t ascii_reader::min_parallel_size = 1000000;
+
+/**
+ * Map a text file into memory.
+ */
+ascii_reader::ascii_reader(const char* filename) {
+#ifndef _WIN32
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        throw std::invalid_argument("file not found");
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        throw std::invalid_argument("file not found");
+    }
+    _size = (size_t)info.st_size;
+    if (_size == 0) {
+        close(fd);
+        _buffer = std::shared_ptr<const char[]>(new char[1]);
+        return;
+    }
+    void* addr = mmap(nullptr, _size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);  // mapping remains valid after file is closed
+    if (addr == MAP_FAILED) {
+        throw std::invalid_argument("unable to map file");
+    }
+    const size_t size = _size;
+    _buffer = std::shared_ptr<const char[]>(
+        (const char*)addr,
+        [size](const char* ptr) { munmap((void*)ptr, size); });
+#else
+    std::ifstream stream(filename, std::ios::binary | std::ios::ate);
+    if (!stream) {
+        throw std::invalid_argument("file not found");
+    }
+    _size = (size_t)stream.tellg();
+    std::shared_ptr<char[]> buffer(new char[_size + 1]);
+    stream.seekg(0);
+    stream.read(buffer.get(), (std::streamsize)_size);
+    _buffer = buffer;
+#endif
+}
+
+/**
+ * Skip white space and comma delimiters.
+ */
+const char* ascii_reader::skip(const char* ptr) const {
+    const char* last = end();
+    while (ptr < last && is_delimiter(*ptr)) {
+        ++ptr;
+    }
+    return ptr;
+}
+
+/**
+ * Read the next word from the file.
+ */
+const char* ascii_reader::read(const char* ptr, std::string* word) const {
+    ptr = skip(ptr);
+    const char* first = ptr;
+    const char* last = end();
+    while (ptr < last && !is_delimiter(*ptr)) {
+        ++ptr;
+    }
+    word->assign(first, ptr);
+    return ptr;
+}
+
+/**
+ * Read the next number from the file.
+ */
+const char* ascii_reader::read(const char* ptr, double* value) const {
+    ptr = skip(ptr);
+    if (ptr < end() && *ptr == '+') {
+        ++ptr;
+    }
+    auto result = std::from_chars(ptr, end(), *value);
+    if (result.ec != std::errc()) {
+        throw std::invalid_argument("unrecognized file type");
+    }
+    return result.ptr;
+}
+
+/**
+ * Read a block of numbers from the file, and add an offset to each one.
+ */
+void ascii_reader::read(const char* ptr, double* values, size_t num,
+                        double offset) const {
+    size_t num_threads = std::thread::hardware_concurrency();
+    if (num < min_parallel_size || num_threads < 2) {
+        if (parse(ptr, end(), values, num, offset) < num) {
+            throw std::invalid_argument("unrecognized file type");
+        }
+        return;
+    }
+
+    // split the block into pieces that start and end on delimiters
+
+    const char* last = end();
+    const size_t length = last - ptr;
+    std::vector<const char*> bounds(num_threads + 1, last);
+    bounds[0] = ptr;
+    for (size_t n = 1; n < num_threads; ++n) {
+        const char* b =
+            std::max(bounds[n - 1], ptr + n * length / num_threads);
+        while (b < last && !is_delimiter(*b)) {
+            ++b;
+        }
+        bounds[n] = b;
+    }
+
+    // count the numbers in each piece, to find where its values belong
+
+    std::vector<size_t> first(num_threads + 1, 0);
+    std::vector<std::thread> workers;
+    for (size_t n = 0; n < num_threads; ++n) {
+        workers.emplace_back([&, n]() {
+            size_t count = 0;
+            bool in_word = false;
+            for (const char* p = bounds[n]; p < bounds[n + 1]; ++p) {
+                const bool word = !is_delimiter(*p);
+                count += (word && !in_word) ? 1 : 0;
+                in_word = word;
+            }
+            first[n + 1] = count;
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    for (size_t n = 0; n < num_threads; ++n) {
+        first[n + 1] += first[n];
+    }
+    if (first[num_threads] < num) {
+        throw std::invalid_argument("unrecognized file type");
+    }
+
+    // parse each piece directly into its part of the output
+
+    workers.clear();
+    std::vector<char> valid(num_threads, 1);
+    for (size_t n = 0; n < num_threads; ++n) {
+        if (first[n] >= num) {
+            break;
+        }
+        workers.emplace_back([&, n]() {
+            const size_t max_num = std::min(first[n + 1], num) - first[n];
+            try {
+                valid[n] = char(parse(bounds[n], bounds[n + 1],
+                                      values + first[n], max_num,
+                                      offset) == max_num);
+            } catch (const std::invalid_argument&) {
+                valid[n] = 0;
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    if (std::find(valid.begin(), valid.end(), 0) != valid.end()) {
+        throw std::invalid_argument("unrecognized file type");
+    }
+}
+
+/**
+ * Parse all of the numbers in a range of characters.
+ */
+size_t ascii_reader::parse(const char* ptr, const char* last, double* values,
+                           size_t max_num, double offset) const {
+    size_t count = 0;
+    while (count < max_num) {
+        while (ptr < last && is_delimiter(*ptr)) {
+            ++ptr;
+        }
+        if (ptr >= last) {
+            break;
+        }
+        if (*ptr == '+') {
+            ++ptr;
+        }
+        auto result = std::from_chars(ptr, last, values[count]);
+        if (result.ec != std::errc()) {
+            throw std::invalid_argument("unrecognized file type");
+        }
+        values[count++] += offset;
+        ptr = result.ptr;
+    }
+    return count;
+}
@@ -0,0 +1,122 @@
+/**
+ * @file ascii_reader.h
+ * Fast reader for numeric text files.
+ */
+#pragma once
+
+#include <usml/usml_config.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace usml {
+namespace ocean {
+
+/// @ingroup boundaries
+/// @{
+
+/**
+ * Fast reader for numeric text files, like ASCII ARC bathymetry and CSV
+ * profiles. The whole file is mapped into memory, and numbers are parsed
+ * directly from that memory using std::from_chars(), which avoids the
+ * locale and virtual call overhead of std::istream. Large blocks of numbers
+ * are split at delimiters, and the pieces are parsed in separate threads.
+ *
+ * Numbers may be separated by any combination of white space and commas.
+ * On platforms without POSIX mmap(), the file is read into memory instead.
+ */
+class USML_DECLSPEC ascii_reader {
+   public:
+    /**
+     * Map a text file into memory.
+     *
+     * @param  filename     Name of the file to read.
+     * @throws std::invalid_argument if the file can not be opened.
+     */
+    ascii_reader(const char* filename);
+
+    /**
+     * Pointer to the first character in the file.
+     */
+    const char* begin() const { return _buffer.get(); }
+
+    /**
+     * Pointer to one past the last character in the file.
+     */
+    const char* end() const { return _buffer.get() + _size; }
+
+    /**
+     * Number of characters in the file.
+     */
+    size_t size() const { return _size; }
+
+    /**
+     * Skip white space and comma delimiters.
+     *
+     * @param  ptr      Current position in the file.
+     * @return          Position of the next non-delimiter, or end().
+     */
+    const char* skip(const char* ptr) const;
+
+    /**
+     * Read the next word from the file.
+     *
+     * @param  ptr      Current position in the file.
+     * @param  word     Word that was read (output).
+     * @return          Position after the word.
+     */
+    const char* read(const char* ptr, std::string* word) const;
+
+    /**
+     * Read the next number from the file.
+     *
+     * @param  ptr      Current position in the file.
+     * @param  value    Number that was read (output).
+     * @return          Position after the number.
+     * @throws std::invalid_argument if the next word is not a number.
+     */
+    const char* read(const char* ptr, double* value) const;
+
+    /**
+     * Read a block of numbers from the file, and add an offset to each one.
+     * Blocks with more than min_parallel_size values are split into
+     * pieces that are parsed in separate threads.
+     *
+     * @param  ptr      Current position in the file.
+     * @param  values   Numbers that were read (output).
+     * @param  num      Number of values to read.
+     * @param  offset   Offset added to each value.
+     * @throws std::invalid_argument if the file has less than num values.
+     */
+    void read(const char* ptr, double* values, size_t num,
+              double offset = 0.0) const;
+
+    /// Minimum number of values needed to read a block in parallel.
+    static size_t min_parallel_size;
+
+   private:
+    /// Contents of the file.
+    std::shared_ptr<const char[]> _buffer;
+
+    /// Number of characters in the file.
+    size_t _size{0};
+
+    /**
+     * Parse all of the numbers in a range of characters, and add
+     * an offset to each one.
+     *
+     * @param  ptr      First character in the range.
+     * @param  last     One past the last character in the range.
+     * @param  values   Numbers that were read (output).
+     * @param  max_num  Maximum number of values to read.
+     * @param  offset   Offset added to each value.
+     * @return          Number of values read.
+     */
+    size_t parse(const char* ptr, const char* last, double* values,
+                 size_t max_num, double offset) const;
+};
+
+/// @}
+}  // end of namespace ocean
+}  // end of namespace usml
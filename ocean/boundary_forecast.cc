@@ -0,0 +1,95 @@
+/**
+ * @file boundary_forecast.cc
+ * Boundary height that interpolates between forecast epochs.
+ */
+#include <usml/ocean/boundary_forecast.h>
+
+#include <cmath>
+
+using namespace usml::ocean;
+
+/**
+ * Initialize the forecast at a specific time.
+ */
+boundary_forecast::boundary_forecast(
+    const epochs_type& epochs, double time,
+    const reflect_loss_model::csptr& reflect_loss,
+    const scattering_model::csptr& scattering)
+    : boundary_model(reflect_loss ? reflect_loss : epochs.front(),
+                     scattering ? scattering : epochs.front()),
+      _epochs(epochs),
+      _time(time),
+      _reflect_model(reflect_loss ? reflect_loss : epochs.front()),
+      _scattering_model(scattering ? scattering : epochs.front()) {
+    _weight = _epochs.bracket(time, &_before, &_after);
+}
+
+/**
+ * Create a new model that shares the epochs of this forecast.
+ */
+boundary_forecast::csptr boundary_forecast::at(double time) const {
+    return std::make_shared<const boundary_forecast>(
+        _epochs, time, _reflect_model, _scattering_model);
+}
+
+/**
+ * Compute the height of the boundary and it's surface normal at
+ * a series of locations.
+ */
+void boundary_forecast::height(const wposition& location, matrix<double>* rho,
+                               wvector* normal) const {
+    _before->height(location, rho, normal);
+    if (_before == _after || _weight <= 0.0) {
+        return;
+    }
+
+    matrix<double> next(location.size1(), location.size2());
+    if (normal == nullptr) {
+        _after->height(location, &next);
+    } else {
+        wvector next_normal(location.size1(), location.size2());
+        _after->height(location, &next, &next_normal);
+        matrix<double> r =
+            normal->rho() + _weight * (next_normal.rho() - normal->rho());
+        matrix<double> t =
+            normal->theta() + _weight * (next_normal.theta() - normal->theta());
+        matrix<double> p =
+            normal->phi() + _weight * (next_normal.phi() - normal->phi());
+        const matrix<double> length = sqrt(abs2(r) + abs2(t) + abs2(p));
+        normal->rho(element_div(r, length));
+        normal->theta(element_div(t, length));
+        normal->phi(element_div(p, length));
+    }
+    *rho += _weight * (next - *rho);
+}
+
+/**
+ * Compute the height of the boundary and it's surface normal at
+ * a single location.
+ */
+void boundary_forecast::height(const wposition1& location, double* rho,
+                               wvector1* normal) const {
+    _before->height(location, rho, normal);
+    if (_before == _after || _weight <= 0.0) {
+        return;
+    }
+
+    double next;
+    if (normal == nullptr) {
+        _after->height(location, &next);
+    } else {
+        wvector1 next_normal;
+        _after->height(location, &next, &next_normal);
+        const double r =
+            normal->rho() + _weight * (next_normal.rho() - normal->rho());
+        const double t =
+            normal->theta() + _weight * (next_normal.theta() - normal->theta());
+        const double p =
+            normal->phi() + _weight * (next_normal.phi() - normal->phi());
+        const double length = std::sqrt(r * r + t * t + p * p);
+        normal->rho(r / length);
+        normal->theta(t / length);
+        normal->phi(p / length);
+    }
+    *rho += _weight * (next - *rho);
+}
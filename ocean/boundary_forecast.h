@@ -0,0 +1,122 @@
+/**
+ * @file boundary_forecast.h
+ * Boundary height that interpolates between forecast epochs.
+ */
+#pragma once
+
+#include <usml/ocean/boundary_model.h>
+#include <usml/ocean/forecast_epochs.h>
+#include <usml/types/wposition.h>
+#include <usml/types/wposition1.h>
+#include <usml/types/wvector.h>
+#include <usml/types/wvector1.h>
+#include <usml/usml_config.h>
+
+namespace usml {
+namespace ocean {
+
+/// @ingroup boundaries
+/// @{
+
+/**
+ * Boundary height that interpolates between forecast epochs. Used to model
+ * boundaries that change over time, like the effect of tides on water depth.
+ * Each epoch is a complete boundary_model. The boundary height is
+ * computed by linear interpolation in time between the two epochs that
+ * bracket the time of this model. The surface normal is interpolated in
+ * the same way and then re-normalized. Times outside of the forecast use
+ * the first or last epoch.
+ *
+ * Reflection loss and scattering strength are delegated to the first
+ * epoch, unless other models are provided, so that they don't change
+ * as the forecast moves forward in time. Use the at() method to create a
+ * new instance for a later time. The new instance shares the epochs of this
+ * one, so moving a forecast forward in time does not reload or copy any data.
+ */
+class USML_DECLSPEC boundary_forecast : public boundary_model {
+   public:
+    /// Shared pointer to constant version of this class.
+    typedef std::shared_ptr<const boundary_forecast> csptr;
+
+    /// List of boundaries indexed by forecast time.
+    typedef forecast_epochs<boundary_model> epochs_type;
+
+    /**
+     * Initialize the forecast at a specific time.
+     *
+     * @param epochs        Boundaries indexed by forecast time (sec).
+     * @param time          Time at which to evaluate forecast (sec).
+     * @param reflect_loss  Reflection loss model. Uses the first epoch if
+     *                      none specified.
+     * @param scattering    Reverberation scattering strength model. Uses
+     *                      the first epoch if none specified.
+     * @throws std::invalid_argument if the list of epochs is empty.
+     */
+    boundary_forecast(const epochs_type& epochs, double time,
+                      const reflect_loss_model::csptr& reflect_loss = nullptr,
+                      const scattering_model::csptr& scattering = nullptr);
+
+    /** Time at which this forecast is evaluated (sec). */
+    double time() const { return _time; }
+
+    /** Boundaries indexed by forecast time. */
+    const epochs_type& epochs() const { return _epochs; }
+
+    /**
+     * Create a new model that shares the epochs, reflection loss, and
+     * scattering strength of this forecast, but is evaluated at a
+     * different time.
+     *
+     * @param time      Time at which to evaluate forecast (sec).
+     * @return          Forecast boundary for the new time.
+     */
+    csptr at(double time) const;
+
+    /**
+     * Compute the height of the boundary and it's surface normal at
+     * a series of locations.
+     *
+     * @param location      Location at which to compute boundary.
+     * @param rho           Surface height in spherical earth coords (output).
+     * @param normal        Unit normal relative to location (output).
+     */
+    void height(const wposition& location, matrix<double>* rho,
+                wvector* normal = nullptr) const override;
+
+    /**
+     * Compute the height of the boundary and it's surface normal at
+     * a single location.  Often used during reflection processing.
+     *
+     * @param location      Location at which to compute boundary.
+     * @param rho           Surface height in spherical earth coords (output).
+     * @param normal        Unit normal relative to location (output).
+     */
+    void height(const wposition1& location, double* rho,
+                wvector1* normal = nullptr) const override;
+
+   private:
+    /// Boundaries indexed by forecast time.
+    const epochs_type _epochs;
+
+    /// Time at which this forecast is evaluated (sec).
+    const double _time;
+
+    /// Reflection loss model shared by all times.
+    reflect_loss_model::csptr _reflect_model;
+
+    /// Scattering strength model shared by all times.
+    scattering_model::csptr _scattering_model;
+
+    /// Boundary for the epoch at or before this time.
+    boundary_model::csptr _before;
+
+    /// Boundary for the epoch after this time.
+    boundary_model::csptr _after;
+
+    /// Interpolation weight of the epoch after this time.
+    double _weight;
+};
+
+/// @}
+}  // end of namespace ocean
+}  // end of namespace usml
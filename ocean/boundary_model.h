@@ -207,6 +207,33 @@ class USML_DECLSPEC boundary_model : public reflect_loss_model,
                                 amplitude);
     }
 
+    /**
+     * Computes the broadband scattering strength for a batch of independent
+     * scattering geometries.
+     *
+     * @param location      Location of each scattering geometry.
+     * @param frequencies   Frequencies over which to compute loss. (Hz)
+     * @param de_incident   Depression incident angle of each geometry (radians).
+     * @param de_scattered  Depression scattered angle of each geometry
+     *                      (radians).
+     * @param az_incident   Azimuthal incident angle of each geometry (radians).
+     * @param az_scattered  Azimuthal scattered angle of each geometry
+     *                      (radians).
+     * @param amplitude     Reverberation scattering strength ratio for
+     *                      each geometry and frequency (output).
+     */
+    void scattering(const std::vector<wposition1>& location,
+                    const seq_vector::csptr& frequencies,
+                    const vector<double>& de_incident,
+                    const vector<double>& de_scattered,
+                    const vector<double>& az_incident,
+                    const vector<double>& az_scattered,
+                    matrix<double>* amplitude) const override {
+        _scattering->scattering(location, frequencies, de_incident,
+                                de_scattered, az_incident, az_scattered,
+                                amplitude);
+    }
+
    private:
     /// Reference to the reflection loss model.
     reflect_loss_model::csptr _reflect_loss;
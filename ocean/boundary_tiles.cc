@@ -0,0 +1,69 @@
+/**
+ * @file boundary_tiles.cc
+ * Boundary model that loads its data in tiles around the areas in use.
+ */
+#include <usml/ocean/boundary_tiles.h>
+
+using namespace usml::ocean;
+
+/**
+ * Compute the height of the boundary and it's surface normal at
+ * a series of locations.
+ */
+void boundary_tiles::height(const wposition& location, matrix<double>* rho,
+                            wvector* normal) const {
+    thread_local std::vector<streamer_type::tile_index> groups;
+    const bool single = _streamer->group(location, &groups);
+
+    // use whole matrix if all locations are in the same tile
+
+    if (single) {
+        _streamer->find(groups.front().first)->height(location, rho, normal);
+        return;
+    }
+
+    // otherwise, make one call for the locations in each tile
+
+    const size_t num_cols = location.size2();
+    for (auto first = groups.begin(); first != groups.end();) {
+        auto last = first;
+        while (last != groups.end() && last->first == first->first) {
+            ++last;
+        }
+        const auto* index = &*first;
+        const size_t num = last - first;
+        wposition points(num, 1);
+        for (size_t n = 0; n < num; ++n) {
+            const size_t r = index[n].second / num_cols;
+            const size_t c = index[n].second % num_cols;
+            points.rho(n, 0, location.rho(r, c));
+            points.theta(n, 0, location.theta(r, c));
+            points.phi(n, 0, location.phi(r, c));
+        }
+        matrix<double> height(num, 1);
+        wvector tile_normal(num, 1);
+        _streamer->find(first->first)
+            ->height(points, &height, normal ? &tile_normal : nullptr);
+        for (size_t n = 0; n < num; ++n) {
+            const size_t r = index[n].second / num_cols;
+            const size_t c = index[n].second % num_cols;
+            (*rho)(r, c) = height(n, 0);
+            if (normal != nullptr) {
+                normal->rho(r, c, tile_normal.rho(n, 0));
+                normal->theta(r, c, tile_normal.theta(n, 0));
+                normal->phi(r, c, tile_normal.phi(n, 0));
+            }
+        }
+        first = last;
+    }
+}
+
+/**
+ * Compute the height of the boundary and it's surface normal at
+ * a single location.
+ */
+void boundary_tiles::height(const wposition1& location, double* rho,
+                            wvector1* normal) const {
+    _streamer->find(location.latitude(), location.longitude())
+        ->height(location, rho, normal);
+}
@@ -0,0 +1,89 @@
+/**
+ * @file boundary_tiles.h
+ * Boundary model that loads its data in tiles around the areas in use.
+ */
+#pragma once
+
+#include <usml/ocean/boundary_model.h>
+#include <usml/ocean/tile_streamer.h>
+#include <usml/types/wposition.h>
+#include <usml/types/wposition1.h>
+#include <usml/types/wvector.h>
+#include <usml/types/wvector1.h>
+#include <usml/usml_config.h>
+
+#include <memory>
+
+namespace usml {
+namespace ocean {
+
+/// @ingroup boundaries
+/// @{
+
+/**
+ * Boundary model that loads its data in tiles around the areas in use.
+ * Each tile is a separate boundary_model, such as a boundary_grid extracted
+ * from a bathymetry database, that is loaded by a tile_streamer. Heights
+ * are computed by grouping locations by tile, and making a single call to
+ * the model for each tile. Reflection loss and scattering strength are
+ * provided by this model, not the tiles, so that they are consistent across
+ * tile boundaries.
+ *
+ * Use ocean_utils::stream_region() to load the tiles around a sensor before
+ * propagation starts, and to prefetch the tiles ahead of a moving platform.
+ */
+class USML_DECLSPEC boundary_tiles : public boundary_model {
+   public:
+    /// Shared pointer to constant version of this class.
+    typedef std::shared_ptr<const boundary_tiles> csptr;
+
+    /// Loads and evicts the tiles for this boundary.
+    typedef tile_streamer<boundary_model> streamer_type;
+
+    /**
+     * Initialize the tiles and reflection loss components for a boundary.
+     *
+     * @param streamer      Loads and evicts the tiles for this boundary.
+     * @param reflect_loss  Reflection loss model.
+     * @param scattering    Reverberation scattering strength model.
+     */
+    boundary_tiles(const std::shared_ptr<streamer_type>& streamer,
+                   const reflect_loss_model::csptr& reflect_loss = nullptr,
+                   const scattering_model::csptr& scattering = nullptr)
+        : boundary_model(reflect_loss, scattering), _streamer(streamer) {}
+
+    /** Loads and evicts the tiles for this boundary. */
+    const std::shared_ptr<streamer_type>& streamer() const {
+        return _streamer;
+    }
+
+    /**
+     * Compute the height of the boundary and it's surface normal at
+     * a series of locations.
+     *
+     * @param location      Location at which to compute boundary.
+     * @param rho           Surface height in spherical earth coords (output).
+     * @param normal        Unit normal relative to location (output).
+     */
+    void height(const wposition& location, matrix<double>* rho,
+                wvector* normal = nullptr) const override;
+
+    /**
+     * Compute the height of the boundary and it's surface normal at
+     * a single location.  Often used during reflection processing.
+     *
+     * @param location      Location at which to compute boundary.
+     * @param rho           Surface height in spherical earth coords (output).
+     * @param normal        Unit normal relative to location (output).
+     */
+    void height(const wposition1& location, double* rho,
+                wvector1* normal = nullptr) const override;
+
+   private:
+    /// Loads and evicts the tiles for this boundary.
+    std::shared_ptr<streamer_type> _streamer;
+};
+
+/// @}
+}  // end of namespace ocean
+}  // end of namespace usml
@@ -5,15 +5,23 @@
 #pragma once
 
 #include <stddef.h>
+#include <usml/threads/thread_controller.h>
+#include <usml/threads/thread_pool.h>
 #include <usml/types/data_grid.h>
 #include <usml/types/gen_grid.h>
 #include <usml/types/seq_vector.h>
 #include <usml/types/wposition.h>
 
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
 namespace usml {
 namespace ocean {
 
 using namespace usml::types;
+using namespace usml::threads;
 
 /// @ingroup profiles
 /// @{
@@ -47,6 +55,11 @@ using namespace usml::types;
  * TRUE for any dimensional axis that uses the PCHIP interpolation. This is
  * because of PCHIP allowing for extreme values when extrapolating data.
  *
+ * The sound speed is computed directly from the data arrays of the
+ * temperature and salinity grids, which must use the same axes. Large grids,
+ * like high resolution HYCOM fields, are split into blocks of depth slices
+ * that are computed in parallel on the thread_controller pool.
+ *
  * NOTE: data_grid_mackenzie takes control of the two data_grids that are
  * passed in and then deletes them before the sound speed data_grid is returned.
  *
@@ -82,29 +95,70 @@ class data_grid_mackenzie : public gen_grid<3> {
         }
 
         // compute sound speed for each temperature, salinity, and depth
+        // works directly on the data arrays, one depth slice at a time
+
+        const size_t num_depths = this->axis(0).size();
+        const size_t slice_size = this->axis(1).size() * this->axis(2).size();
+        const double* T = temperature->data();
+        const double* S = salinity->data();
+        if (T == nullptr || S == nullptr) {
+            throw std::invalid_argument(
+                "data_grid_mackenzie requires unpacked data");
+        }
+        double* speed = this->_writeable_data.get();
+
+        if (num_depths * slice_size < min_parallel_size) {
+            compute_speed(this->axis(0), 0, num_depths, slice_size, T, S,
+                          speed);
+            return;
+        }
+
+        // split depth slices into contiguous blocks for the thread pool
 
-        size_t index[3];
-        for (index[0] = 0; index[0] < temperature->axis(0).size(); ++index[0]) {
-            for (index[1] = 0; index[1] < temperature->axis(1).size();
-                 ++index[1]) {
-                for (index[2] = 0; index[2] < temperature->axis(2).size();
-                     ++index[2]) {
-                    // extract depth, temperature, and salinity at this point
-
-                    double D = wposition::earth_radius -
-                               temperature->axis(0)[index[0]];
-                    double T = temperature->data(index);
-                    double S = salinity->data(index);
-
-                    // compute sound speed
-
-                    double c = 1448.96 + 4.591 * T - 5.304e-2 * T * T +
-                               2.374e-4 * T * T * T +
-                               (1.340 - 1.025e-2 * T) * (S - 35.0) +
-                               1.630e-2 * D + 1.675e-7 * D * D -
-                               7.139e-13 * T * D * D * D;
-                    setdata(index, c);
-                }
+        const seq_vector& rho = this->axis(0);
+        thread_controller::instance()->run_blocks(
+            num_depths, [&](size_t first, size_t last) {
+                compute_speed(rho, first, last, slice_size, T, S, speed);
+            });
+    }
+
+   private:
+    /// Minimum number of grid points needed to compute speeds in parallel.
+    static const size_t min_parallel_size = 100000;
+
+    /**
+     * Compute sound speed for a block of depth slices. The depth axis
+     * changes the slowest in the data array, so each slice is a contiguous
+     * block of latitudes and longitudes. Depth terms are computed once per
+     * slice, and the inner loop has no dependencies between iterations,
+     * which allows the compiler to vectorize it.
+     *
+     * @param rho           Depth axis as earth radius plus altitude (m).
+     * @param first         Index of first depth slice to compute.
+     * @param last          One past the index of the last depth slice.
+     * @param slice_size    Number of grid points in each depth slice.
+     * @param T             Temperature for each grid point (degrees C).
+     * @param S             Salinity for each grid point (ppt).
+     * @param speed         Sound speed for each grid point (m/s).
+     */
+    static void compute_speed(const seq_vector& rho, size_t first,
+                              size_t last, size_t slice_size,
+                              const double* T, const double* S,
+                              double* speed) {
+        for (size_t d = first; d < last; ++d) {
+            const double D = wposition::earth_radius - rho(d);
+            const double depth_term = 1448.96 + 1.630e-2 * D + 1.675e-7 * D * D;
+            const double cubic_term = 7.139e-13 * D * D * D;
+            const size_t offset = d * slice_size;
+            const double* t = T + offset;
+            const double* s = S + offset;
+            double* c = speed + offset;
+            for (size_t n = 0; n < slice_size; ++n) {
+                const double temp = t[n];
+                c[n] = depth_term +
+                       temp * (4.591 - cubic_term +
+                               temp * (-5.304e-2 + temp * 2.374e-4)) +
+                       (1.340 - 1.025e-2 * temp) * (s[n] - 35.0);
             }
         }
     }
@@ -0,0 +1,177 @@
+/**
+ * @file environment_cache.h
+ * Process-wide cache of environmental data grids.
+ */
+#pragma once
+
+#include <usml/threads/read_write_lock.h>
+#include <usml/types/data_grid.h>
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <string>
+
+namespace usml {
+namespace ocean {
+
+using namespace usml::threads;
+using namespace usml::types;
+
+/// @ingroup ocean_model
+/// @{
+
+/**
+ * Process-wide cache of environmental data grids. Shares data grids that
+ * have already been loaded from disk, or derived from other grids, between
+ * all of the ocean models in a process. Grids are identified by a text key
+ * that is typically built from the file, variable, region, and time used
+ * to create them. The caller provides a loader that builds the grid the
+ * first time that each key is requested. Later requests for the same key
+ * return a shared reference to the same constant grid, so that building
+ * many ocean models for overlapping areas and times only reads the
+ * databases once.
+ *
+ * If several threads request the same key at the same time, only the first
+ * thread invokes the loader. The others wait for it to finish, without
+ * blocking requests for other keys. If the loader throws an exception,
+ * the exception is passed to all of the waiting threads, and the key is
+ * removed so that it can be loaded again later.
+ *
+ * The cache holds a reference to each grid until release() or reset() is
+ * invoked. Use release() between scenarios to discard grids that are no
+ * longer used by any ocean model.
+ *
+ * @param  NUM_DIMS     Number of dimensions in the cached grids.
+ */
+template <size_t NUM_DIMS>
+class environment_cache {
+   public:
+    /// Shared pointer to the type of grid stored in this cache.
+    typedef typename data_grid<NUM_DIMS>::csptr grid_csptr;
+
+    /// Function used to create a grid that is not in the cache.
+    typedef std::function<grid_csptr()> loader;
+
+    /**
+     * Builds a cache key from the parameters that are normally used to
+     * extract environmental data from a database.
+     *
+     * @param  file         Name of the file that contains the data.
+     * @param  variable     Name of the variable, or derived quantity.
+     * @param  south        Lower limit for the latitude axis (degrees).
+     * @param  north        Upper limit for the latitude axis (degrees).
+     * @param  west         Lower limit for the longitude axis (degrees).
+     * @param  east         Upper limit for the longitude axis (degrees).
+     * @param  time         Time index for the data, such as month of year.
+     * @return              Text that uniquely identifies this grid.
+     */
+    static std::string key(const std::string& file,
+                           const std::string& variable, double south,
+                           double north, double west, double east,
+                           int time = 0) {
+        std::ostringstream os;
+        os << std::setprecision(12) << file << '|' << variable << '|'
+           << south << '|' << north << '|' << west << '|' << east << '|'
+           << time;
+        return os.str();
+    }
+
+    /**
+     * Find a grid in the cache, or load it if it is not already present.
+     *
+     * @param  key          Text that uniquely identifies this grid.
+     * @param  load         Function used to create the grid if it is not
+     *                      already in the cache.
+     * @return              Shared reference to the cached grid.
+     * @throws              Any exception thrown by the loader.
+     */
+    static grid_csptr find(const std::string& key, const loader& load) {
+        std::promise<grid_csptr> promise;
+        std::shared_future<grid_csptr> future;
+        bool owner = false;
+        {
+            write_lock_guard guard(_mutex);
+            auto iter = _grids.find(key);
+            if (iter != _grids.end()) {
+                future = iter->second;
+            } else {
+                future = promise.get_future().share();
+                _grids[key] = future;
+                owner = true;
+            }
+        }
+
+        // load grid outside of the lock, so that other keys are not blocked
+
+        if (owner) {
+            try {
+                promise.set_value(load());
+            } catch (...) {
+                {
+                    write_lock_guard guard(_mutex);
+                    _grids.erase(key);
+                }
+                promise.set_exception(std::current_exception());
+            }
+        }
+        return future.get();
+    }
+
+    /**
+     * Discard grids that are not used outside of the cache.
+     *
+     * @return  Number of grids removed from the cache.
+     */
+    static size_t release() {
+        write_lock_guard guard(_mutex);
+        size_t count = 0;
+        auto iter = _grids.begin();
+        while (iter != _grids.end()) {
+            const auto& future = iter->second;
+            if (future.wait_for(std::chrono::seconds(0)) ==
+                    std::future_status::ready &&
+                future.get().use_count() <= 1) {
+                iter = _grids.erase(iter);
+                ++count;
+            } else {
+                ++iter;
+            }
+        }
+        return count;
+    }
+
+    /**
+     * Number of grids in the cache, including those still being loaded.
+     */
+    static size_t size() {
+        read_lock_guard guard(_mutex);
+        return _grids.size();
+    }
+
+    /**
+     * Discard all grids from the cache.
+     */
+    static void reset() {
+        write_lock_guard guard(_mutex);
+        _grids.clear();
+    }
+
+   private:
+    /// Grids in the cache, indexed by key.
+    static inline std::map<std::string, std::shared_future<grid_csptr>> _grids;
+
+    /// Mutex used to lock access to the list of grids.
+    static inline read_write_lock _mutex;
+
+    /// Hide default constructor to prevent incorrect use of singleton.
+    environment_cache() {}
+};
+
+/// @}
+}  // end of namespace ocean
+}  // end of namespace usml
@@ -0,0 +1,95 @@
+/**
+ * @file forecast_epochs.h
+ * Time ordered list of environmental models for a forecast.
+ */
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <stdexcept>
+
+namespace usml {
+namespace ocean {
+
+/// @ingroup ocean_model
+/// @{
+
+/**
+ * Time ordered list of environmental models for a forecast. Each epoch
+ * associates a forecast time with the model that is valid at that time.
+ * Used by time varying models, like profile_forecast and boundary_forecast,
+ * to find the pair of epochs that bracket a specific time. The list of
+ * epochs is immutable once it has been created, so copies of this object
+ * share the same list.
+ *
+ * @tparam MODEL    Type of model stored for each epoch. Must define a
+ *                  csptr type for its shared pointer.
+ */
+template <class MODEL>
+class forecast_epochs {
+   public:
+    /// Shared pointer to constant version of the model in each epoch.
+    typedef typename MODEL::csptr model_csptr;
+
+    /// Maps forecast time (sec) to the model valid at that time.
+    typedef std::map<double, model_csptr> epoch_map;
+
+    /**
+     * Copies a list of forecast epochs.
+     *
+     * @param epochs    Models indexed by forecast time (sec).
+     * @throws std::invalid_argument if the list of epochs is empty.
+     */
+    forecast_epochs(const epoch_map& epochs)
+        : _epochs(std::make_shared<const epoch_map>(epochs)) {
+        if (_epochs->empty()) {
+            throw std::invalid_argument("forecast has no epochs");
+        }
+    }
+
+    /** Number of epochs in this forecast. */
+    size_t size() const { return _epochs->size(); }
+
+    /** Time of the first epoch in this forecast (sec). */
+    double front_time() const { return _epochs->begin()->first; }
+
+    /** Model for the first epoch in this forecast. */
+    const model_csptr& front() const { return _epochs->begin()->second; }
+
+    /**
+     * Find the pair of epochs that bracket a specific time. Times outside
+     * of the forecast are limited to the first or last epoch.
+     *
+     * @param time      Time at which to evaluate forecast (sec).
+     * @param before    Model for the epoch at or before this time (output).
+     * @param after     Model for the epoch after this time (output).
+     * @return          Interpolation weight of the "after" epoch, in
+     *                  the range [0,1].
+     */
+    double bracket(double time, model_csptr* before, model_csptr* after) const {
+        auto next = _epochs->upper_bound(time);
+        if (next == _epochs->begin()) {
+            *before = *after = next->second;
+            return 0.0;
+        }
+        auto prev = std::prev(next);
+        if (next == _epochs->end()) {
+            *before = *after = prev->second;
+            return 0.0;
+        }
+        *before = prev->second;
+        *after = next->second;
+        return std::clamp((time - prev->first) / (next->first - prev->first),
+                          0.0, 1.0);
+    }
+
+   private:
+    /// Models indexed by forecast time (sec).
+    std::shared_ptr<const epoch_map> _epochs;
+};
+
+/// @}
+}  // end of namespace ocean
+}  // end of namespace usml
@@ -0,0 +1,138 @@
+/**
+ * @file mmap_bathy.cc
+ * Memory mapped bathymetry grid that is shared across processes.
+ */
+
+#include <usml/ocean/mmap_bathy.h>
+#include <usml/types/seq_vector.h>
+
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace usml::ocean;
+
+/** Identifier at the start of each binary bathymetry file. */
+const char mmap_bathy::magic[8] = "USMLBTY";
+
+/**
+ * Map a bathymetry grid that was created by write().
+ */
+mmap_bathy::mmap_bathy(const char* filename) {
+    // map the whole file into memory, or read it on non-POSIX platforms
+
+    size_t file_size = 0;
+    std::shared_ptr<const char[]> base;
+#ifndef _WIN32
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        throw std::invalid_argument("file not found");
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        close(fd);
+        throw std::invalid_argument("unrecognized file type");
+    }
+    file_size = (size_t)info.st_size;
+    void* addr = mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);  // mapping remains valid after file is closed
+    if (addr == MAP_FAILED) {
+        throw std::invalid_argument("unable to map file");
+    }
+    base = std::shared_ptr<const char[]>(
+        (const char*)addr,
+        [file_size](const char* ptr) { munmap((void*)ptr, file_size); });
+#else
+    std::ifstream stream(filename, std::ios::binary | std::ios::ate);
+    if (!stream) {
+        throw std::invalid_argument("file not found");
+    }
+    file_size = (size_t)stream.tellg();
+    std::shared_ptr<char[]> buffer(new char[file_size]);
+    stream.seekg(0);
+    stream.read(buffer.get(), (std::streamsize)file_size);
+    base = buffer;
+#endif
+
+    // validate header
+
+    const size_t header_size =
+        sizeof(magic) + 2 * sizeof(uint32_t) + 2 * sizeof(uint64_t);
+    if (file_size < header_size ||
+        std::memcmp(base.get(), magic, sizeof(magic)) != 0) {
+        throw std::invalid_argument("unrecognized file type");
+    }
+    uint32_t header[2];
+    uint64_t num[2];
+    std::memcpy(header, base.get() + sizeof(magic), sizeof(header));
+    std::memcpy(num, base.get() + sizeof(magic) + sizeof(header),
+                sizeof(num));
+    if (header[0] != byte_order) {
+        throw std::invalid_argument("bathymetry has a different byte order");
+    }
+    if (header[1] != version) {
+        throw std::invalid_argument("unsupported bathymetry version");
+    }
+    if (num[0] < 1 || num[1] < 1 ||
+        file_size != header_size + sizeof(double) * (num[0] + num[1] +
+                                                     num[0] * num[1])) {
+        throw std::invalid_argument("unrecognized file type");
+    }
+
+    // copy axes into memory, and share depths with the mapping
+
+    const auto* values = (const double*)(base.get() + header_size);
+    this->_axis[0] = seq_vector::build_best(values, num[0]);
+    this->_axis[1] = seq_vector::build_best(values + num[0], num[1]);
+    this->_data =
+        std::shared_ptr<const double[]>(base, values + num[0] + num[1]);
+    this->_zero = 0.0;
+    this->_zero_init = true;
+}
+
+/**
+ * Converts any 2-D bathymetry grid into the binary format used by
+ * this class.
+ */
+void mmap_bathy::write(const char* filename, const data_grid<2>& grid) {
+    std::ofstream stream(filename, std::ios::binary | std::ios::trunc);
+    if (!stream) {
+        throw std::invalid_argument("unable to create file");
+    }
+    const uint32_t header[2] = {byte_order, version};
+    const uint64_t num[2] = {grid.axis(0).size(), grid.axis(1).size()};
+    stream.write(magic, sizeof(magic));
+    stream.write((const char*)header, sizeof(header));
+    stream.write((const char*)num, sizeof(num));
+    for (const auto& dim : {0, 1}) {
+        for (size_t n = 0; n < num[dim]; ++n) {
+            double value = grid.axis(dim)(n);
+            stream.write((const char*)&value, sizeof(value));
+        }
+    }
+
+    // write depths in row major order, one row of longitudes at a time
+
+    std::vector<double> row(num[1]);
+    size_t index[2];
+    for (index[0] = 0; index[0] < num[0]; ++index[0]) {
+        for (index[1] = 0; index[1] < num[1]; ++index[1]) {
+            row[index[1]] = grid.data(index);
+        }
+        stream.write((const char*)row.data(),
+                     (std::streamsize)(sizeof(double) * num[1]));
+    }
+    if (!stream) {
+        throw std::invalid_argument("unable to create file");
+    }
+}
@@ -0,0 +1,94 @@
+/**
+ * @file mmap_bathy.h
+ * Memory mapped bathymetry grid that is shared across processes.
+ */
+#pragma once
+
+#include <usml/types/data_grid.h>
+#include <usml/types/gen_grid.h>
+#include <usml/usml_config.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace usml {
+namespace ocean {
+
+using namespace usml::ublas;
+using namespace usml::types;
+
+/// @ingroup boundaries
+/// @{
+
+/**
+ * Memory mapped bathymetry grid that is shared across processes.
+ * Reads a binary copy of a bathymetry grid, in spherical earth coordinates,
+ * that was created by the write() converter from any other data_grid<2>,
+ * including netcdf_bathy and ascii_arc_bathy. The file layout is:
+ *
+ * - 8 byte identifier "USMLBTY" followed by a null.
+ * - byte order mark 0x01020304 as a 32 bit unsigned integer.
+ * - version of the format as a 32 bit unsigned integer.
+ * - number of colatitudes and longitudes as 64 bit unsigned integers.
+ * - colatitude axis (radians) as 64 bit floating point numbers.
+ * - longitude axis (radians) as 64 bit floating point numbers.
+ * - earth radius plus altitude (meters) as 64 bit floating point numbers,
+ *   in the same row major order as the data_grid, where the longitude
+ *   index changes fastest.
+ *
+ * All values are stored in the native byte order of the machine that
+ * wrote the file, so that the depths can be used in place. Files written
+ * with a different byte order or version are rejected when they are
+ * opened. Only the axes are copied into memory when the file is
+ * opened. The depths are mapped read-only into the address space of the
+ * process, so pages of the grid are only loaded when interpolation first
+ * touches them, and the operating system shares those pages between all
+ * of the processes that open the same file. This makes it practical to
+ * build a single ETOPO1-class grid for a large operating area, and to
+ * reuse it for many scenarios without re-reading the source database.
+ *
+ * The mapping stays open until the last shared reference to data_csptr()
+ * is released, so grids like data_grid_bathy can wrap this grid without
+ * copying the depths. This grid is read-only; setdata() throws
+ * std::logic_error.
+ * On platforms without POSIX mmap(), the depths are read into memory instead.
+ */
+class USML_DECLSPEC mmap_bathy : public gen_grid<2> {
+   public:
+    /**
+     * Map a bathymetry grid that was created by write().
+     *
+     * @param  filename     Name of the binary bathymetry file.
+     * @throws std::invalid_argument if the file can not be opened, does
+     *                      not have the expected layout, or was written
+     *                      with a different byte order or version.
+     */
+    mmap_bathy(const char* filename);
+
+    /**
+     * Converts any 2-D bathymetry grid into the binary format used by
+     * this class. The grid is expected to use the colatitude, longitude,
+     * and earth radius plus altitude coordinates used by netcdf_bathy and
+     * ascii_arc_bathy. Depths are read with data(index), so packed grids
+     * are unpacked as they are written.
+     *
+     * @param  filename     Name of the binary bathymetry file to create.
+     * @param  grid         Bathymetry grid to be converted.
+     * @throws std::invalid_argument if the file can not be created.
+     */
+    static void write(const char* filename, const data_grid<2>& grid);
+
+   private:
+    /// Identifier at the start of each binary bathymetry file.
+    static const char magic[8];
+
+    /// Byte order mark, read back as a different number on other machines.
+    static const uint32_t byte_order = 0x01020304;
+
+    /// Version number written to each binary bathymetry file.
+    static const uint32_t version = 2;
+};
+
+/// @}
+}  // end of namespace ocean
+}  // end of namespace usml
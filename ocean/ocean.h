@@ -62,23 +62,31 @@
 #include <usml/ocean/ambient_wenz.h>
 #include <usml/ocean/ascii_arc_bathy.h>
 #include <usml/ocean/ascii_profile.h>
+#include <usml/ocean/ascii_reader.h>
 #include <usml/ocean/attenuation_constant.h>
 #include <usml/ocean/attenuation_model.h>
 #include <usml/ocean/attenuation_thorp.h>
 #include <usml/ocean/boundary_flat.h>
+#include <usml/ocean/boundary_forecast.h>
 #include <usml/ocean/boundary_grid.h>
 #include <usml/ocean/boundary_model.h>
 #include <usml/ocean/boundary_slope.h>
+#include <usml/ocean/boundary_tiles.h>
 #include <usml/ocean/data_grid_mackenzie.h>
+#include <usml/ocean/environment_cache.h>
+#include <usml/ocean/forecast_epochs.h>
+#include <usml/ocean/mmap_bathy.h>
 #include <usml/ocean/ocean_model.h>
 #include <usml/ocean/ocean_shared.h>
 #include <usml/ocean/ocean_utils.h>
 #include <usml/ocean/profile_catenary.h>
+#include <usml/ocean/profile_forecast.h>
 #include <usml/ocean/profile_grid.h>
 #include <usml/ocean/profile_linear.h>
 #include <usml/ocean/profile_model.h>
 #include <usml/ocean/profile_munk.h>
 #include <usml/ocean/profile_n2.h>
+#include <usml/ocean/profile_tiles.h>
 #include <usml/ocean/reflect_loss_beckmann.h>
 #include <usml/ocean/reflect_loss_constant.h>
 #include <usml/ocean/reflect_loss_eckart.h>
@@ -86,10 +94,12 @@
 #include <usml/ocean/reflect_loss_netcdf.h>
 #include <usml/ocean/reflect_loss_rayleigh.h>
 #include <usml/ocean/reflect_loss_rayleigh_grid.h>
+#include <usml/ocean/reflect_loss_table.h>
 #include <usml/ocean/scattering_chapman.h>
 #include <usml/ocean/scattering_constant.h>
 #include <usml/ocean/scattering_lambert.h>
 #include <usml/ocean/scattering_model.h>
+#include <usml/ocean/tile_streamer.h>
 #include <usml/ocean/volume_flat.h>
 #include <usml/ocean/volume_model.h>
 #include <usml/ocean/wave_height_pierson.h>
@@ -109,6 +109,51 @@ class USML_DECLSPEC ocean_model {
         }
     }
 
+    /**
+     * Computes the broadband scattering strength for a batch of independent
+     * scattering geometries on a specific interface. Makes a single call
+     * to the scattering model for the whole batch.
+     *
+     * @param interface 	Interface number of scattering ocean component
+     * @param location      Location of each scattering geometry.
+     * @param frequencies   Frequencies over which to compute loss. (Hz)
+     * @param de_incident   Depression incident angle of each geometry (radians).
+     * @param de_scattered  Depression scattered angle of each geometry
+     *                      (radians).
+     * @param az_incident   Azimuthal incident angle of each geometry (radians).
+     * @param az_scattered  Azimuthal scattered angle of each geometry
+     *                      (radians).
+     * @param amplitude     Reverberation scattering strength ratio for
+     *                      each geometry (rows) and frequency (columns)
+     *                      (output).
+     */
+    void scattering(size_t interface, const std::vector<wposition1>& location,
+                    const seq_vector::csptr& frequencies,
+                    const vector<double>& de_incident,
+                    const vector<double>& de_scattered,
+                    const vector<double>& az_incident,
+                    const vector<double>& az_scattered,
+                    matrix<double>* amplitude) const {
+        switch (interface) {
+            case 0:  // bottom
+                _bottom->scattering(location, frequencies, de_incident,
+                                    de_scattered, az_incident, az_scattered,
+                                    amplitude);
+                break;
+            case 1:  // surface
+                _surface->scattering(location, frequencies, de_incident,
+                                     de_scattered, az_incident, az_scattered,
+                                     amplitude);
+                break;
+            default:  // volume
+                auto layer = (size_t)floor(((double)interface - 2.0) / 2.0);
+                _volume.at(layer)->scattering(
+                    location, frequencies, de_incident, de_scattered,
+                    az_incident, az_scattered, amplitude);
+                break;
+        }
+    }
+
    private:
     /** Model of the ocean surface. */
     boundary_model::csptr _surface;
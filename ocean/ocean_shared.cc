@@ -2,9 +2,14 @@
  * @file ocean_shared.cc
  * Shares an ocean singleton across multiple threads.
  */
+#include <usml/ocean/boundary_forecast.h>
 #include <usml/ocean/ocean_shared.h>
+#include <usml/ocean/profile_forecast.h>
 
+#include <algorithm>
+#include <cmath>
 #include <utility>
+#include <vector>
 
 using namespace usml::ocean;
 
@@ -30,6 +35,94 @@ void ocean_shared::update(const ocean_model::csptr& ocean) {
     _current = ocean;
 }
 
+/**
+ * Move the time varying components of the shared ocean to a new time.
+ */
+ocean_model::csptr ocean_shared::update(double time) {
+    write_lock_guard guard(ocean_shared::_mutex);
+    ocean_model::csptr previous = _current;
+    if (!previous) {
+        return previous;
+    }
+
+    // replace forecast components, and share everything else
+
+    bool changed = false;
+    auto surface = previous->surface();
+    if (auto forecast =
+            std::dynamic_pointer_cast<const boundary_forecast>(surface)) {
+        surface = forecast->at(time);
+        changed = true;
+    }
+    auto bottom = previous->bottom();
+    if (auto forecast =
+            std::dynamic_pointer_cast<const boundary_forecast>(bottom)) {
+        bottom = forecast->at(time);
+        changed = true;
+    }
+    auto profile = previous->profile();
+    if (auto forecast =
+            std::dynamic_pointer_cast<const profile_forecast>(profile)) {
+        profile = forecast->at(time);
+        changed = true;
+    }
+    if (changed) {
+        std::vector<volume_model::csptr> volume;
+        for (size_t n = 0; n < previous->num_volume(); ++n) {
+            volume.push_back(previous->volume(n));
+        }
+        _current = std::make_shared<const ocean_model>(surface, bottom,
+                                                       profile, &volume);
+    }
+    return previous;
+}
+
+/**
+ * Measure the largest differences between two oceans in a column of water.
+ */
+ocean_change ocean_shared::compare(const ocean_model::csptr& previous,
+                                   const ocean_model::csptr& current,
+                                   const wposition1& location,
+                                   size_t num_depths) {
+    ocean_change change;
+    if (previous == current) {
+        return change;
+    }
+
+    // compare boundary heights
+
+    double surface1, surface2, bottom1, bottom2;
+    previous->surface()->height(location, &surface1);
+    current->surface()->height(location, &surface2);
+    previous->bottom()->height(location, &bottom1);
+    current->bottom()->height(location, &bottom2);
+    change.surface = std::abs(surface2 - surface1);
+    change.bottom = std::abs(bottom2 - bottom1);
+
+    // compare sound speed in water column
+
+    if (num_depths > 0) {
+        const double top = std::max(surface1, surface2);
+        const double deep = std::min(bottom1, bottom2);
+        wposition column(num_depths, 1);
+        for (size_t n = 0; n < num_depths; ++n) {
+            const double u = (num_depths > 1) ? n / (num_depths - 1.0) : 0.0;
+            column.rho(n, 0, top + u * (deep - top));
+            column.theta(n, 0, location.theta());
+            column.phi(n, 0, location.phi());
+        }
+        matrix<double> speed1(num_depths, 1);
+        matrix<double> speed2(num_depths, 1);
+        previous->profile()->sound_speed(column, &speed1);
+        current->profile()->sound_speed(column, &speed2);
+        for (size_t n = 0; n < num_depths; ++n) {
+            change.speed =
+                std::max(change.speed, std::abs(speed2(n, 0) - speed1(n, 0)));
+        }
+    }
+    return change;
+}
+
 /**
  * Reset the shared ocean to empty.
  */
@@ -15,6 +15,22 @@ using namespace usml::threads;
 /// @ingroup ocean_model
 /// @{
 
+/**
+ * Largest differences between two ocean models in a column of water.
+ * Computed by ocean_shared::compare() so that clients can decide whether
+ * a change in the ocean is large enough to require new acoustics.
+ */
+struct USML_DECLSPEC ocean_change {
+    /// Largest change in sound speed from surface to bottom (m/s).
+    double speed{0.0};
+
+    /// Change in the height of the ocean surface (m).
+    double surface{0.0};
+
+    /// Change in the height of the ocean bottom (m).
+    double bottom{0.0};
+};
+
 /**
  * Shares an ocean singleton across multiple threads. One thread uses
  * the update() method to publish a new ocean model.  Other
@@ -28,6 +44,14 @@ using namespace usml::threads;
  * Uses mutex locking to control multi-threaded access to the current() and
  * update() methods.  Multiple readers can access the current() simultaneously,
  * but updating the ocean using update() blocks other readers and writers.
+ *
+ * Oceans that contain time varying models, like profile_forecast and
+ * boundary_forecast, can be moved forward in time using update(time).
+ * This replaces the forecast components with new instances for that time,
+ * and re-uses all of the other components of the current ocean, so no data
+ * is reloaded. The compare() method measures the change between the old and
+ * new oceans at a specific location, so that sensors can skip the
+ * re-computation of acoustics when the local change is small.
  */
 class USML_DECLSPEC ocean_shared {
    public:
@@ -45,6 +69,34 @@ class USML_DECLSPEC ocean_shared {
      */
     static void update(const ocean_model::csptr& ocean);
 
+    /**
+     * Move the time varying components of the shared ocean to a new time.
+     * Forecast profiles and boundaries are replaced by new instances for
+     * this time, and other components are shared with the current ocean.
+     * Does nothing if the ocean has not been defined, or if it does not
+     * have any forecast components.
+     *
+     * @param   time    Time at which to evaluate forecasts (sec).
+     * @return          Ocean that was current before this update.
+     */
+    static ocean_model::csptr update(double time);
+
+    /**
+     * Measure the largest differences between two oceans in a column of
+     * water. Sound speed is compared at num_depths points that are equally
+     * spaced between the surface and the deeper of the two bottoms.
+     *
+     * @param   previous    Ocean before the change.
+     * @param   current     Ocean after the change.
+     * @param   location    Location of the water column.
+     * @param   num_depths  Number of sound speed comparisons.
+     * @return              Largest differences between the two oceans.
+     */
+    static ocean_change compare(const ocean_model::csptr& previous,
+                                const ocean_model::csptr& current,
+                                const wposition1& location,
+                                size_t num_depths = 50);
+
     /**
      * Reset the shared ocean pointer to empty.
      */
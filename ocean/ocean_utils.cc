@@ -10,13 +10,16 @@
 #include <usml/ocean/boundary_flat.h>
 #include <usml/ocean/boundary_grid.h>
 #include <usml/ocean/boundary_model.h>
+#include <usml/ocean/boundary_tiles.h>
 #include <usml/ocean/data_grid_mackenzie.h>
+#include <usml/ocean/environment_cache.h>
 #include <usml/ocean/ocean_model.h>
 #include <usml/ocean/ocean_shared.h>
 #include <usml/ocean/ocean_utils.h>
 #include <usml/ocean/profile_grid.h>
 #include <usml/ocean/profile_linear.h>
 #include <usml/ocean/profile_model.h>
+#include <usml/ocean/profile_tiles.h>
 #include <usml/ocean/reflect_loss_constant.h>
 #include <usml/ocean/reflect_loss_eckart.h>
 #include <usml/ocean/reflect_loss_model.h>
@@ -25,10 +28,32 @@
 #include <usml/ocean/scattering_constant.h>
 #include <usml/ocean/scattering_lambert.h>
 #include <usml/types/data_grid.h>
+#include <usml/types/gen_grid.h>
+
+#include <future>
+#include <memory>
+#include <string>
 
 using namespace usml::netcdf;
 using namespace usml::ocean;
 
+namespace {
+
+/**
+ * Get data path from environment or compiler variables.
+ */
+std::string data_path() {
+    const char* path =
+        std::getenv("USML_DATA_DIR");  // NOLINT(concurrency-mt-unsafe)
+    if (path == nullptr) {
+        path = USML_DATA_DIR;
+    }
+    cout << "reading shared ocean from USML_DATA_DIR=" << path << endl;
+    return std::string(path);
+}
+
+}  // namespace
+
 /**
  * Creates a isovelocity ocean with no absorption and a flat bottom.
  */
@@ -69,37 +94,48 @@ void ocean_utils::make_basic(double south, double north, double west,
 
     // get data path from environment or compiler variables
 
-    const char* path =
-        std::getenv("USML_DATA_DIR");  // NOLINT(concurrency-mt-unsafe)
-    if (path == nullptr) {
-        path = USML_DATA_DIR;
-    }
-    std::string dataPath(path);
-    cout << "reading shared ocean from USML_DATA_DIR=" << path << endl;
+    std::string dataPath = data_path();
 
     // load bathymetry from ETOPO1 database
+    // stored as float offsets from the middle of the depth range
 
     std::string bathyFile = dataPath + "/bathymetry/ETOPO1_Ice_g_gmt4.grd";
     reflect_loss_model::csptr botloss(new reflect_loss_rayleigh(bottom_type));
     scattering_model::csptr botscat(new scattering_lambert());
-    data_grid<2>::csptr grid(
-        new netcdf_bathy(bathyFile.c_str(), south, north, west, east));
+    auto grid = environment_cache<2>::find(
+        environment_cache<2>::key(bathyFile, "bathy", south, north, west,
+                                  east),
+        [&]() {
+            return data_grid<2>::csptr(gen_grid<2, double, float>::pack_grid(
+                netcdf_bathy(bathyFile.c_str(), south, north, west, east)));
+        });
     boundary_grid<2>::csptr bottom(
         new boundary_grid<2>(grid, botloss, botscat));
 
     // build sound velocity profile from World Ocean Atlas data
+    // only the derived sound speed is cached, temperature and salinity
+    // are loaded concurrently as temporaries when it is missing
 
     std::string tempFile1 = dataPath + "/woa09/temperature_seasonal_1deg.nc";
     std::string tempFile2 = dataPath + "/woa09/temperature_monthly_1deg.nc";
-    netcdf_woa::csptr temperature(new netcdf_woa(
-        tempFile1.c_str(), tempFile2.c_str(), month, south, north, west, east));
-
     std::string saltFile1 = dataPath + "/woa09/salinity_seasonal_1deg.nc";
     std::string saltFile2 = dataPath + "/woa09/salinity_monthly_1deg.nc";
-    netcdf_woa::csptr salinity(new netcdf_woa(
-        saltFile1.c_str(), saltFile2.c_str(), month, south, north, west, east));
-
-    data_grid<3>::csptr ssp(new data_grid_mackenzie(temperature, salinity));
+    auto ssp = environment_cache<3>::find(
+        environment_cache<3>::key(tempFile1 + "+" + saltFile1, "mackenzie",
+                                  south, north, west, east, month),
+        [&]() {
+            auto temp_future = std::async(std::launch::async, [&]() {
+                return data_grid<3>::csptr(
+                    new netcdf_woa(tempFile1.c_str(), tempFile2.c_str(), month,
+                                   south, north, west, east));
+            });
+            data_grid<3>::csptr salinity(
+                new netcdf_woa(saltFile1.c_str(), saltFile2.c_str(), month,
+                               south, north, west, east));
+            data_grid<3>::csptr temperature = temp_future.get();
+            return data_grid<3>::csptr(gen_grid<3, double, float>::pack_grid(
+                data_grid_mackenzie(temperature, salinity)));
+        });
     profile_grid<3>::csptr profile(new profile_grid<3>(ssp));
 
     // create shared ocean
@@ -107,3 +143,107 @@ void ocean_utils::make_basic(double south, double north, double west,
     ocean_model::csptr ocean(new ocean_model(surface, bottom, profile));
     ocean_shared::update(ocean);
 }
+
+/**
+ * Creates an ocean that loads its bathymetry and sound speed profile in
+ * tiles around the areas in use.
+ */
+void ocean_utils::make_tiled(int month, double wind_speed,
+                             bottom_type_enum bottom_type, double tile_size,
+                             size_t max_tiles) {
+    // build ocean surface model
+
+    reflect_loss_model::csptr surfloss(new reflect_loss_eckart(wind_speed));
+    scattering_model::csptr surfscat(new scattering_chapman(wind_speed));
+    boundary_model::csptr surface(new boundary_flat(0.0, surfloss, surfscat));
+
+    // stream bathymetry tiles from ETOPO1 database
+
+    std::string dataPath = data_path();
+    std::string bathyFile = dataPath + "/bathymetry/ETOPO1_Ice_g_gmt4.grd";
+    auto bathy_tiles = std::make_shared<boundary_tiles::streamer_type>(
+        [bathyFile](double south, double north, double west, double east) {
+            data_grid<2>::csptr grid(gen_grid<2, double, float>::pack_grid(
+                netcdf_bathy(bathyFile.c_str(), south, north, west, east)));
+            return boundary_model::csptr(new boundary_grid<2>(grid));
+        },
+        tile_size, 0.1, max_tiles);
+    reflect_loss_model::csptr botloss(new reflect_loss_rayleigh(bottom_type));
+    scattering_model::csptr botscat(new scattering_lambert());
+    boundary_model::csptr bottom(
+        new boundary_tiles(bathy_tiles, botloss, botscat));
+
+    // stream sound velocity profile tiles from World Ocean Atlas data
+    // WOA data is on a 1 degree grid, so overlap tiles by a full degree
+
+    std::string tempFile1 = dataPath + "/woa09/temperature_seasonal_1deg.nc";
+    std::string tempFile2 = dataPath + "/woa09/temperature_monthly_1deg.nc";
+    std::string saltFile1 = dataPath + "/woa09/salinity_seasonal_1deg.nc";
+    std::string saltFile2 = dataPath + "/woa09/salinity_monthly_1deg.nc";
+    auto profile_loader = [=](double south, double north, double west,
+                              double east) {
+        auto temp_future = std::async(std::launch::async, [&]() {
+            return data_grid<3>::csptr(new netcdf_woa(tempFile1.c_str(),
+                                                      tempFile2.c_str(), month,
+                                                      south, north, west, east));
+        });
+        data_grid<3>::csptr salinity(new netcdf_woa(saltFile1.c_str(),
+                                                    saltFile2.c_str(), month,
+                                                    south, north, west, east));
+        data_grid<3>::csptr ssp(gen_grid<3, double, float>::pack_grid(
+            data_grid_mackenzie(temp_future.get(), salinity)));
+        return profile_model::csptr(new profile_grid<3>(ssp));
+    };
+    auto ssp_tiles = std::make_shared<profile_tiles::streamer_type>(
+        profile_loader, tile_size, 1.0, max_tiles);
+    profile_model::csptr profile(new profile_tiles(ssp_tiles));
+
+    // create shared ocean
+
+    ocean_model::csptr ocean(new ocean_model(surface, bottom, profile));
+    ocean_shared::update(ocean);
+}
+
+/**
+ * Loads the tiles that overlap a disk around a location.
+ */
+void ocean_utils::stream_region(const ocean_model::csptr& ocean,
+                                const wposition1& center, double radius) {
+    if (!ocean) {
+        return;
+    }
+    if (auto bottom =
+            std::dynamic_pointer_cast<const boundary_tiles>(ocean->bottom())) {
+        bottom->streamer()->require(center, radius);
+    }
+    if (auto surface =
+            std::dynamic_pointer_cast<const boundary_tiles>(ocean->surface())) {
+        surface->streamer()->require(center, radius);
+    }
+    if (auto profile =
+            std::dynamic_pointer_cast<const profile_tiles>(ocean->profile())) {
+        profile->streamer()->require(center, radius);
+    }
+}
+
+/**
+ * Starts loading the tiles that overlap a disk around a location.
+ */
+void ocean_utils::prefetch_region(const ocean_model::csptr& ocean,
+                                  const wposition1& center, double radius) {
+    if (!ocean) {
+        return;
+    }
+    if (auto bottom =
+            std::dynamic_pointer_cast<const boundary_tiles>(ocean->bottom())) {
+        bottom->streamer()->prefetch(center, radius);
+    }
+    if (auto surface =
+            std::dynamic_pointer_cast<const boundary_tiles>(ocean->surface())) {
+        surface->streamer()->prefetch(center, radius);
+    }
+    if (auto profile =
+            std::dynamic_pointer_cast<const profile_tiles>(ocean->profile())) {
+        profile->streamer()->prefetch(center, radius);
+    }
+}
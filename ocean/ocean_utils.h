@@ -4,7 +4,11 @@
  */
 #pragma once
 
+#include <usml/ocean/ocean_model.h>
 #include <usml/ocean/reflect_loss_rayleigh.h>
+#include <usml/types/wposition1.h>
+
+#include <cstddef>
 
 namespace usml {
 namespace ocean {
@@ -32,7 +36,10 @@ class ocean_utils {
      * Creates a simple, but realistic, ocean from the databases delivered with
      * USML. Uses ETOPO1 database for bathymetry and World Ocean Atlas (WOA) for
      * sound speed profile. Uses Eckart model for surface loss and Rayleigh for
-     * bottom loss. Stores the result in the ocean_shared class.
+     * bottom loss. Stores the result in the ocean_shared class. Database
+     * extractions and the derived sound speed are shared through
+     * environment_cache, so later calls for the same area and month
+     * do not re-read the databases.
      *
      * @param south 		Minimum latitude to extract (deg).
      * @param north 		Maximum latitude to extract (deg).
@@ -46,6 +53,56 @@ class ocean_utils {
         double south, double north, double west, double east, int month,
         double wind_speed = 5,
         bottom_type_enum bottom_type = bottom_type_enum::sand);
+
+    /**
+     * Creates an ocean, from the same databases as make_basic(), that loads
+     * its bathymetry and sound speed profile in tiles around the areas in
+     * use. Tiles are loaded when they are first needed, or when
+     * stream_region() or prefetch_region() is invoked for an area, and the
+     * least recently used tiles are evicted when there are more than
+     * max_tiles of them. Stores the result in the ocean_shared class.
+     *
+     * @param month 		Month of the year for WOA extraction (1-12).
+     * @param wind_speed    Wind_speed used to develop rough seas (m/s).
+     * @param bottom_type 	Bottom type for rflect_loss_rayleigh model.
+     * @param tile_size 	Width and height of each tile (deg).
+     * @param max_tiles 	Maximum number of tiles to keep in memory for
+     *                      the bathymetry and for the profile.
+     */
+    static void make_tiled(
+        int month, double wind_speed = 5,
+        bottom_type_enum bottom_type = bottom_type_enum::sand,
+        double tile_size = 2.0, size_t max_tiles = 64);
+
+    /**
+     * Loads the tiles that overlap a disk around a location for each of the
+     * tiled components of an ocean, and waits for them to finish loading.
+     * Components that are not tiled are ignored.
+     *
+     * @param ocean         Ocean that contains the tiled components.
+     * @param center        Center of the area of interest.
+     * @param radius        Radius of the area of interest (meters).
+     */
+    static void stream_region(const ocean_model::csptr& ocean,
+                              const wposition1& center, double radius);
+
+    /**
+     * Starts loading the tiles that overlap a disk around a location for
+     * each of the tiled components of an ocean, in background threads.
+     * Returns without waiting for them to finish loading.
+     *
+     * @param ocean         Ocean that contains the tiled components.
+     * @param center        Center of the area of interest.
+     * @param radius        Radius of the area of interest (meters).
+     */
+    static void prefetch_region(const ocean_model::csptr& ocean,
+                                const wposition1& center, double radius);
+
+    /**
+     * Upper limit on the speed of sound, used to estimate the area that
+     * a wavefront can reach in its maximum propagation time (m/s).
+     */
+    static constexpr double max_speed = 1600.0;
 };
 
 /// @}
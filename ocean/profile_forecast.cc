@@ -0,0 +1,59 @@
+/**
+ * @file profile_forecast.cc
+ * Sound speed profile that interpolates between forecast epochs.
+ */
+#include <usml/ocean/profile_forecast.h>
+
+using namespace usml::ocean;
+
+/**
+ * Initialize the forecast at a specific time.
+ */
+profile_forecast::profile_forecast(const epochs_type& epochs, double time)
+    : _epochs(epochs), _time(time) {
+    _weight = _epochs.bracket(time, &_before, &_after);
+}
+
+/**
+ * Create a new model that shares the epochs of this forecast.
+ */
+profile_forecast::csptr profile_forecast::at(double time) const {
+    return std::make_shared<const profile_forecast>(_epochs, time);
+}
+
+/**
+ * Interpolate the speed of sound and it's first derivatives.
+ */
+void profile_forecast::sound_speed(const wposition& location,
+                                   matrix<double>* speed,
+                                   wvector* gradient) const {
+    _before->sound_speed(location, speed, gradient);
+    if (_before == _after || _weight <= 0.0) {
+        return;
+    }
+
+    matrix<double> next(location.size1(), location.size2());
+    if (gradient == nullptr) {
+        _after->sound_speed(location, &next);
+    } else {
+        wvector next_gradient(location.size1(), location.size2());
+        _after->sound_speed(location, &next, &next_gradient);
+        gradient->rho(gradient->rho() +
+                      _weight * (next_gradient.rho() - gradient->rho()));
+        gradient->theta(gradient->theta() +
+                        _weight * (next_gradient.theta() - gradient->theta()));
+        gradient->phi(gradient->phi() +
+                      _weight * (next_gradient.phi() - gradient->phi()));
+    }
+    noalias(*speed) += _weight * (next - *speed);
+}
+
+/**
+ * Computes the broadband absorption loss of sea water.
+ */
+void profile_forecast::attenuation(const wposition& location,
+                                   const seq_vector::csptr& frequencies,
+                                   const matrix<double>& distance,
+                                   matrix<vector<double> >* attenuation) const {
+    _before->attenuation(location, frequencies, distance, attenuation);
+}
@@ -0,0 +1,113 @@
+/**
+ * @file profile_forecast.h
+ * Sound speed profile that interpolates between forecast epochs.
+ */
+#pragma once
+
+#include <usml/ocean/forecast_epochs.h>
+#include <usml/ocean/profile_model.h>
+#include <usml/types/wposition.h>
+#include <usml/types/wvector.h>
+#include <usml/usml_config.h>
+
+namespace usml {
+namespace ocean {
+
+using namespace usml::types;
+
+/// @ingroup profiles
+/// @{
+
+/**
+ * Sound speed profile that interpolates between forecast epochs. Each
+ * epoch is a complete profile_model, like a profile_grid loaded from
+ * a forecast file. The sound speed and its gradient are computed by linear
+ * interpolation in time between the two epochs that bracket the time of
+ * this model. Times outside of the forecast use the first or last epoch.
+ *
+ * Each instance represents the ocean at a single time, so that it can be
+ * shared by threads that are propagating through that ocean. Use the at()
+ * method to create a new instance for a later time. The new instance shares
+ * the epochs of this one, so moving a forecast forward in time does not
+ * reload or copy any data. In-water attenuation is delegated to the
+ * epoch that precedes the time of this model.
+ */
+class USML_DECLSPEC profile_forecast : public profile_model {
+   public:
+    /// Shared pointer to constant version of this class.
+    typedef std::shared_ptr<const profile_forecast> csptr;
+
+    /// List of profiles indexed by forecast time.
+    typedef forecast_epochs<profile_model> epochs_type;
+
+    /**
+     * Initialize the forecast at a specific time.
+     *
+     * @param epochs    Profiles indexed by forecast time (sec).
+     * @param time      Time at which to evaluate forecast (sec).
+     * @throws std::invalid_argument if the list of epochs is empty.
+     */
+    profile_forecast(const epochs_type& epochs, double time);
+
+    /** Time at which this forecast is evaluated (sec). */
+    double time() const { return _time; }
+
+    /** Profiles indexed by forecast time. */
+    const epochs_type& epochs() const { return _epochs; }
+
+    /**
+     * Create a new model that shares the epochs of this forecast, but is
+     * evaluated at a different time.
+     *
+     * @param time      Time at which to evaluate forecast (sec).
+     * @return          Forecast profile for the new time.
+     */
+    csptr at(double time) const;
+
+    /**
+     * Interpolate the speed of sound and it's first derivatives between
+     * the epochs that bracket the time of this model.
+     *
+     * @param location      Location at which to compute sound speed.
+     * @param speed         Speed of sound (m/s) at each location (output).
+     * @param gradient      Sound speed gradient at each location (output).
+     */
+    void sound_speed(const wposition& location, matrix<double>* speed,
+                     wvector* gradient = nullptr) const override;
+
+    using profile_model::attenuation;
+
+    /**
+     * Computes the broadband absorption loss of sea water using the
+     * epoch that precedes the time of this model.
+     *
+     * @param location      Location at which to compute attenuation.
+     * @param frequencies   Frequencies over which to compute loss. (Hz)
+     * @param distance      Distance traveled through the water (meters).
+     * @param attenuation   Absorption loss of sea water in dB (output).
+     */
+    void attenuation(const wposition& location,
+                     const seq_vector::csptr& frequencies,
+                     const matrix<double>& distance,
+                     matrix<vector<double> >* attenuation) const override;
+
+   private:
+    /// Profiles indexed by forecast time.
+    const epochs_type _epochs;
+
+    /// Time at which this forecast is evaluated (sec).
+    const double _time;
+
+    /// Profile for the epoch at or before this time.
+    profile_model::csptr _before;
+
+    /// Profile for the epoch after this time.
+    profile_model::csptr _after;
+
+    /// Interpolation weight of the epoch after this time.
+    double _weight;
+};
+
+/// @}
+}  // end of namespace ocean
+}  // end of namespace usml
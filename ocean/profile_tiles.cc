@@ -0,0 +1,62 @@
+/**
+ * @file profile_tiles.cc
+ * Sound speed profile that loads its data in tiles around the areas in use.
+ */
+#include <usml/ocean/profile_tiles.h>
+
+using namespace usml::ocean;
+
+/**
+ * Compute the speed of sound and it's first derivatives at
+ * a series of locations.
+ */
+void profile_tiles::sound_speed(const wposition& location,
+                                matrix<double>* speed,
+                                wvector* gradient) const {
+    thread_local std::vector<streamer_type::tile_index> groups;
+    const bool single = _streamer->group(location, &groups);
+
+    // use whole matrix if all locations are in the same tile
+
+    if (single) {
+        _streamer->find(groups.front().first)
+            ->sound_speed(location, speed, gradient);
+        return;
+    }
+
+    // otherwise, make one call for the locations in each tile
+
+    const size_t num_cols = location.size2();
+    for (auto first = groups.begin(); first != groups.end();) {
+        auto last = first;
+        while (last != groups.end() && last->first == first->first) {
+            ++last;
+        }
+        const auto* index = &*first;
+        const size_t num = last - first;
+        wposition points(num, 1);
+        for (size_t n = 0; n < num; ++n) {
+            const size_t r = index[n].second / num_cols;
+            const size_t c = index[n].second % num_cols;
+            points.rho(n, 0, location.rho(r, c));
+            points.theta(n, 0, location.theta(r, c));
+            points.phi(n, 0, location.phi(r, c));
+        }
+        matrix<double> tile_speed(num, 1);
+        wvector tile_gradient(num, 1);
+        _streamer->find(first->first)
+            ->sound_speed(points, &tile_speed,
+                          gradient ? &tile_gradient : nullptr);
+        for (size_t n = 0; n < num; ++n) {
+            const size_t r = index[n].second / num_cols;
+            const size_t c = index[n].second % num_cols;
+            (*speed)(r, c) = tile_speed(n, 0);
+            if (gradient != nullptr) {
+                gradient->rho(r, c, tile_gradient.rho(n, 0));
+                gradient->theta(r, c, tile_gradient.theta(n, 0));
+                gradient->phi(r, c, tile_gradient.phi(n, 0));
+            }
+        }
+        first = last;
+    }
+}
@@ -0,0 +1,75 @@
+/**
+ * @file profile_tiles.h
+ * Sound speed profile that loads its data in tiles around the areas in use.
+ */
+#pragma once
+
+#include <usml/ocean/profile_model.h>
+#include <usml/ocean/tile_streamer.h>
+#include <usml/types/wposition.h>
+#include <usml/types/wvector.h>
+#include <usml/usml_config.h>
+
+#include <memory>
+
+namespace usml {
+namespace ocean {
+
+/// @ingroup profiles
+/// @{
+
+/**
+ * Sound speed profile that loads its data in tiles around the areas in use.
+ * Each tile is a separate profile_model, such as a profile_grid built from
+ * World Ocean Atlas temperature and salinity, that is loaded by a
+ * tile_streamer. Sound speeds are computed by grouping locations by tile,
+ * and making a single call to the model for each tile. In-water attenuation
+ * is provided by this model, not the tiles, so that it is consistent across
+ * tile boundaries.
+ *
+ * Use ocean_utils::stream_region() to load the tiles around a sensor before
+ * propagation starts, and to prefetch the tiles ahead of a moving platform.
+ */
+class USML_DECLSPEC profile_tiles : public profile_model {
+   public:
+    /// Shared pointer to constant version of this class.
+    typedef std::shared_ptr<const profile_tiles> csptr;
+
+    /// Loads and evicts the tiles for this profile.
+    typedef tile_streamer<profile_model> streamer_type;
+
+    /**
+     * Initialize the tiles and attenuation model for a profile.
+     *
+     * @param streamer      Loads and evicts the tiles for this profile.
+     * @param attenuation   In-water attenuation model.
+     *                      Uses Thorp model if none specified.
+     */
+    profile_tiles(const std::shared_ptr<streamer_type>& streamer,
+                  const attenuation_model::csptr& attenuation = nullptr)
+        : profile_model(attenuation), _streamer(streamer) {}
+
+    /** Loads and evicts the tiles for this profile. */
+    const std::shared_ptr<streamer_type>& streamer() const {
+        return _streamer;
+    }
+
+    /**
+     * Compute the speed of sound and it's first derivatives at
+     * a series of locations.
+     *
+     * @param location      Location at which to compute sound speed.
+     * @param speed         Speed of sound (m/s) at each location (output).
+     * @param gradient      Sound speed gradient at each location (output).
+     */
+    void sound_speed(const wposition& location, matrix<double>* speed,
+                     wvector* gradient = nullptr) const override;
+
+   private:
+    /// Loads and evicts the tiles for this profile.
+    std::shared_ptr<streamer_type> _streamer;
+};
+
+/// @}
+}  // end of namespace ocean
+}  // end of namespace usml
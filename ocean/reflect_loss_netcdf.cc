@@ -2,17 +2,23 @@
  * @file reflect_loss_netcdf.cc
  * Builds rayleigh models for an imported netcdf bottom province file.
  */
+#include <usml/netcdf/netcdf_utils.h>
 #include <usml/ocean/reflect_loss_netcdf.h>
-#include <usml/types/gen_grid.h>
+#include <usml/ocean/reflect_loss_table.h>
 
+#include <algorithm>
+#include <cmath>
 #include <exception>
+#include <mutex>
 
+using namespace usml::netcdf;
 using namespace usml::ocean;
 
 /**
  * Loads bottom province data from a netCDF formatted file.
  */
 reflect_loss_netcdf::reflect_loss_netcdf(const char* filename) {
+    std::lock_guard<std::mutex> lock(netcdf_utils::mutex());
     NcFile file(filename);
     if (file.is_valid() == 0) {
         throw std::invalid_argument("file not found");
@@ -62,42 +68,29 @@ reflect_loss_netcdf::reflect_loss_netcdf(const char* filename) {
     bot_shear_speed->get(&shearspd[0], n_types);
     bot_shear_atten->get(&shearatten[0], n_types);
 
-    // creates a sequence vector of axes that are passed to data grid
-
-    seq_vector::csptr axis[2];
-    double latinc = (latitude[latdim - 1] - latitude[0]) / double(latdim);
-    double loninc = (longitude[londim - 1] - longitude[0]) / double(londim);
-    auto* seq_lat = new seq_linear(latitude[0], latinc, int(latdim));
-    auto* seq_lon = new seq_linear(longitude[0], loninc, int(londim));
-    axis[0] = seq_vector::csptr(seq_lat);
-    axis[1] = seq_vector::csptr(seq_lon);
-
-    // creates a data grid and populates the data from the netcdf file
-
-    auto* grid = new gen_grid<2>(axis);
-    size_t index[2];
-    for (int i = 0; i < latdim; i++) {
-        for (int j = 0; j < londim; j++) {
-            index[0] = i;
-            index[1] = j;
-            grid->setdata(index, type_num[i * londim + j]);
-        }
-    }
-    _bottom_grid = data_grid<2>::csptr(grid);
+    // computes the axes of the province grid
+
+    _lat_first = latitude[0];
+    _lat_inc = (latitude[latdim - 1] - latitude[0]) / double(latdim);
+    _lat_num = size_t(latdim);
+    _lng_first = longitude[0];
+    _lng_inc = (longitude[londim - 1] - longitude[0]) / double(londim);
+    _lng_num = size_t(londim);
 
-    // set the interpolation type to the nearest neighbor and restrict extrap
+    // stores the province numbers for direct lookup of the nearest grid point
 
-    for (int i = 0; i < 2; i++) {
-        grid->interp_type(i, interp_enum::nearest);
-        grid->edge_limit(i, true);
+    _province.resize(latdim * londim);
+    for (long n = 0; n < latdim * londim; ++n) {
+        _province[n] = (size_t)type_num[n];
     }
 
-    // builds a vector of reflect_loss_rayleigh for all bottom province numbers
+    // builds a table of Rayleigh loss and phase for each bottom province
 
     for (int i = 0; i < int(n_types); i++) {
-        auto* model = new reflect_loss_rayleigh(density[i], speed[i], atten[i],
-                                                shearspd[i], shearatten[i]);
-        _loss_model.push_back(reflect_loss_model::csptr(model));
+        auto model = reflect_loss_model::csptr(new reflect_loss_rayleigh(
+            density[i], speed[i], atten[i], shearspd[i], shearatten[i]));
+        _loss_model.push_back(
+            reflect_loss_model::csptr(new reflect_loss_table(model)));
     }
 
     ncclose(ncid);
@@ -115,23 +108,31 @@ reflect_loss_netcdf::reflect_loss_netcdf(const char* filename) {
  * Gets a Rayleigh reflection loss value for the bottom province number
  * at a specific location then computes the broadband reflection loss and phase
  * change.
- *
- * @param location      Location at which to compute attenuation.
- * @param frequencies   Frequencies over which to compute loss. (Hz)
- * @param angle         Reflection angle relative to the normal (radians).
- * @param amplitude     Change in ray strength in dB (output).
- * @param phase         Change in ray phase in radians (output).
- *                      Phase change not computed if this is nullptr.
  */
 void reflect_loss_netcdf::reflect_loss(const wposition1& location,
                                        const seq_vector::csptr& frequencies,
                                        double angle, vector<double>* amplitude,
                                        vector<double>* phase) const {
-    double loc[2];
-    loc[0] = location.latitude();
-    loc[1] = location.longitude();
-
-    auto type = (size_t)_bottom_grid->interpolate(loc);
+    const size_t row = nearest(location.latitude(), _lat_first, _lat_inc,
+                               _lat_num);
+    const size_t col = nearest(location.longitude(), _lng_first, _lng_inc,
+                               _lng_num);
+    const size_t type = _province[row * _lng_num + col];
     _loss_model[type]->reflect_loss(location, frequencies, angle, amplitude,
                                     phase);
 }
+
+/**
+ * Index of the nearest point on a uniformly spaced axis.
+ */
+size_t reflect_loss_netcdf::nearest(double value, double first, double inc,
+                                    size_t num) {
+    if (num < 2) {
+        return 0;
+    }
+    const double last = first + inc * double(num - 1);
+    value = std::clamp(value, std::min(first, last), std::max(first, last));
+    const double u = (value - first) / inc;
+    const auto k = std::min(num - 2, (size_t)std::max(0.0, std::floor(u)));
+    return (u - double(k) < 0.5) ? k : k + 1;
+}
@@ -7,8 +7,9 @@
 #include <netcdfcpp.h>
 #include <usml/ocean/reflect_loss_model.h>
 #include <usml/ocean/reflect_loss_rayleigh.h>
-#include <usml/types/gen_grid.h>
+#include <usml/types/seq_vector.h>
 
+#include <cstddef>
 #include <vector>
 
 namespace usml {
@@ -70,6 +71,11 @@ using boost::numeric::ublas::vector;
  *    0, 1, 1, 1, 1, 1, 1, 1, 1, 1 ;
  *   }
  * </pre>
+ *
+ * The Rayleigh loss and phase of each province are tabulated as a function
+ * of angle by reflect_loss_table when the file is loaded, and the province
+ * at each location is found by a direct calculation of the nearest grid
+ * index. This reduces the cost of each bounce to a table interpolation.
  */
 class USML_DECLSPEC reflect_loss_netcdf : public reflect_loss_model {
    public:
@@ -106,10 +112,38 @@ class USML_DECLSPEC reflect_loss_netcdf : public reflect_loss_model {
      */
     std::vector<reflect_loss_model::csptr> _loss_model;
 
+    /// Bottom province number at each latitude and longitude.
+    std::vector<size_t> _province;
+
+    /// First latitude in the province grid (degrees).
+    double _lat_first;
+
+    /// Spacing between latitudes in the province grid (degrees).
+    double _lat_inc;
+
+    /// Number of latitudes in the province grid.
+    size_t _lat_num;
+
+    /// First longitude in the province grid (degrees).
+    double _lng_first;
+
+    /// Spacing between longitudes in the province grid (degrees).
+    double _lng_inc;
+
+    /// Number of longitudes in the province grid.
+    size_t _lng_num;
+
     /**
-     * Data grid that stores all of the bottom province information.
+     * Index of the nearest point on a uniformly spaced axis. Values
+     * outside of the axis are limited to the first or last point.
+     *
+     * @param value     Value to search for.
+     * @param first     First value of the axis.
+     * @param inc       Spacing between axis values.
+     * @param num       Number of points on the axis.
+     * @return          Index of the nearest point.
      */
-    data_grid<2>::csptr _bottom_grid;
+    static size_t nearest(double value, double first, double inc, size_t num);
 };
 
 /// @}
@@ -4,6 +4,7 @@
  */
 
 #include <usml/ocean/reflect_loss_rayleigh_grid.h>
+#include <usml/ocean/reflect_loss_table.h>
 
 #include <memory>
 #include <utility>
@@ -29,12 +30,13 @@ reflect_loss_rayleigh_grid::reflect_loss_rayleigh_grid(
         type_grid->edge_limit(i, true);
     }
 
-    // builds a vector of reflect_loss_rayleigh values for all bottom types
+    // builds a table of reflect_loss_rayleigh values for all bottom types
 
     auto num_types = size_t(bottom_type_enum::basalt);
     for (size_t i = 0; i <= num_types; i++) {
-        auto model = reflect_loss_rayleigh::csptr(new reflect_loss_rayleigh(i));
-        _rayleigh.push_back(model);
+        auto model = reflect_loss_model::csptr(new reflect_loss_rayleigh(i));
+        _rayleigh.push_back(
+            reflect_loss_model::csptr(new reflect_loss_table(model)));
     }
 }
 
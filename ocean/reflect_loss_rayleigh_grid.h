@@ -27,6 +27,8 @@ using boost::numeric::ublas::vector;
  * The reflect_loss_rayleigh_grid object ingests a data_grid of Rayleigh
  * bottom type data and creates a reflect_loss_rayleigh object to
  * compute reflection loss using the type number at each location.
+ * The loss and phase of each bottom type are tabulated as a function of
+ * angle by reflect_loss_table when this model is constructed.
  */
 class USML_DECLSPEC reflect_loss_rayleigh_grid : public reflect_loss_model {
    public:
@@ -59,7 +61,7 @@ class USML_DECLSPEC reflect_loss_rayleigh_grid : public reflect_loss_model {
     /**
      * Stored Rayleigh models for bottom reflections
      */
-    std::vector<reflect_loss_rayleigh::csptr> _rayleigh;
+    std::vector<reflect_loss_model::csptr> _rayleigh;
 
     /**
      * Data grid that stores all of the bottom province information.
@@ -0,0 +1,59 @@
+/**
+ * @file reflect_loss_table.cc
+ * Tabulated version of a frequency independent reflection loss model.
+ */
+#include <usml/ocean/reflect_loss_table.h>
+#include <usml/types/seq_linear.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace usml::ocean;
+
+/**
+ * Tabulate the reflection loss of another model.
+ */
+reflect_loss_table::reflect_loss_table(const reflect_loss_model::csptr& model,
+                                       size_t num_angles)
+    : _increment(M_PI_2 / double(num_angles - 1)),
+      _amplitude(num_angles),
+      _phase(num_angles) {
+    const wposition1 location;
+    const seq_vector::csptr frequency(new seq_linear(1000.0, 1.0, 1));
+    vector<double> amplitude(1);
+    vector<double> phase(1);
+    for (size_t n = 0; n < num_angles; ++n) {
+        const double angle = (n + 1 < num_angles) ? n * _increment : M_PI_2;
+        model->reflect_loss(location, frequency, angle, &amplitude, &phase);
+        _amplitude[n] = amplitude(0);
+        _phase[n] = phase(0);
+
+        // unwrap phase jumps between -PI and PI
+
+        if (n > 0) {
+            _phase[n] -=
+                TWO_PI * std::round((_phase[n] - _phase[n - 1]) / TWO_PI);
+        }
+    }
+}
+
+/**
+ * Interpolates the broadband reflection loss and phase change.
+ */
+void reflect_loss_table::reflect_loss(const wposition1& /*location*/,
+                                      const seq_vector::csptr& frequencies,
+                                      double angle, vector<double>* amplitude,
+                                      vector<double>* phase) const {
+    const double u = std::clamp(angle, 0.0, M_PI_2) / _increment;
+    const auto n = std::min(size_t(u), _amplitude.size() - 2);
+    const double w = u - double(n);
+    const size_t num = frequencies->size();
+
+    const double loss = _amplitude[n] + w * (_amplitude[n + 1] - _amplitude[n]);
+    std::fill(amplitude->begin(), amplitude->begin() + num, loss);
+    if (phase != nullptr) {
+        const double value = std::remainder(
+            _phase[n] + w * (_phase[n + 1] - _phase[n]), TWO_PI);
+        std::fill(phase->begin(), phase->begin() + num, value);
+    }
+}
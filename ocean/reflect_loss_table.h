@@ -0,0 +1,79 @@
+/**
+ * @file reflect_loss_table.h
+ * Tabulated version of a frequency independent reflection loss model.
+ */
+#pragma once
+
+#include <usml/ocean/reflect_loss_model.h>
+#include <usml/types/seq_vector.h>
+#include <usml/types/wposition1.h>
+#include <usml/usml_config.h>
+
+#include <boost/numeric/ublas/vector.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace usml {
+namespace ocean {
+
+using boost::numeric::ublas::vector;
+
+/// @ingroup boundaries
+/// @{
+
+/**
+ * Tabulated version of a frequency independent reflection loss model.
+ * Evaluates the amplitude and phase of another model on a uniformly spaced
+ * set of angles when it is constructed, and then uses linear interpolation
+ * to estimate the reflection loss at each bounce. This replaces the complex
+ * impedance calculations of models like reflect_loss_rayleigh with a
+ * handful of multiplies per bounce.
+ *
+ * Only suitable for models, like reflect_loss_rayleigh, whose loss does not
+ * depend on frequency or location, because the wrapped model is only
+ * evaluated at a single frequency and location. The phase is unwrapped
+ * before interpolation, so that the table does not smear jumps between
+ * -PI and PI.
+ */
+class USML_DECLSPEC reflect_loss_table : public reflect_loss_model {
+   public:
+    /**
+     * Tabulate the reflection loss of another model.
+     *
+     * @param model         Frequency independent model to tabulate.
+     * @param num_angles    Number of angles in the table, uniformly spaced
+     *                      from 0 to PI/2 radians.
+     */
+    reflect_loss_table(const reflect_loss_model::csptr& model,
+                       size_t num_angles = 3601);
+
+    /**
+     * Interpolates the broadband reflection loss and phase change
+     * from the table. Angles are limited to the range [0,PI/2].
+     *
+     * @param location      Location at which to compute attenuation.
+     * @param frequencies   Frequencies over which to compute loss. (Hz)
+     * @param angle         Reflection angle relative to the normal (radians).
+     * @param amplitude     Change in ray strength in dB (output).
+     * @param phase         Change in ray phase in radians (output).
+     *                      Phase change not computed if this is nullptr.
+     */
+    void reflect_loss(const wposition1& location,
+                      const seq_vector::csptr& frequencies, double angle,
+                      vector<double>* amplitude,
+                      vector<double>* phase = nullptr) const override;
+
+   private:
+    /// Spacing between angles in the table (radians).
+    double _increment;
+
+    /// Reflection loss at each angle (dB).
+    std::vector<double> _amplitude;
+
+    /// Unwrapped phase change at each angle (radians).
+    std::vector<double> _phase;
+};
+
+/// @}
+}  // end of namespace ocean
+}  // end of namespace usml
@@ -110,6 +110,57 @@ class USML_DECLSPEC scattering_chapman : public scattering_model {
         }
     }
 
+    /**
+     * Computes the broadband scattering strength for a batch of independent
+     * scattering geometries. The frequency dependent terms are computed once
+     * for the whole batch, which leaves a single log10() per geometry and
+     * a single exp() per output.
+     *
+     * @param location      Location of each scattering geometry.
+     * @param frequencies   Frequencies over which to compute loss. (Hz)
+     * @param de_incident   Depression incident angle of each geometry (radians).
+     * @param de_scattered  Depression scattered angle of each geometry
+     *                      (radians).
+     * @param az_incident   Azimuthal incident angle of each geometry (radians).
+     * @param az_scattered  Azimuthal scattered angle of each geometry
+     *                      (radians).
+     * @param amplitude     Reverberation scattering strength ratio for
+     *                      each geometry and frequency (output).
+     */
+    void scattering(const std::vector<wposition1>& location,
+                    const seq_vector::csptr& frequencies,
+                    const vector<double>& de_incident,
+                    const vector<double>& de_scattered,
+                    const vector<double>& az_incident,
+                    const vector<double>& az_scattered,
+                    matrix<double>* amplitude) const override {
+        const size_t num_pairs = location.size();
+        const size_t num_freq = frequencies->size();
+        amplitude->resize(num_pairs, num_freq, false);
+
+        // compute frequency dependent terms, in dB, once for whole batch
+
+        const vector<double> freq = frequencies->data();
+        const auto speed = _wind_speed * 1.94384449;
+        const vector<double> beta =
+            158.0 * pow(speed * pow(freq, 1.0 / 3.0), -0.58);
+        const vector<double> offset = 2.6 - 42.4 * log10(beta);
+        const vector<double> slope = 3.3 * beta;
+
+        // convert dB to linear units using exp(x * ln(10)/10)
+
+        const double scale = M_LN10 / 10.0;
+        double* out = &amplitude->data()[0];
+        for (size_t n = 0; n < num_pairs; ++n, out += num_freq) {
+            const double grazing =
+                0.5 * (de_incident(n) + de_scattered(n)) * 180.0 / M_PI;
+            const double angle = log10(grazing / 30.0 + 1e-6);
+            for (size_t f = 0; f < num_freq; ++f) {
+                out[f] = exp(scale * (offset(f) + slope(f) * angle));
+            }
+        }
+    }
+
    private:
     /// Wind speed (m/s).
     const double _wind_speed;
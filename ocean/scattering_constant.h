@@ -6,6 +6,8 @@
 
 #include <usml/ocean/scattering_model.h>
 
+#include <algorithm>
+
 namespace usml {
 namespace ocean {
 
@@ -79,6 +81,34 @@ class USML_DECLSPEC scattering_constant : public scattering_model {
         // fast assignment of scalar to matrix of vectors
     }
 
+    /**
+     * Computes the broadband scattering strength for a batch of independent
+     * scattering geometries. Every element of the result is the same
+     * constant value.
+     *
+     * @param location      Location of each scattering geometry.
+     * @param frequencies   Frequencies over which to compute loss. (Hz)
+     * @param de_incident   Depression incident angle of each geometry (radians).
+     * @param de_scattered  Depression scattered angle of each geometry
+     *                      (radians).
+     * @param az_incident   Azimuthal incident angle of each geometry (radians).
+     * @param az_scattered  Azimuthal scattered angle of each geometry
+     *                      (radians).
+     * @param amplitude     Reverberation scattering strength ratio for
+     *                      each geometry and frequency (output).
+     */
+    void scattering(const std::vector<wposition1>& location,
+                    const seq_vector::csptr& frequencies,
+                    const vector<double>& de_incident,
+                    const vector<double>& de_scattered,
+                    const vector<double>& az_incident,
+                    const vector<double>& az_scattered,
+                    matrix<double>* amplitude) const override {
+        amplitude->resize(location.size(), frequencies->size(), false);
+        std::fill(amplitude->data().begin(), amplitude->data().end(),
+                  _amplitude);
+    }
+
    private:
     /** Holds the reverberation scattering strength ratio. */
     double _amplitude;
@@ -6,6 +6,8 @@
 
 #include <usml/ocean/scattering_model.h>
 
+#include <algorithm>
+
 namespace usml {
 namespace ocean {
 
@@ -102,6 +104,40 @@ class USML_DECLSPEC scattering_lambert : public scattering_model {
         }
     }
 
+    /**
+     * Computes the broadband scattering strength for a batch of independent
+     * scattering geometries. Results are independent of frequency, so each
+     * row is filled with a single value.
+     *
+     * @param location      Location of each scattering geometry.
+     * @param frequencies   Frequencies over which to compute loss. (Hz)
+     * @param de_incident   Depression incident angle of each geometry (radians).
+     * @param de_scattered  Depression scattered angle of each geometry
+     *                      (radians).
+     * @param az_incident   Azimuthal incident angle of each geometry (radians).
+     * @param az_scattered  Azimuthal scattered angle of each geometry
+     *                      (radians).
+     * @param amplitude     Reverberation scattering strength ratio for
+     *                      each geometry and frequency (output).
+     */
+    void scattering(const std::vector<wposition1>& location,
+                    const seq_vector::csptr& frequencies,
+                    const vector<double>& de_incident,
+                    const vector<double>& de_scattered,
+                    const vector<double>& az_incident,
+                    const vector<double>& az_scattered,
+                    matrix<double>* amplitude) const override {
+        const size_t num_pairs = location.size();
+        const size_t num_freq = frequencies->size();
+        amplitude->resize(num_pairs, num_freq, false);
+        double* out = &amplitude->data()[0];
+        for (size_t n = 0; n < num_pairs; ++n, out += num_freq) {
+            const double value =
+                abs(_coeff * sin(de_incident(n)) * sin(de_scattered(n)));
+            std::fill(out, out + num_freq, value);
+        }
+    }
+
    private:
     /**
      * Bottom scattering strength coefficient in linear units.
@@ -7,6 +7,8 @@
 #include <usml/types/types.h>
 #include <usml/ublas/ublas.h>
 
+#include <vector>
+
 namespace usml {
 namespace ocean {
 
@@ -98,6 +100,45 @@ class USML_DECLSPEC scattering_model {
                             double az_incident, matrix<double> az_scattered,
                             matrix<vector<double> >* amplitude) const = 0;
 
+    /**
+     * Computes the broadband scattering strength for a batch of independent
+     * scattering geometries. Each geometry has its own location, incident
+     * angles, and scattered angles. Results are packed into a matrix with
+     * one row for each geometry and one column for each frequency, so that
+     * callers can process all of the pairs for an eigenverb with a single
+     * virtual call. The default implementation calls the single location
+     * version for each geometry. Models should override it with a loop that
+     * only computes the frequency dependent terms once.
+     *
+     * @param location      Location of each scattering geometry.
+     * @param frequencies   Frequencies over which to compute loss. (Hz)
+     * @param de_incident   Depression incident angle of each geometry (radians).
+     * @param de_scattered  Depression scattered angle of each geometry
+     *                      (radians).
+     * @param az_incident   Azimuthal incident angle of each geometry (radians).
+     * @param az_scattered  Azimuthal scattered angle of each geometry
+     *                      (radians).
+     * @param amplitude     Reverberation scattering strength ratio for
+     *                      each geometry and frequency (output).
+     */
+    virtual void scattering(const std::vector<wposition1>& location,
+                            const seq_vector::csptr& frequencies,
+                            const vector<double>& de_incident,
+                            const vector<double>& de_scattered,
+                            const vector<double>& az_incident,
+                            const vector<double>& az_scattered,
+                            matrix<double>* amplitude) const {
+        const size_t num_pairs = location.size();
+        amplitude->resize(num_pairs, frequencies->size(), false);
+        vector<double> value(frequencies->size());
+        for (size_t n = 0; n < num_pairs; ++n) {
+            scattering(location[n], frequencies, de_incident(n),
+                       de_scattered(n), az_incident(n), az_scattered(n),
+                       &value);
+            row(*amplitude, n) = value;
+        }
+    }
+
     /**
      * Virtual destructor
      */
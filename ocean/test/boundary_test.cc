@@ -4,10 +4,14 @@
 #include <usml/netcdf/netcdf_bathy.h>
 #include <usml/ocean/ascii_arc_bathy.h>
 #include <usml/ocean/boundary_flat.h>
+#include <usml/ocean/boundary_forecast.h>
 #include <usml/ocean/boundary_grid.h>
 #include <usml/ocean/boundary_model.h>
 #include <usml/ocean/boundary_slope.h>
+#include <usml/ocean/boundary_tiles.h>
+#include <usml/ocean/mmap_bathy.h>
 #include <usml/ocean/ocean_model.h>
+#include <usml/ocean/ocean_shared.h>
 #include <usml/ocean/profile_linear.h>
 #include <usml/ocean/profile_model.h>
 #include <usml/ocean/scattering_chapman.h>
@@ -17,7 +21,12 @@
 #include <usml/types/types.h>
 
 #include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
 #include <fstream>
+#include <iterator>
+#include <string>
 
 BOOST_AUTO_TEST_SUITE(boundary_test)
 
@@ -322,6 +331,114 @@ BOOST_AUTO_TEST_CASE(ascii_arc_test) {
     BOOST_CHECK_CLOSE(wposition::earth_radius - depth, 681.0, 0.3);
 }
 
+/**
+ * Test the binary sidecar cache for ASCII ARC bathymetry. Copies the
+ * small_crm.asc file to the test directory, and loads it twice with the
+ * sidecar size limit turned off. The first load parses the ASCII file and
+ * writes the sidecar. The second load reads the sidecar.
+ *
+ * This test passes if:
+ *   - the sidecar is created by the first load
+ *   - both loads produce the same axes and depths
+ */
+BOOST_AUTO_TEST_CASE(ascii_arc_sidecar_test) {
+    cout << "=== boundary_test: ascii_arc_sidecar_test ===" << endl;
+    const char* filename = USML_TEST_DIR "/ocean/test/sidecar_crm.asc";
+    const std::string sidecar = ascii_arc_bathy::sidecar_name(filename);
+    std::remove(sidecar.c_str());
+    {
+        std::ifstream source(USML_DATA_DIR "/arcascii/small_crm.asc",
+                             std::ios::binary);
+        std::ofstream copy(filename, std::ios::binary);
+        copy << source.rdbuf();
+    }
+
+    const size_t sidecar_size = ascii_arc_bathy::sidecar_size;
+    ascii_arc_bathy::sidecar_size = 0;
+    ascii_arc_bathy first(filename);
+    BOOST_CHECK(std::ifstream(sidecar).good());
+    ascii_arc_bathy second(filename);
+    ascii_arc_bathy::sidecar_size = sidecar_size;
+
+    for (size_t n = 0; n < 2; ++n) {
+        BOOST_CHECK_EQUAL(second.axis(n).size(), first.axis(n).size());
+        BOOST_CHECK_EQUAL(second.axis(n)(0), first.axis(n)(0));
+    }
+    const size_t N = first.axis(0).size() * first.axis(1).size();
+    BOOST_CHECK(std::equal(first.data(), first.data() + N, second.data()));
+    size_t index[2] = {240, 240};
+    BOOST_CHECK_CLOSE(wposition::earth_radius - second.data(index), 747.0,
+                      1e-6);
+}
+
+/**
+ * Test the conversion of ASCII ARC bathymetry into the memory mapped format.
+ * Writes the small_crm.asc grid to a binary file, maps it back into memory,
+ * and compares the depths and interpolated values of the two grids.
+ * Also checks that the mapped grid can not be modified, and that files
+ * with the wrong byte order or version are rejected.
+ * Generate errors if values differ by more that 1E-6 percent.
+ */
+BOOST_AUTO_TEST_CASE(mmap_bathy_test) {
+    cout << "=== boundary_test: mmap_bathy_test ===" << endl;
+    const char* filename = USML_TEST_DIR "/ocean/test/small_crm.bty";
+    const char* badname = USML_TEST_DIR "/ocean/test/small_crm_bad.bty";
+    auto source = data_grid<2>::sptr(
+        new ascii_arc_bathy(USML_DATA_DIR "/arcascii/small_crm.asc"));
+    mmap_bathy::write(filename, *source);
+    auto grid = data_grid<2>::sptr(new mmap_bathy(filename));
+
+    for (size_t n = 0; n < 2; ++n) {
+        BOOST_CHECK_EQUAL(grid->axis(n).size(), source->axis(n).size());
+        BOOST_CHECK_CLOSE(grid->axis(n)(0), source->axis(n)(0), 1e-6);
+        BOOST_CHECK_CLOSE(grid->axis(n)(grid->axis(n).size() - 1),
+                          source->axis(n)(source->axis(n).size() - 1), 1e-6);
+    }
+    size_t index[2];
+    for (index[0] = 0; index[0] < grid->axis(0).size(); index[0] += 60) {
+        for (index[1] = 0; index[1] < grid->axis(1).size(); index[1] += 60) {
+            BOOST_CHECK_EQUAL(grid->data(index), source->data(index));
+        }
+    }
+
+    // test implementation as a boundary model
+
+    boundary_grid<2> bottom(grid);
+    wposition1 location(29.4361, -79.7862);
+    double depth;
+    bottom.height(location, &depth);
+    BOOST_CHECK_CLOSE(wposition::earth_radius - depth, 700.0, 0.3);
+
+    // reject changes to the read-only mapping
+
+    mmap_bathy mapped(filename);
+    index[0] = index[1] = 0;
+    BOOST_CHECK_THROW(mapped.setdata(index, 0.0), std::logic_error);
+
+    // reject files that are not in the binary format
+
+    BOOST_CHECK_THROW(mmap_bathy(USML_DATA_DIR "/arcascii/small_crm.asc"),
+                      std::invalid_argument);
+
+    // reject files written with a different byte order or version, by
+    // changing the header fields that follow the identifier
+
+    std::string bytes;
+    {
+        std::ifstream stream(filename, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(stream),
+                     std::istreambuf_iterator<char>());
+    }
+    std::string swapped = bytes;
+    std::reverse(swapped.begin() + 8, swapped.begin() + 12);
+    std::ofstream(badname, std::ios::binary) << swapped;
+    BOOST_CHECK_THROW(mmap_bathy bad(badname), std::invalid_argument);
+    std::string newer = bytes;
+    newer[12] = char(newer[12] + 1);
+    std::ofstream(badname, std::ios::binary) << newer;
+    BOOST_CHECK_THROW(mmap_bathy bad(badname), std::invalid_argument);
+}
+
 /**
  * Computes the broad spectrum scattering strength from a flat
  * ocean bottom, using Lambert's law.
@@ -393,6 +510,183 @@ BOOST_AUTO_TEST_CASE(scattering_chapman_test) {
     }
 }
 
+/**
+ * Compares the batch scattering strength calculation to the single location
+ * version for each interface of an ocean model. Uses the Lambert model for
+ * the bottom, the Chapman/Harris model for the surface, and a constant
+ * volume scattering strength.
+ */
+BOOST_AUTO_TEST_CASE(scattering_batch_test) {
+    cout << "=== boundary_test: scattering_batch_test ===" << endl;
+
+    auto* surface = new boundary_flat();
+    surface->scattering(scattering_model::csptr(new scattering_chapman(7.5)));
+    auto* bottom = new boundary_flat(2000.0);
+    bottom->scattering(scattering_model::csptr(new scattering_lambert()));
+    profile_model::csptr profile(new profile_linear());
+    ocean_model ocean(boundary_model::csptr(surface),
+                      boundary_model::csptr(bottom), profile);
+    ocean.add_volume(volume_model::csptr(new volume_flat(1000.0, 10.0, -30.0)));
+
+    seq_vector::csptr freq(new seq_log(600.0, 2.0, 4));
+    const size_t num_pairs = 20;
+    std::vector<wposition1> location(num_pairs, wposition1(45.0, -45.0));
+    vector<double> de_incident(num_pairs);
+    vector<double> de_scattered(num_pairs);
+    vector<double> az_incident(num_pairs);
+    vector<double> az_scattered(num_pairs);
+    for (size_t n = 0; n < num_pairs; ++n) {
+        de_incident(n) = to_radians(1.0 + 4.0 * n);
+        de_scattered(n) = to_radians(80.0 - 3.0 * n);
+        az_incident(n) = to_radians(10.0 * n);
+        az_scattered(n) = to_radians(5.0 * n);
+    }
+
+    matrix<double> batch;
+    vector<double> single(freq->size());
+    for (size_t interface = 0; interface < 3; ++interface) {
+        ocean.scattering(interface, location, freq, de_incident, de_scattered,
+                         az_incident, az_scattered, &batch);
+        BOOST_REQUIRE_EQUAL(batch.size1(), num_pairs);
+        BOOST_REQUIRE_EQUAL(batch.size2(), freq->size());
+        for (size_t n = 0; n < num_pairs; ++n) {
+            ocean.scattering(interface, location[n], freq, de_incident(n),
+                             de_scattered(n), az_incident(n), az_scattered(n),
+                             &single);
+            for (size_t f = 0; f < freq->size(); ++f) {
+                BOOST_CHECK_CLOSE(batch(n, f), single(f), 1e-8);
+            }
+        }
+    }
+}
+
+/**
+ * Test a tidal change in water depth using a bottom forecast. Moves the
+ * shared ocean forward in time, and checks that the bottom depth is
+ * interpolated between epochs, that the other ocean components are shared
+ * with the previous ocean, and that compare() measures the change in depth.
+ */
+BOOST_AUTO_TEST_CASE(boundary_forecast_test) {
+    cout << "=== boundary_test: boundary_forecast_test ===" << endl;
+    boundary_forecast::epochs_type::epoch_map epochs;
+    epochs[0.0] = boundary_model::csptr(new boundary_flat(1000.0));
+    epochs[21600.0] = boundary_model::csptr(new boundary_flat(1002.0));
+
+    boundary_model::csptr surface(new boundary_flat());
+    boundary_model::csptr bottom(new boundary_forecast(epochs, 0.0));
+    profile_model::csptr profile(new profile_linear());
+    ocean_shared::update(ocean_model::csptr(
+        new ocean_model(surface, bottom, profile)));
+
+    // move ocean forward to half tide
+
+    auto previous = ocean_shared::update(10800.0);
+    auto current = ocean_shared::current();
+    BOOST_CHECK(previous != current);
+    BOOST_CHECK(current->surface() == surface);
+    BOOST_CHECK(current->profile() == profile);
+
+    const wposition1 location(36.0, 16.0);
+    double rho;
+    wvector1 normal;
+    current->bottom()->height(location, &rho, &normal);
+    BOOST_CHECK_CLOSE(wposition::earth_radius - rho, 1001.0, 1e-6);
+    BOOST_CHECK_CLOSE(normal.rho(), 1.0, 1e-6);
+
+    auto change = ocean_shared::compare(previous, current, location);
+    BOOST_CHECK_CLOSE(change.bottom, 1.0, 1e-6);
+    BOOST_CHECK_SMALL(change.surface, 1e-10);
+    BOOST_CHECK_SMALL(change.speed, 1e-10);
+    ocean_shared::reset();
+}
+
+/**
+ * Test the loading and eviction of bathymetry tiles. Each tile is a flat
+ * bottom whose depth encodes the south-west corner of the tile, so that the
+ * test can check which tile was used for each location. Checks that
+ * require() loads all of the tiles around a location, that heights across
+ * tile edges come from the correct tiles, and that the least recently
+ * used tiles are evicted when there are more than max_tiles of them,
+ * unless they are pinned by a query that is still using them.
+ */
+BOOST_AUTO_TEST_CASE(boundary_tiles_test) {
+    cout << "=== boundary_test: boundary_tiles_test ===" << endl;
+    std::atomic<int> num_loads{0};
+    auto streamer = std::make_shared<boundary_tiles::streamer_type>(
+        [&](double south, double, double west, double) {
+            ++num_loads;
+            const double depth = 1000.0 + 10.0 * std::round(south + 0.1) +
+                                 std::round(west + 0.1);
+            return boundary_model::csptr(new boundary_flat(depth));
+        },
+        1.0, 0.1, 8);
+    boundary_tiles bottom(streamer);
+
+    // load the 4 tiles around a corner
+
+    const double radius = 20e3;
+    streamer->require(wposition1(36.0, 16.0), radius);
+    BOOST_CHECK_EQUAL(streamer->size(), 4);
+    BOOST_CHECK_EQUAL(num_loads, 4);
+
+    wposition points(2, 2);
+    points.latitude(0, 0, 35.9);
+    points.longitude(0, 0, 15.9);
+    points.latitude(0, 1, 35.9);
+    points.longitude(0, 1, 16.1);
+    points.latitude(1, 0, 36.1);
+    points.longitude(1, 0, 15.9);
+    points.latitude(1, 1, 36.1);
+    points.longitude(1, 1, 16.1);
+    points.altitude(scalar_matrix<double>(2, 2, 0.0));
+    matrix<double> rho(2, 2);
+    wvector normal(2, 2);
+    bottom.height(points, &rho, &normal);
+    BOOST_CHECK_CLOSE(wposition::earth_radius - rho(0, 0), 1365.0, 1e-6);
+    BOOST_CHECK_CLOSE(wposition::earth_radius - rho(0, 1), 1366.0, 1e-6);
+    BOOST_CHECK_CLOSE(wposition::earth_radius - rho(1, 0), 1375.0, 1e-6);
+    BOOST_CHECK_CLOSE(wposition::earth_radius - rho(1, 1), 1376.0, 1e-6);
+    BOOST_CHECK_CLOSE(normal.rho(1, 1), 1.0, 1e-6);
+    BOOST_CHECK_EQUAL(num_loads, 4);
+
+    // load a tile on demand
+
+    double depth;
+    bottom.height(wposition1(-10.5, -20.5), &depth);
+    BOOST_CHECK_CLOSE(wposition::earth_radius - depth, 1000.0 - 110.0 - 21.0,
+                      1e-6);
+    BOOST_CHECK_EQUAL(num_loads, 5);
+
+    // evict the oldest tiles when moving to a new area
+
+    streamer->require(wposition1(40.5, 20.5), 100e3);
+    BOOST_CHECK_LE(streamer->size(), 9);
+    streamer->require(wposition1(50.5, 30.5), radius);
+    BOOST_CHECK_LE(streamer->size(), 8);
+    const int loads = num_loads;
+    streamer->require(wposition1(36.0, 16.0), radius);
+    BOOST_CHECK_EQUAL(num_loads, loads + 4);
+
+    // prefetch tiles in the background
+
+    streamer->reset();
+    streamer->prefetch(wposition1(0.5, 0.5), radius);
+    streamer->require(wposition1(0.5, 0.5), radius);
+    BOOST_CHECK_EQUAL(streamer->size(), 1);
+    BOOST_CHECK_EQUAL(num_loads, loads + 5);
+
+    // tiles pinned by a query in progress are not evicted
+
+    auto pinned = streamer->find(60.5, 40.5);
+    streamer->require(wposition1(70.5, 50.5), 100e3);
+    BOOST_CHECK(streamer->find(60.5, 40.5) == pinned);
+    pinned.reset();
+    streamer->require(wposition1(-70.5, -50.5), 100e3);
+    const int unpinned_loads = num_loads;
+    streamer->find(60.5, 40.5);
+    BOOST_CHECK_EQUAL(num_loads, unpinned_loads + 1);
+}
+
 /**
  * Test the basics of creating an ocean volume layer,
  */
@@ -4,12 +4,15 @@
 #include <usml/netcdf/netcdf_woa.h>
 #include <usml/ocean/ascii_profile.h>
 #include <usml/ocean/data_grid_mackenzie.h>
+#include <usml/ocean/environment_cache.h>
 #include <usml/ocean/profile_catenary.h>
+#include <usml/ocean/profile_forecast.h>
 #include <usml/ocean/profile_grid.h>
 #include <usml/ocean/profile_linear.h>
 #include <usml/ocean/profile_model.h>
 #include <usml/ocean/profile_munk.h>
 #include <usml/ocean/profile_n2.h>
+#include <usml/ocean/profile_tiles.h>
 #include <usml/types/types.h>
 #include <usml/ublas/ublas.h>
 
@@ -217,10 +220,183 @@ BOOST_AUTO_TEST_CASE(compute_mackenzie_test) {
     }
 }
 
+/**
+ * Compare the bulk construction of data_grid_mackenzie to a direct
+ * evaluation of the Mackenzie equation at each grid point. Uses a
+ * synthetic 20 x 100 x 100 temperature and salinity grid, which is large
+ * enough to split the calculation across multiple threads.
+ *
+ * Generate errors if values differ by more that 1E-10 percent.
+ */
+BOOST_AUTO_TEST_CASE(mackenzie_grid_test) {
+    cout << "=== profile_test: mackenzie_grid_test ===" << endl;
+    seq_vector::csptr axis[] = {
+        seq_vector::csptr(
+            new seq_linear(wposition::earth_radius, -250.0, 20)),
+        seq_vector::csptr(new seq_linear(to_colatitude(20.0), 0.001, 100)),
+        seq_vector::csptr(new seq_linear(to_radians(200.0), 0.001, 100))};
+    auto* temp = new gen_grid<3>(axis);
+    auto* salt = new gen_grid<3>(axis);
+    size_t index[3];
+    for (index[0] = 0; index[0] < 20; ++index[0]) {
+        for (index[1] = 0; index[1] < 100; ++index[1]) {
+            for (index[2] = 0; index[2] < 100; ++index[2]) {
+                temp->setdata(index, 25.0 - index[0] + 0.01 * index[1]);
+                salt->setdata(index, 34.5 + 0.001 * index[2]);
+            }
+        }
+    }
+    data_grid<3>::csptr temperature(temp);
+    data_grid<3>::csptr salinity(salt);
+    data_grid_mackenzie grid(temperature, salinity);
+
+    for (index[0] = 0; index[0] < 20; index[0] += 3) {
+        for (index[1] = 0; index[1] < 100; index[1] += 7) {
+            for (index[2] = 0; index[2] < 100; index[2] += 11) {
+                double D = wposition::earth_radius - (*axis[0])(index[0]);
+                double T = temperature->data(index);
+                double S = salinity->data(index);
+                double c = 1448.96 + 4.591 * T - 5.304e-2 * T * T +
+                           2.374e-4 * T * T * T + 1.340 * (S - 35.0) +
+                           1.630e-2 * D + 1.675e-7 * D * D -
+                           1.025e-2 * T * (S - 35.0) -
+                           7.139e-13 * T * D * D * D;
+                BOOST_CHECK_CLOSE(grid.data(index), c, 1e-10);
+            }
+        }
+    }
+}
+
+/**
+ * Test the ability of environment_cache to share grids between models.
+ * Requests the same key twice, using a loader that builds a small sound
+ * speed grid and counts the number of times that it is invoked.
+ *
+ * This test passes if:
+ *   - the loader is only invoked once for each key
+ *   - both requests return the same grid
+ *   - a loader that throws an exception does not leave the key in the cache
+ *   - release() only discards grids that are not used outside of the cache
+ */
+BOOST_AUTO_TEST_CASE(environment_cache_test) {
+    cout << "=== profile_test: environment_cache_test ===" << endl;
+    typedef environment_cache<1> cache;
+    cache::reset();
+    size_t num_load = 0;
+    auto load = [&]() {
+        ++num_load;
+        seq_vector::csptr axis[] = {
+            seq_vector::csptr(new seq_linear(0.0, 10.0, 5))};
+        size_t index[1] = {0};
+        auto* grid = new gen_grid<1>(axis);
+        grid->setdata(index, 1500.0);
+        return data_grid<1>::csptr(grid);
+    };
+
+    const auto key1 =
+        cache::key("test.nc", "speed", 18.5, 22.5, 200.5, 205.5, 6);
+    const auto key2 =
+        cache::key("test.nc", "speed", 18.5, 22.5, 200.5, 205.5, 7);
+    BOOST_CHECK(key1 != key2);
+
+    auto grid1 = cache::find(key1, load);
+    auto grid2 = cache::find(key1, load);
+    BOOST_CHECK_EQUAL(num_load, 1);
+    BOOST_CHECK_EQUAL(grid1.get(), grid2.get());
+
+    BOOST_CHECK_THROW(
+        cache::find(key2,
+                    []() -> data_grid<1>::csptr {
+                        throw std::invalid_argument("file not found");
+                    }),
+        std::invalid_argument);
+    BOOST_CHECK_EQUAL(cache::size(), 1);
+    cache::find(key2, load);
+    BOOST_CHECK_EQUAL(num_load, 2);
+    BOOST_CHECK_EQUAL(cache::size(), 2);
+
+    BOOST_CHECK_EQUAL(cache::release(), 1);
+    grid1.reset();
+    grid2.reset();
+    BOOST_CHECK_EQUAL(cache::release(), 1);
+    BOOST_CHECK_EQUAL(cache::size(), 0);
+}
+
+/**
+ * Test the interpolation of sound speed between forecast epochs.
+ * Uses two linear profiles, an hour apart, whose surface sound speeds
+ * differ by 10 m/s. Checks the speed and gradient a quarter of the way
+ * between epochs, and checks that times outside of the forecast are
+ * limited to the first and last epochs.
+ */
+BOOST_AUTO_TEST_CASE(profile_forecast_test) {
+    cout << "=== profile_test: profile_forecast_test ===" << endl;
+    profile_forecast::epochs_type::epoch_map epochs;
+    epochs[0.0] = profile_model::csptr(new profile_linear(1500.0, 0.016));
+    epochs[3600.0] = profile_model::csptr(new profile_linear(1510.0, 0.016));
+    profile_forecast model(epochs, 900.0);
+
+    wposition points(2, 1);
+    points.altitude(0, 0, 0.0);
+    points.altitude(1, 0, -1000.0);
+    matrix<double> speed(2, 1);
+    wvector gradient(2, 1);
+    model.sound_speed(points, &speed, &gradient);
+    BOOST_CHECK_CLOSE(speed(0, 0), 1502.5, 1e-6);
+    BOOST_CHECK_CLOSE(speed(1, 0), 1518.5, 1e-6);
+    BOOST_CHECK_CLOSE(gradient.rho(0, 0), -0.016, 1e-6);
+
+    // move forecast forward in time, and limit to range of epochs
+
+    BOOST_CHECK_CLOSE(model.at(1800.0)->time(), 1800.0, 1e-6);
+    model.at(-60.0)->sound_speed(points, &speed);
+    BOOST_CHECK_CLOSE(speed(0, 0), 1500.0, 1e-6);
+    model.at(7200.0)->sound_speed(points, &speed);
+    BOOST_CHECK_CLOSE(speed(0, 0), 1510.0, 1e-6);
+    model.at(3600.0)->sound_speed(points, &speed);
+    BOOST_CHECK_CLOSE(speed(0, 0), 1510.0, 1e-6);
+
+    BOOST_CHECK_THROW(
+        profile_forecast(profile_forecast::epochs_type::epoch_map(), 0.0),
+        std::invalid_argument);
+}
+
+/**
+ * Test the computation of sound speed for locations that span several
+ * profile tiles. Each tile is a linear profile whose surface sound speed
+ * encodes the latitude of the tile.
+ */
+BOOST_AUTO_TEST_CASE(profile_tiles_test) {
+    cout << "=== profile_test: profile_tiles_test ===" << endl;
+    auto streamer = std::make_shared<profile_tiles::streamer_type>(
+        [](double south, double, double, double) {
+            const double c0 = 1500.0 + std::round(south + 0.5);
+            return profile_model::csptr(new profile_linear(c0, 0.016));
+        },
+        2.0, 0.5);
+    profile_tiles model(streamer);
+
+    wposition points(3, 1);
+    points.latitude(0, 0, 1.0);
+    points.latitude(1, 0, 3.0);
+    points.latitude(2, 0, -1.0);
+    points.longitude(scalar_matrix<double>(3, 1, 45.0));
+    points.altitude(scalar_matrix<double>(3, 1, -100.0));
+    matrix<double> speed(3, 1);
+    wvector gradient(3, 1);
+    model.sound_speed(points, &speed, &gradient);
+    BOOST_CHECK_CLOSE(speed(0, 0), 1501.6, 1e-6);
+    BOOST_CHECK_CLOSE(speed(1, 0), 1503.6, 1e-6);
+    BOOST_CHECK_CLOSE(speed(2, 0), 1499.6, 1e-6);
+    BOOST_CHECK_CLOSE(gradient.rho(2, 0), -0.016, 1e-6);
+    BOOST_CHECK_EQUAL(streamer->size(), 3);
+}
+
 /**
  * Test the ability to load 1D profile data from an ASCII text file.
  *
- * Generate errors if 1st and 8th values differ by more that 1E-5 percent.
+ * Generate errors if 1st and 8th values differ by more that 1E-5 percent,
+ * or if a file with a depth that has no speed is accepted.
  */
 BOOST_AUTO_TEST_CASE(ascii_profile_test) {
     cout << "=== profile_test: ascii_profile_test ===" << endl;
@@ -235,6 +411,12 @@ BOOST_AUTO_TEST_CASE(ascii_profile_test) {
     double value8 = profile.data(index);
     BOOST_CHECK_CLOSE(value1, 1546.50, 1e-5);
     BOOST_CHECK_CLOSE(value8, 1490.00, 1e-5);
+
+    // reject a depth without a matching speed
+
+    const char* odd_file = (USML_TEST_DIR "/ocean/test/ascii_profile_odd.csv");
+    std::ofstream(odd_file) << "0.0, 1546.5\n10.0, 1540.0\n20.0\n";
+    BOOST_CHECK_THROW(ascii_profile bad(odd_file), std::invalid_argument);
 }
 
 /// @}
@@ -238,6 +238,45 @@ BOOST_AUTO_TEST_CASE(plot_rayleigh_sediments) {
     }
 }
 
+/**
+ * Compare the tabulated Rayleigh model to direct calculations for each of
+ * the generic sediments. Uses angles that fall between the table entries.
+ * Generate errors if amplitude differs by more than 0.01 dB, or if phase
+ * differs by more than 0.01 radians.
+ */
+BOOST_AUTO_TEST_CASE(reflect_loss_table_test) {
+    cout << "=== reflect_loss_test: reflect_loss_table_test ===" << endl;
+    wposition1 points;
+    seq_vector::csptr freq(new seq_log(10.0, 10.0, 3));
+    vector<double> amplitude(freq->size());
+    vector<double> phase(freq->size());
+    vector<double> table_amplitude(freq->size());
+    vector<double> table_phase(freq->size());
+
+    for (size_t type = 0; type <= size_t(bottom_type_enum::basalt); ++type) {
+        auto model = reflect_loss_model::csptr(new reflect_loss_rayleigh(type));
+        reflect_loss_table table(model);
+        double max_amp = 0.0;
+        double max_phase = 0.0;
+        for (double angle = 0.0; angle <= 90.0; angle += 0.37) {
+            model->reflect_loss(points, freq, to_radians(angle), &amplitude,
+                                &phase);
+            table.reflect_loss(points, freq, to_radians(angle),
+                               &table_amplitude, &table_phase);
+            for (size_t f = 0; f < freq->size(); ++f) {
+                max_amp = max(max_amp, abs(table_amplitude(f) - amplitude(f)));
+                max_phase = max(max_phase,
+                                abs(remainder(table_phase(f) - phase(f),
+                                              TWO_PI)));
+            }
+        }
+        cout << "type=" << type << " amplitude error=" << max_amp
+             << " phase error=" << max_phase << endl;
+        BOOST_CHECK_SMALL(max_amp, 0.01);
+        BOOST_CHECK_SMALL(max_phase, 0.01);
+    }
+}
+
 /**
  * Test the basic features of the reflection loss model using
  * the netCDF bottom type file.
@@ -0,0 +1,435 @@
+/**
+ * @file tile_streamer.h
+ * Loads environmental models in tiles around the areas that are in use.
+ */
+#pragma once
+
+#include <usml/threads/read_write_lock.h>
+#include <usml/types/wposition.h>
+#include <usml/types/wposition1.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace usml {
+namespace ocean {
+
+using namespace usml::threads;
+using namespace usml::types;
+
+/// @ingroup ocean_model
+/// @{
+
+/**
+ * Loads environmental models in tiles around the areas that are in use.
+ * The earth is divided into square latitude/longitude tiles, and the
+ * caller provides a loader that builds the model for a single tile, such
+ * as a boundary_grid extracted from a bathymetry database. Tiles are loaded
+ * the first time that they are needed, and then shared until they are
+ * evicted.
+ *
+ * The require() method loads all of the tiles that overlap a disk around a
+ * location, such as the area that can be reached by a wavefront in its
+ * maximum propagation time. The prefetch() method starts the same
+ * loads in background threads, without waiting for them to finish, so that
+ * the area ahead of a moving platform is available before it is needed.
+ * Tiles that are requested outside of these areas, by rays that leave the
+ * expected region, are loaded on demand.
+ *
+ * Memory is bounded by max_tiles. When this limit is exceeded, the least
+ * recently used tiles are evicted. Each call to find() returns a shared
+ * reference that pins its tile for the duration of the caller's query, and
+ * tiles that are pinned by a query in another thread are not evicted.
+ * Between queries, the tiles are only held by this cache. A wave_queue holds
+ * the ocean, not its tiles, so a wavefront that returns to an evicted tile
+ * reloads it in the middle of propagation. Set max_tiles large enough to
+ * cover the areas passed to require() for all of the active sensors.
+ * Longitudes are wrapped into the range [-180,180) before the tile is
+ * computed.
+ *
+ * @param  MODEL    Type of environmental model stored in each tile. Must
+ *                  define a csptr type for its shared pointer.
+ */
+template <class MODEL>
+class tile_streamer {
+   public:
+    /// Shared pointer to constant version of the model in each tile.
+    typedef typename MODEL::csptr model_csptr;
+
+    /// Function that loads the model for the area south, north, west, east.
+    typedef std::function<model_csptr(double, double, double, double)>
+        loader;
+
+    /// Row and column of a tile, in units of tile_size.
+    typedef std::pair<int, int> tile_key;
+
+    /// Tile that contains a location, and the row major index of the location.
+    typedef std::pair<tile_key, size_t> tile_index;
+
+    /**
+     * Initialize the tile parameters. No tiles are loaded until they are
+     * first needed.
+     *
+     * @param load          Function that loads the model for one tile.
+     * @param tile_size     Width and height of each tile (degrees).
+     * @param overlap       Extra area loaded on each side of a tile, so that
+     *                      interpolation is smooth across tile edges
+     *                      (degrees).
+     * @param max_tiles     Maximum number of tiles to keep in memory.
+     */
+    tile_streamer(loader load, double tile_size = 1.0, double overlap = 0.1,
+                  size_t max_tiles = 64)
+        : _load(std::move(load)),
+          _tile_size(tile_size),
+          _overlap(overlap),
+          _max_tiles(max_tiles) {}
+
+    /** Width and height of each tile (degrees). */
+    double tile_size() const { return _tile_size; }
+
+    /** Maximum number of tiles to keep in memory. */
+    size_t max_tiles() const { return _max_tiles; }
+
+    /** Number of tiles in memory, including those that are loading. */
+    size_t size() const {
+        read_lock_guard guard(_mutex);
+        return _tiles.size();
+    }
+
+    /**
+     * Compute the tile that contains a specific location.
+     *
+     * @param latitude      Latitude of the location (degrees).
+     * @param longitude     Longitude of the location (degrees).
+     * @return              Row and column of the tile.
+     */
+    tile_key key(double latitude, double longitude) const {
+        longitude = std::remainder(longitude, 360.0);
+        if (longitude >= 180.0) {
+            longitude -= 360.0;
+        }
+        return tile_key((int)std::floor(latitude / _tile_size),
+                        (int)std::floor(longitude / _tile_size));
+    }
+
+    /**
+     * Find the model for the tile that contains a specific location.
+     * Loads the tile, and waits for it, if it is not already in memory.
+     *
+     * @param latitude      Latitude of the location (degrees).
+     * @param longitude     Longitude of the location (degrees).
+     * @return              Model for this tile.
+     */
+    model_csptr find(double latitude, double longitude) {
+        return find(key(latitude, longitude));
+    }
+
+    /**
+     * Find the model for a specific tile. Loads the tile, and waits for it,
+     * if it is not already in memory.
+     *
+     * @param tile          Row and column of the tile.
+     * @return              Model for this tile.
+     */
+    model_csptr find(const tile_key& tile) {
+        const uint64_t stamp = ++_clock;
+        auto model = get(tile, start(tile, stamp));
+        evict(stamp);
+        return model;
+    }
+
+    /**
+     * Load all of the tiles that overlap a disk around a location, and
+     * wait for them to finish loading.
+     *
+     * @param center        Center of the area of interest.
+     * @param radius        Radius of the area of interest (meters).
+     */
+    void require(const wposition1& center, double radius) {
+        const uint64_t stamp = ++_clock;
+        const auto list = tiles(center, radius);
+        std::vector<std::shared_future<model_csptr>> loads;
+        for (const auto& tile : list) {
+            loads.push_back(start(tile, stamp));
+        }
+        for (size_t n = 0; n < list.size(); ++n) {
+            get(list[n], loads[n]);
+        }
+        evict(stamp);
+    }
+
+    /**
+     * Start loading all of the tiles that overlap a disk around a location
+     * in background threads. Returns without waiting for them to finish.
+     *
+     * @param center        Center of the area of interest.
+     * @param radius        Radius of the area of interest (meters).
+     */
+    void prefetch(const wposition1& center, double radius) {
+        const uint64_t stamp = ++_clock;
+        for (const auto& tile : tiles(center, radius)) {
+            start(tile, stamp, std::launch::async);
+        }
+        evict(stamp);
+    }
+
+    /**
+     * List the tiles that overlap a disk around a location.
+     *
+     * @param center        Center of the area of interest.
+     * @param radius        Radius of the area of interest (meters).
+     * @return              Row and column of each tile.
+     */
+    std::vector<tile_key> tiles(const wposition1& center, double radius) const {
+        const double lat = center.latitude();
+        const double dlat = to_degrees(radius / wposition::earth_radius);
+        const double south = std::max(lat - dlat, -90.0);
+        const double north = std::min(lat + dlat, 90.0 - 1e-9);
+        const double coslat =
+            std::cos(to_radians(std::max(std::abs(south), std::abs(north))));
+        const double dlng =
+            (coslat * 180.0 > dlat) ? std::min(dlat / coslat, 180.0) : 180.0;
+        const double west = center.longitude() - dlng;
+        const double east = center.longitude() + dlng;
+
+        std::vector<tile_key> result;
+        const int first_col = (int)std::floor(west / _tile_size);
+        const int num_cols =
+            std::min((int)std::ceil(360.0 / _tile_size),
+                     (int)std::floor(east / _tile_size) - first_col + 1);
+        for (int row = key(south, 0.0).first; row <= key(north, 0.0).first;
+             ++row) {
+            for (int n = 0; n < num_cols; ++n) {
+                const double lng = (first_col + n + 0.5) * _tile_size;
+                result.emplace_back(row, key(0.0, lng).second);
+            }
+        }
+        std::sort(result.begin(), result.end());
+        result.erase(std::unique(result.begin(), result.end()), result.end());
+        return result;
+    }
+
+    /**
+     * Group a matrix of locations by the tile that contains each one.
+     * Used by tiled models to make a single call to the model for each
+     * tile, instead of one call per location. If the locations span more
+     * than one tile, the result is sorted so that the locations in each
+     * tile are contiguous. The result re-uses its own capacity, so callers
+     * that keep it in a thread_local scratch vector do not allocate memory
+     * for each query.
+     *
+     * @param location      Locations to be grouped.
+     * @param result        Tile and row major index, row * size2 + col,
+     *                      of each location (output).
+     * @return              True if there is at least one location, and all
+     *                      of them are in the same tile.
+     */
+    bool group(const wposition& location,
+               std::vector<tile_index>* result) const {
+        result->clear();
+        bool single = true;
+        const size_t num_cols = location.size2();
+        for (size_t r = 0; r < location.size1(); ++r) {
+            for (size_t c = 0; c < num_cols; ++c) {
+                result->emplace_back(
+                    key(location.latitude(r, c), location.longitude(r, c)),
+                    r * num_cols + c);
+                single = single && result->back().first ==
+                                       result->front().first;
+            }
+        }
+        if (!single) {
+            std::sort(result->begin(), result->end());
+        }
+        return single && !result->empty();
+    }
+
+    /**
+     * Discard all of the tiles in memory.
+     */
+    void reset() {
+        write_lock_guard guard(_mutex);
+        _tiles.clear();
+    }
+
+   private:
+    /// Model for a single tile.
+    struct tile_entry {
+        /// Model for this tile, once it has been loaded.
+        std::shared_future<model_csptr> model;
+
+        /// Value of the clock when this tile was last used.
+        std::atomic<uint64_t> stamp{0};
+    };
+
+    /// Function that loads the model for one tile.
+    const loader _load;
+
+    /// Width and height of each tile (degrees).
+    const double _tile_size;
+
+    /// Extra area loaded on each side of a tile (degrees).
+    const double _overlap;
+
+    /// Maximum number of tiles to keep in memory.
+    const size_t _max_tiles;
+
+    /// Counter used to find the least recently used tiles.
+    std::atomic<uint64_t> _clock{0};
+
+    /// Models that have been loaded, or are loading, for each tile.
+    std::map<tile_key, tile_entry> _tiles;
+
+    /// Mutex that locks the list of tiles.
+    mutable read_write_lock _mutex;
+
+    /**
+     * Start loading a tile if it is not already in memory, and mark it
+     * as used at a specific time.
+     *
+     * @param tile      Row and column of the tile.
+     * @param stamp     Value of the clock for this request.
+     * @param policy    Load the tile in the calling thread (deferred) or
+     *                  in a background thread (async).
+     * @return          Model for this tile, once it has been loaded.
+     */
+    std::shared_future<model_csptr> start(
+        const tile_key& tile, uint64_t stamp,
+        std::launch policy = std::launch::deferred) {
+        {
+            read_lock_guard guard(_mutex);
+            auto iter = _tiles.find(tile);
+            if (iter != _tiles.end()) {
+                iter->second.stamp = stamp;
+                return iter->second.model;
+            }
+        }
+        write_lock_guard guard(_mutex);
+        auto& entry = _tiles[tile];
+        entry.stamp = stamp;
+        if (!entry.model.valid()) {
+            const double south = tile.first * _tile_size - _overlap;
+            const double west = tile.second * _tile_size - _overlap;
+            const double size = _tile_size + 2.0 * _overlap;
+            entry.model =
+                std::async(policy, _load, std::max(south, -90.0),
+                           std::min(south + size, 90.0), west, west + size)
+                    .share();
+        }
+        return entry.model;
+    }
+
+    /**
+     * Wait for a tile to finish loading. If the loader throws an exception,
+     * the tile is removed, so that it can be loaded again later, and the
+     * exception is passed to the caller.
+     *
+     * @param tile      Row and column of the tile.
+     * @param model     Model for this tile, once it has been loaded.
+     * @return          Model for this tile.
+     */
+    model_csptr get(const tile_key& tile,
+                    const std::shared_future<model_csptr>& model) {
+        try {
+            return model.get();
+        } catch (...) {
+            write_lock_guard guard(_mutex);
+            auto iter = _tiles.find(tile);
+            if (iter != _tiles.end() && failed(iter->second.model)) {
+                _tiles.erase(iter);
+            }
+            throw;
+        }
+    }
+
+    /**
+     * True if a tile has finished loading, successfully or not.
+     *
+     * @param model     Model for this tile, once it has been loaded.
+     */
+    static bool ready(const std::shared_future<model_csptr>& model) {
+        return model.wait_for(std::chrono::seconds(0)) ==
+               std::future_status::ready;
+    }
+
+    /**
+     * True if a loaded tile is referenced outside of this cache, by a
+     * query that is still using it.
+     *
+     * @param model     Model for this tile, once it has been loaded.
+     */
+    static bool pinned(const std::shared_future<model_csptr>& model) {
+        try {
+            return model.get().use_count() > 1;
+        } catch (...) {
+            return false;
+        }
+    }
+
+    /**
+     * True if a tile has finished loading, and its loader threw an exception.
+     *
+     * @param model     Model for this tile, once it has been loaded.
+     */
+    static bool failed(const std::shared_future<model_csptr>& model) {
+        if (!ready(model)) {
+            return false;
+        }
+        try {
+            model.get();
+        } catch (...) {
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * Evict the least recently used tiles until the number of tiles in
+     * memory is less than max_tiles. Tiles used at or after the keep
+     * time are never evicted, so that the area of interest for the current
+     * request remains intact even if it is larger than max_tiles. Tiles
+     * that are still loading in the background, and tiles whose model is
+     * pinned by a query in another thread, are not evicted.
+     *
+     * @param keep      Value of the clock for tiles that must be kept.
+     */
+    void evict(uint64_t keep) {
+        {
+            read_lock_guard guard(_mutex);
+            if (_tiles.size() <= _max_tiles) {
+                return;
+            }
+        }
+        write_lock_guard guard(_mutex);
+        while (_tiles.size() > _max_tiles) {
+            auto oldest = _tiles.end();
+            for (auto iter = _tiles.begin(); iter != _tiles.end(); ++iter) {
+                if (iter->second.stamp >= keep || !ready(iter->second.model) ||
+                    pinned(iter->second.model)) {
+                    continue;
+                }
+                if (oldest == _tiles.end() ||
+                    iter->second.stamp < oldest->second.stamp) {
+                    oldest = iter;
+                }
+            }
+            if (oldest == _tiles.end()) {
+                break;
+            }
+            _tiles.erase(oldest);
+        }
+    }
+};
+
+/// @}
+}  // end of namespace ocean
+}  // end of namespace usml
@@ -7,9 +7,12 @@
 
 using namespace usml::platforms;
 
-const double motion_thresholds::lat_threshold = 0.01;   // degrees
-const double motion_thresholds::lon_threshold = 0.01;   // degrees
-const double motion_thresholds::alt_threshold = 5.0;    // meters
-const double motion_thresholds::yaw_threshold = 5.0;    // degrees
-const double motion_thresholds::pitch_threshold = 5.0;  // degrees
-const double motion_thresholds::roll_threshold = 5.0;   // degrees
+const double motion_thresholds::lat_threshold = 0.01;    // degrees
+const double motion_thresholds::lon_threshold = 0.01;    // degrees
+const double motion_thresholds::alt_threshold = 5.0;     // meters
+const double motion_thresholds::yaw_threshold = 5.0;     // degrees
+const double motion_thresholds::pitch_threshold = 5.0;   // degrees
+const double motion_thresholds::roll_threshold = 5.0;    // degrees
+const double motion_thresholds::speed_threshold = 1.0;   // m/s
+const double motion_thresholds::height_threshold = 1.0;  // meters
+const double motion_thresholds::prefetch_time = 600.0;   // seconds
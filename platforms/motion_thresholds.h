@@ -32,6 +32,15 @@ class motion_thresholds {
 
     /** Maximum change in roll  (degrees). */
     static const double roll_threshold;
+
+    /** Maximum change in sound speed (m/s). */
+    static const double speed_threshold;
+
+    /** Maximum change in surface or bottom height (meters). */
+    static const double height_threshold;
+
+    /** Time ahead of a moving platform to prefetch environment data (sec). */
+    static const double prefetch_time;
 };
 
 /// @}
@@ -4,7 +4,12 @@
  */
 
 #include <usml/platforms/platform_manager.h>
+#include <usml/types/wposition.h>
+#include <usml/ublas/math_traits.h>
 
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
 #include <memory>
 
 using namespace usml::platforms;
@@ -15,6 +20,9 @@ std::unique_ptr<platform_manager> platform_manager::_instance;
 /** Initializes mutex for singleton construction. */
 read_write_lock platform_manager::_mutex;
 
+/** Size of each spatial index cell (deg). */
+double platform_manager::index_cell = 1.0;
+
 /**
  * Singleton constructor, implemented using double-checked locking pattern.
  */
@@ -51,5 +59,210 @@ typename platform_model::key_type platform_manager::add(
     } else {
         _max_key = max(_max_key, platform->keyID());
     }
-    return manager_template<platform_model>::add(platform);
+    auto key = manager_template<platform_model>::add(platform);
+
+    // add platform to spatial index
+
+    write_lock_guard index_guard(_index_mutex);
+    const int64_t cell = index_key(platform->position());
+    _index_cells[cell][key] = platform;
+    _index_lookup[key] = cell;
+    return key;
+}
+
+/**
+ * Removes an existing platform from the manager and spatial index.
+ */
+bool platform_manager::remove(typename platform_model::key_type keyID) {
+    {
+        write_lock_guard index_guard(_index_mutex);
+        auto iter = _index_lookup.find(keyID);
+        if (iter != _index_lookup.end()) {
+            auto cell = _index_cells.find(iter->second);
+            if (cell != _index_cells.end()) {
+                cell->second.erase(keyID);
+                if (cell->second.empty()) {
+                    _index_cells.erase(cell);
+                }
+            }
+            _index_lookup.erase(iter);
+        }
+    }
+    return manager_template<platform_model>::remove(keyID);
+}
+
+/**
+ * Search for acoustic targets within a range of slant distances.
+ * Limits the search to index cells that overlap the maximum range,
+ * padded by one cell to account for earth curvature and platform altitude.
+ */
+std::list<platform_model::sptr> platform_manager::find_targets(
+    const wposition1& pos, double min_range, double max_range) const {
+    const double min_range2 = min_range * min_range;
+    const double max_range2 = max_range * max_range;
+    const bool unlimited = min_range2 < DBL_EPSILON && max_range2 < DBL_EPSILON;
+
+    // test a single platform against the search criteria
+
+    std::map<platform_model::key_type, platform_model::sptr> found;
+    auto test_target = [&](const platform_model::sptr& platform) {
+        if (!platform->is_acoustic_target()) {
+            return;
+        }
+        if (!unlimited) {
+            double distance2 = platform->position().distance2(pos);
+            if (distance2 < min_range2) {
+                return;
+            }
+            if (max_range2 >= DBL_EPSILON && distance2 > max_range2) {
+                return;
+            }
+        }
+        found[platform->keyID()] = platform;
+    };
+
+    read_lock_guard guard(_index_mutex);
+    if (max_range2 < DBL_EPSILON) {
+        for (const auto& cell : _index_cells) {
+            for (const auto& entry : cell.second) {
+                test_target(entry.second);
+            }
+        }
+    } else {
+        // compute range of rows and columns that overlap the search radius
+
+        const double chord =
+            std::min(1.0, max_range / (2.0 * wposition::earth_radius));
+        const double radius = to_degrees(2.0 * asin(chord));
+        const double lat = pos.latitude();
+        const int64_t num_rows = index_rows();
+        const int64_t num_cols = index_cols();
+        const int64_t first_row =
+            std::max(int64_t(0), index_row(lat - radius) - 1);
+        const int64_t last_row =
+            std::min(num_rows - 1, index_row(lat + radius) + 1);
+
+        int64_t col_span = num_cols;
+        const double max_lat = std::abs(lat) + radius + index_cell;
+        if (max_lat < 90.0) {
+            const double span = radius / cos(to_radians(max_lat));
+            if (span < 180.0) {
+                col_span = (int64_t)ceil(span / index_cell) + 1;
+            }
+        }
+        int64_t first_col = index_col(pos.longitude()) - col_span;
+        int64_t last_col = index_col(pos.longitude()) + col_span;
+        if (last_col - first_col + 1 >= num_cols) {
+            first_col = 0;
+            last_col = num_cols - 1;
+        }
+
+        // test the platforms in each of the overlapping cells
+
+        for (int64_t row = first_row; row <= last_row; ++row) {
+            for (int64_t c = first_col; c <= last_col; ++c) {
+                const int64_t col = ((c % num_cols) + num_cols) % num_cols;
+                auto cell = _index_cells.find(row * num_cols + col);
+                if (cell != _index_cells.end()) {
+                    for (const auto& entry : cell->second) {
+                        test_target(entry.second);
+                    }
+                }
+            }
+        }
+    }
+
+    std::list<platform_model::sptr> targets;
+    for (const auto& entry : found) {
+        targets.push_back(entry.second);
+    }
+    return targets;
+}
+
+/**
+ * Moves a platform to a new cell in the spatial index.
+ */
+void platform_manager::update_index(const platform_model* platform) {
+    read_lock_guard guard(_mutex);
+    platform_manager* manager = _instance.get();
+    if (manager == nullptr) {
+        return;
+    }
+    const auto keyID = platform->keyID();
+    const int64_t cell = index_key(platform->position());
+
+    // most updates stay in the same cell, so check under a read lock first
+
+    {
+        read_lock_guard index_guard(manager->_index_mutex);
+        auto iter = manager->_index_lookup.find(keyID);
+        if (iter == manager->_index_lookup.end() || iter->second == cell) {
+            return;
+        }
+    }
+    write_lock_guard index_guard(manager->_index_mutex);
+    auto iter = manager->_index_lookup.find(keyID);
+    if (iter == manager->_index_lookup.end() || iter->second == cell) {
+        return;
+    }
+
+    // ignore unmanaged platforms that share the keyID of a managed one
+
+    auto& old_cell = manager->_index_cells[iter->second];
+    auto entry = old_cell.find(keyID);
+    if (entry == old_cell.end() || entry->second.get() != platform) {
+        return;
+    }
+
+    // move platform to its new cell
+
+    platform_model::sptr object = entry->second;
+    old_cell.erase(entry);
+    if (old_cell.empty()) {
+        manager->_index_cells.erase(iter->second);
+    }
+    manager->_index_cells[cell][keyID] = object;
+    iter->second = cell;
+}
+
+/**
+ * Compute the spatial index cell number for a location.
+ */
+int64_t platform_manager::index_key(const wposition1& pos) {
+    return index_row(pos.latitude()) * index_cols() +
+           index_col(pos.longitude());
+}
+
+/**
+ * Compute the spatial index row for a latitude.
+ */
+int64_t platform_manager::index_row(double latitude) {
+    auto row = (int64_t)floor((latitude + 90.0) / index_cell);
+    return std::max(int64_t(0), std::min(index_rows() - 1, row));
+}
+
+/**
+ * Compute the spatial index column for a longitude.
+ */
+int64_t platform_manager::index_col(double longitude) {
+    double lng = fmod(longitude, 360.0);
+    if (lng < 0.0) {
+        lng += 360.0;
+    }
+    auto col = (int64_t)floor(lng / index_cell);
+    return std::max(int64_t(0), std::min(index_cols() - 1, col));
+}
+
+/**
+ * Number of spatial index rows that span all latitudes.
+ */
+int64_t platform_manager::index_rows() {
+    return (int64_t)ceil(180.0 / index_cell);
+}
+
+/**
+ * Number of spatial index columns that span all longitudes.
+ */
+int64_t platform_manager::index_cols() {
+    return (int64_t)ceil(360.0 / index_cell);
 }
@@ -9,7 +9,10 @@
 #include <usml/threads/read_write_lock.h>
 #include <usml/usml_config.h>
 
+#include <list>
+#include <map>
 #include <memory>
+#include <unordered_map>
 
 namespace usml {
 namespace platforms {
@@ -22,6 +25,13 @@ using namespace usml::threads;
 
 /**
  * Singleton container for all platforms in the simulation.
+ *
+ * Maintains a spatial index of the platforms in this manager, so that
+ * sensors can search for nearby acoustic targets without testing the range
+ * to every platform in the simulation. The index divides the earth into
+ * cells of equal latitude and longitude. Platforms are moved between cells
+ * when platform_model::update_internals() changes their position. Range
+ * queries only test the platforms in cells that overlap the search radius.
  */
 class USML_DECLSPEC platform_manager : public manager_template<platform_model> {
    public:
@@ -49,6 +59,50 @@ class USML_DECLSPEC platform_manager : public manager_template<platform_model> {
     typename platform_model::key_type add(
         const typename platform_model::sptr& platform);
 
+    /**
+     * Removes an existing platform from the manager. Overrides equivalent
+     * function in manager_template<> so that it can also be removed from
+     * the spatial index.
+     *
+     * @param keyID     Identification used to find this platform.
+     * @return          False if keyID was not found.
+     */
+    bool remove(typename platform_model::key_type keyID);
+
+    /**
+     * Search for acoustic targets within a range of slant distances from
+     * a location. Ignores platforms whose is_acoustic_target() flag is false.
+     * Both ranges are ignored if they are zero, and the maximum range is
+     * ignored if it is zero. Results are sorted by keyID.
+     *
+     * @param pos           Location at center of search.
+     * @param min_range     Minimum slant range (m).
+     * @param max_range     Maximum slant range (m).
+     * @return              List of acoustic targets in range.
+     */
+    std::list<platform_model::sptr> find_targets(const wposition1& pos,
+                                                 double min_range,
+                                                 double max_range) const;
+
+    /**
+     * Moves a platform to a new cell in the spatial index. Called by
+     * platform_model::update_internals() each time the platform moves.
+     * Ignores platforms that have not been added to the manager, and does
+     * nothing if the singleton has not been created. The cells are compared
+     * under a read lock, and the index is only locked for writing when the
+     * platform moves to a new cell.
+     *
+     * @param platform  Platform that has moved.
+     */
+    static void update_index(const platform_model* platform);
+
+    /**
+     * Size of each spatial index cell in latitude and longitude (deg).
+     * Must be set before platforms are added to the manager.
+     * Defaults to 1 degree.
+     */
+    static double index_cell;
+
    private:
     /// Reference to singleton.
     static std::unique_ptr<platform_manager> _instance;
@@ -59,6 +113,49 @@ class USML_DECLSPEC platform_manager : public manager_template<platform_model> {
     /// Maximum key value that has been inserted into this manager
     platform_model::key_type _max_key;
 
+    /// Type used to store the platforms in a single spatial index cell.
+    typedef std::map<platform_model::key_type, platform_model::sptr>
+        cell_type;
+
+    /// Mutex for changes to the spatial index.
+    mutable read_write_lock _index_mutex;
+
+    /// Platforms in each spatial index cell, keyed by cell number.
+    std::unordered_map<int64_t, cell_type> _index_cells;
+
+    /// Cell number for each platform in the spatial index.
+    std::unordered_map<platform_model::key_type, int64_t> _index_lookup;
+
+    /**
+     * Compute the spatial index cell number for a location.
+     *
+     * @param pos   Location to be indexed.
+     * @return      Cell number for this location.
+     */
+    static int64_t index_key(const wposition1& pos);
+
+    /**
+     * Compute the spatial index row for a latitude.
+     *
+     * @param latitude  Latitude of location (deg).
+     * @return          Row number in the range [0,num_rows).
+     */
+    static int64_t index_row(double latitude);
+
+    /**
+     * Compute the spatial index column for a longitude.
+     *
+     * @param longitude Longitude of location (deg).
+     * @return          Column number in the range [0,num_cols).
+     */
+    static int64_t index_col(double longitude);
+
+    /// Number of spatial index rows that span all latitudes.
+    static int64_t index_rows();
+
+    /// Number of spatial index columns that span all longitudes.
+    static int64_t index_cols();
+
     /// Hide default constructor to prevent incorrect use of singleton.
     platform_manager() : _max_key(0) {}
 };
@@ -3,6 +3,7 @@
  * Physical object that moves through the simulation.
  */
 
+#include <usml/platforms/platform_manager.h>
 #include <usml/platforms/platform_model.h>
 #include <usml/types/wvector1.h>
 
@@ -117,6 +118,7 @@ void platform_model::update_internals(time_t time, const wposition1& pos,
     _position = pos;
     _orient = orient;
     _speed = speed;
+    platform_manager::update_index(this);
 
     // update motion of children
 
@@ -92,6 +92,73 @@ BOOST_AUTO_TEST_CASE(attach_platform) {
 
     platform_manager::reset();
 }
+
+/**
+ * Test the ability to search for acoustic targets using the spatial index in
+ * platform_manager. Creates a grid of platforms that straddles the dateline,
+ * and compares the results of the range query to a brute force search
+ * of all platforms. Then it moves a platform into range, disables
+ * another as an acoustic target, removes a third, and checks that the
+ * query reflects each of these changes.
+ */
+BOOST_AUTO_TEST_CASE(find_targets) {
+    cout << "=== platforms_test: find_targets ===" << endl;
+
+    platform_manager* platform_mgr = platform_manager::instance();
+
+    // create a 21x21 grid of platforms, 0.25 deg apart, centered on 30N 180E
+
+    const wposition1 center(30.0, 180.0, -10.0);
+    for (int row = -10; row <= 10; ++row) {
+        for (int col = -10; col <= 10; ++col) {
+            wposition1 pos(30.0 + 0.25 * row, 180.0 + 0.25 * col, -10.0);
+            platform_mgr->add(std::make_shared<platform_model>(0, "target", 0,
+                                                               pos));
+        }
+    }
+
+    // compare range query to brute force search
+
+    const double min_range = 20e3;
+    const double max_range = 150e3;
+    auto brute_force = [&]() {
+        size_t count = 0;
+        for (const auto& platform : platform_mgr->list()) {
+            double distance = sqrt(platform->position().distance2(center));
+            if (platform->is_acoustic_target() && distance >= min_range &&
+                distance <= max_range) {
+                ++count;
+            }
+        }
+        return count;
+    };
+    auto targets = platform_mgr->find_targets(center, min_range, max_range);
+    cout << "found " << targets.size() << " targets in range" << endl;
+    BOOST_CHECK_EQUAL(targets.size(), brute_force());
+    BOOST_CHECK_GT(targets.size(), 0);
+    BOOST_CHECK_EQUAL(platform_mgr->find_targets(center, 0.0, 0.0).size(),
+                      platform_mgr->list().size());
+
+    // move a distant platform into range
+
+    platform_model::sptr mover = platform_mgr->find(1);
+    BOOST_CHECK_GT(sqrt(mover->position().distance2(center)), max_range);
+    mover->update(0.0, wposition1(30.5, 180.5, -10.0), orientation(), 0.0,
+                  platform_model::NO_UPDATE);
+    auto moved = platform_mgr->find_targets(center, min_range, max_range);
+    BOOST_CHECK_EQUAL(moved.size(), targets.size() + 1);
+    BOOST_CHECK_EQUAL(moved.size(), brute_force());
+
+    // disable and remove platforms that are in range
+
+    moved.front()->is_acoustic_target(false);
+    platform_mgr->remove(moved.back()->keyID());
+    auto removed = platform_mgr->find_targets(center, min_range, max_range);
+    BOOST_CHECK_EQUAL(removed.size(), targets.size() - 1);
+    BOOST_CHECK_EQUAL(removed.size(), brute_force());
+
+    platform_manager::reset();
+}
 /// @}
 
 BOOST_AUTO_TEST_SUITE_END()
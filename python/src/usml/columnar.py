@@ -0,0 +1,58 @@
+"""Read columnar files created by USML.
+
+Columnar files are flat binary files written by the write_columnar() methods of the USML eigenray, eigenverb, biverb,
+and rvbts collections. They contain the same variables as the netCDF files written by write_netcdf(), but each
+variable is stored as a single contiguous array that can be loaded without the netCDF library. The file layout is
+documented in usml/netcdf/columnar_file.h.
+"""
+import struct
+
+import numpy as np
+
+from usml.netcdf import Struct
+
+MAGIC = b"USMLCOL\0"
+VERSION = 1
+
+
+def _read_string(data: bytes, offset: int):
+    """Extract a length prefixed string, and return it with the offset of the next field."""
+    (size,) = struct.unpack_from("<I", data, offset)
+    offset += 4
+    return data[offset:offset + size].decode(), offset + size
+
+
+def read(filename: str):
+    """Read variable arrays from columnar file.
+
+    Returns a data structure where each field is a np.ndarray object, like usml.netcdf.read(). Scalars are returned
+    as zero dimensional arrays. The global attributes are returned in a dictionary called "attributes", and the units
+    of each variable are returned in a dictionary called "units".
+    """
+    with open(filename, "rb") as file:
+        data = file.read()
+    if data[0:8] != MAGIC:
+        raise ValueError(f"not a columnar file: {filename}")
+    version, num_attributes, num_columns, _ = struct.unpack_from("<4I", data, 8)
+    if version != VERSION:
+        raise ValueError(f"unsupported columnar version: {filename}")
+    offset = 24
+
+    obj = Struct()
+    obj.attributes = {}
+    obj.units = {}
+    for _ in range(num_attributes):
+        name, offset = _read_string(data, offset)
+        obj.attributes[name], offset = _read_string(data, offset)
+    for _ in range(num_columns):
+        name, offset = _read_string(data, offset)
+        obj.units[name], offset = _read_string(data, offset)
+        dtype, offset = _read_string(data, offset)
+        (ndim,) = struct.unpack_from("<I", data, offset)
+        shape = struct.unpack_from(f"<{ndim}Q", data, offset + 4)
+        (start,) = struct.unpack_from("<Q", data, offset + 4 + 8 * ndim)
+        offset += 12 + 8 * ndim
+        count = int(np.prod(shape, dtype=np.int64))
+        array = np.frombuffer(data, dtype=np.dtype(dtype), count=count, offset=start)
+        setattr(obj, name, array.reshape(shape))
+    return obj
@@ -0,0 +1,46 @@
+"""Test ability to read columnar files created by USML.
+"""
+import inspect
+import os
+import unittest
+
+import numpy as np
+
+import usml.columnar
+import usml.netcdf
+
+
+class TestColumnar(unittest.TestCase):
+    """Unit tests for usml.columnar module. Compares the columnar files to the netCDF files written by the same
+    USML regression tests.
+    """
+    USML_DIR = os.path.dirname(os.path.abspath(os.path.join(__file__, os.pardir, os.pardir)))
+
+    def test_eigenrays(self):
+        """Loads USML eigenrays from columnar file, and compares them to the same eigenrays in netCDF format.
+        """
+        testname = inspect.stack()[0][3]
+        print("=== " + testname + " ===")
+
+        # load data from disk
+        colname = os.path.join(self.USML_DIR, "eigenrays/test/create_eigenray.col")
+        ncname = os.path.join(self.USML_DIR, "eigenrays/test/create_eigenray.nc")
+        print(f"reading {colname}")
+        col = usml.columnar.read(colname)
+        nc = usml.netcdf.read(ncname)
+
+        # check that each netCDF variable has the same shape, units, and values
+        self.assertEqual(col.units["intensity"], "dB")
+        self.assertEqual(col.intensity.shape, (4, 1))
+        for name in ("sourceID", "source_latitude", "source_longitude", "source_altitude", "targetID", "latitude",
+                     "longitude", "altitude", "initial_time", "frequencies", "proploss_index", "eigenray_index",
+                     "eigenray_num", "intensity", "phase", "travel_time", "source_de", "source_az", "target_de",
+                     "target_az", "surface", "bottom", "caustic", "upper", "lower"):
+            expected = np.asarray(getattr(nc, name))
+            actual = getattr(col, name)
+            self.assertEqual(actual.size, expected.size, name)
+            np.testing.assert_allclose(actual.flatten(), expected.flatten(), err_msg=name)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -15,3 +15,4 @@
 
 #include <usml/rvbts/rvbts_collection.h>
 #include <usml/rvbts/rvbts_generator.h>
+#include <usml/rvbts/rvbts_stream.h>
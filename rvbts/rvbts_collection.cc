@@ -7,6 +7,9 @@
 #include <ncvalues.h>
 #include <netcdfcpp.h>
 #include <usml/beampatterns/bp_model.h>
+#include <usml/netcdf/columnar_file.h>
+#include <usml/netcdf/columnar_writer.h>
+#include <usml/netcdf/netcdf_utils.h>
 #include <usml/rvbts/rvbts_collection.h>
 #include <usml/types/bvector.h>
 #include <usml/types/seq_linear.h>
@@ -19,16 +22,80 @@
 #include <boost/numeric/ublas/vector_expression.hpp>
 #include <boost/numeric/ublas/vector_proxy.hpp>
 #include <cmath>
+#include <complex>
 #include <cstddef>
+#include <cstdint>
 #include <list>
+#include <mutex>
+#include <utility>
+#include <vector>
 
 using namespace usml::rvbts;
+using namespace usml::netcdf;
+
+namespace {
+
+/**
+ * In-place radix-2 FFT. Size of the data must be a power of two.
+ *
+ * @param data      Complex samples to transform (input/output).
+ * @param inverse   Computes the inverse transform, including 1/N scaling.
+ */
+void fft(std::vector<std::complex<double> >& data, bool inverse) {
+    const size_t size = data.size();
+
+    // bit reversal permutation
+
+    for (size_t i = 1, j = 0; i < size; ++i) {
+        size_t bit = size >> 1;
+        for (; (j & bit) != 0; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            std::swap(data[i], data[j]);
+        }
+    }
+
+    // butterflies
+
+    for (size_t len = 2; len <= size; len <<= 1) {
+        const double angle = (inverse ? TWO_PI : -TWO_PI) / (double)len;
+        const size_t half = len / 2;
+        for (size_t k = 0; k < half; ++k) {
+            const std::complex<double> w = std::polar(1.0, angle * (double)k);
+            for (size_t i = k; i < size; i += len) {
+                const std::complex<double> a = data[i];
+                const std::complex<double> b = data[i + half] * w;
+                data[i] = a + b;
+                data[i + half] = a - b;
+            }
+        }
+    }
+    if (inverse) {
+        for (auto& value : data) {
+            value /= (double)size;
+        }
+    }
+}
+
+}  // namespace
 
 /**
  * Threshold for minimum envelope power.
  */
 double rvbts_collection::power_threshold = 1e-20;
 
+/**
+ * Relative spacing of the duration classes used to accumulate Gaussians.
+ */
+double rvbts_collection::duration_resolution = 0.05;
+
+/**
+ * Minimum Gaussian duration for binning, in time increments.
+ */
+const double rvbts_collection::min_samples = 4.0;
+
 /**
  * Initialize model parameters with state of sensor_pair at the time that
  * reverberation generator was created.
@@ -48,7 +115,42 @@ rvbts_collection::rvbts_collection(
       _receiver_orient(receiver_orient),
       _receiver_speed(receiver_speed),
       _travel_times(travel_times),
-      _time_series(receiver->rcv_num_keys(), travel_times->size()) {}
+      _time_series(receiver->rcv_num_keys(), travel_times->size()) {
+    if (dynamic_cast<const seq_linear *>(travel_times.get()) != nullptr &&
+        travel_times->size() > 1) {
+        _time_start = (*travel_times)(0);
+        _time_increment = travel_times->increment(0);
+    }
+}
+
+/**
+ * Copies the time series of another collection.
+ */
+rvbts_collection::rvbts_collection(const rvbts_collection &other)
+    : _source(other._source),
+      _source_pos(other._source_pos),
+      _source_orient(other._source_orient),
+      _host_orient(other._host_orient),
+      _source_speed(other._source_speed),
+      _receiver(other._receiver),
+      _receiver_pos(other._receiver_pos),
+      _receiver_orient(other._receiver_orient),
+      _receiver_speed(other._receiver_speed),
+      _travel_times(other._travel_times),
+      _time_start(other._time_start),
+      _time_increment(other._time_increment) {
+    other.accumulate();
+    read_lock_guard guard(other._mutex);
+    _time_series = other._time_series;
+}
+
+/**
+ * Reverberation time series for each receiver channel.
+ */
+const matrix<double> &rvbts_collection::time_series() const {
+    accumulate();
+    return _time_series;
+}
 
 /**
  * Adds the intensity contribution for a single bistatic eigenverb.
@@ -57,21 +159,35 @@ void rvbts_collection::add_biverb(const biverb_model::csptr &verb,
                                   const transmit_model::csptr &transmit,
                                   const bvector &steering) {
     static const double SQRT_TWO_PI = sqrt(TWO_PI);
+    write_lock_guard guard(_mutex);
 
     // find range of time indices to update
 
     const auto duration = verb->duration + transmit->duration;
     const auto delay = transmit->delay + verb->travel_time + duration;
-    size_t first = _travel_times->find_index(delay - 5.0 * duration);
-    size_t last = _travel_times->find_index(delay + 5.0 * duration);
-    range window(first, last);
-
-    // update Gaussian time series in this window
-
-    vector<double> times = _travel_times->data();
-    vector_range<vector<double> > tau(times, window);
-    vector<double> gaussian =
-        exp(-0.5 * abs2((tau - delay) / duration)) / (duration * SQRT_TWO_PI);
+    duration_class *bins = find_class(duration);
+    size_t first = 0;
+    vector<double> gaussian;
+    double position = 0.0;
+    if (bins == nullptr) {
+        first = _travel_times->find_index(delay - 5.0 * duration);
+        size_t last = _travel_times->find_index(delay + 5.0 * duration);
+        range window(first, last);
+
+        // update Gaussian time series in this window
+
+        vector<double> times = _travel_times->data();
+        vector_range<vector<double> > tau(times, window);
+        gaussian = exp(-0.5 * abs2((tau - delay) / duration)) /
+                   (duration * SQRT_TWO_PI);
+    } else {
+        // skip Gaussians that are entirely outside of the padded bins
+
+        position = (delay - _time_start) / _time_increment + (double)bins->pad;
+        if (position < 0.0 || position >= (double)bins->power.size2() - 1.0) {
+            return;
+        }
+    }
 
     // interpolate eigenverb power
 
@@ -116,6 +232,17 @@ void rvbts_collection::add_biverb(const biverb_model::csptr &verb,
             continue;
         }
 
+        // split power between the two nearest bins
+
+        if (bins != nullptr) {
+            const auto index = (size_t)position;
+            const double u = position - (double)index;
+            bins->power(rcv, index) += (1.0 - u) * rcv_level;
+            bins->power(rcv, index + 1) += u * rcv_level;
+            _dirty = true;
+            continue;
+        }
+
         // add scaled Gaussian to each result in time window
 
         for (size_t n = 0; n < gaussian.size(); ++n) {
@@ -125,10 +252,95 @@ void rvbts_collection::add_biverb(const biverb_model::csptr &verb,
     }
 }
 
+/**
+ * Find the duration class for a Gaussian.
+ */
+rvbts_collection::duration_class *rvbts_collection::find_class(
+    double duration) {
+    if (duration_resolution <= 0.0 || _time_increment <= 0.0 ||
+        duration < min_samples * _time_increment) {
+        return nullptr;
+    }
+    const double ratio = std::log1p(duration_resolution);
+    const int key =
+        (int)std::lround(std::log(duration / _time_increment) / ratio);
+    auto iter = _binned.find(key);
+    if (iter != _binned.end()) {
+        return &iter->second;
+    }
+    duration_class &bins = _binned[key];
+    bins.duration = _time_increment * std::exp(key * ratio);
+    bins.pad = (size_t)std::ceil(5.0 * bins.duration / _time_increment);
+    bins.power = zero_matrix<double>(_time_series.size1(),
+                                     _time_series.size2() + 2 * bins.pad);
+    return &bins;
+}
+
+/**
+ * Adds binned contributions to the time series.
+ */
+void rvbts_collection::accumulate() const {
+    static const double SQRT_TWO_PI = sqrt(TWO_PI);
+    write_lock_guard guard(_mutex);
+    if (!_dirty) {
+        return;
+    }
+    const size_t num_channels = _time_series.size1();
+    const size_t num_times = _time_series.size2();
+
+    for (auto &entry : _binned) {
+        const duration_class &bins = entry.second;
+        const size_t pad = bins.pad;
+        const size_t length = bins.power.size2();
+
+        // transform the Gaussian kernel, padded to avoid circular overlap
+
+        size_t fft_size = 1;
+        while (fft_size < length + 2 * pad) {
+            fft_size <<= 1;
+        }
+        std::vector<std::complex<double> > kernel(fft_size);
+        const double scale = 1.0 / (bins.duration * SQRT_TWO_PI);
+        for (size_t n = 0; n <= 2 * pad; ++n) {
+            const double t = ((double)n - (double)pad) * _time_increment;
+            kernel[n] = scale * std::exp(-0.5 * std::pow(t / bins.duration, 2));
+        }
+        fft(kernel, false);
+
+        // convolve two channels at a time, using real and imaginary parts
+
+        std::vector<std::complex<double> > signal(fft_size);
+        for (size_t rcv = 0; rcv < num_channels; rcv += 2) {
+            const bool pair = rcv + 1 < num_channels;
+            std::fill(signal.begin(), signal.end(), 0.0);
+            for (size_t n = 0; n < length; ++n) {
+                signal[n] = std::complex<double>(
+                    bins.power(rcv, n), pair ? bins.power(rcv + 1, n) : 0.0);
+            }
+            fft(signal, false);
+            for (size_t n = 0; n < fft_size; ++n) {
+                signal[n] *= kernel[n];
+            }
+            fft(signal, true);
+            for (size_t t = 0; t < num_times; ++t) {
+                const auto &value = signal[t + 2 * pad];
+                _time_series(rcv, t) += value.real();
+                if (pair) {
+                    _time_series(rcv + 1, t) += value.imag();
+                }
+            }
+        }
+    }
+    _binned.clear();
+    _dirty = false;
+}
+
 /**
  * Writes reverberation time series data to disk.
  */
 void rvbts_collection::write_netcdf(const char *filename) const {
+    accumulate();
+    std::lock_guard<std::mutex> lock(netcdf_utils::mutex());
     auto *nc_file = new NcFile(filename, NcFile::Replace);
 
     auto num_channels = (long)_time_series.size1();
@@ -225,3 +437,46 @@ void rvbts_collection::write_netcdf(const char *filename) const {
 
     delete nc_file;
 }
+
+/**
+ * Writes reverberation time series data to a columnar file.
+ */
+void rvbts_collection::write_columnar(const char *filename) const {
+    accumulate();
+    columnar_file file;
+    const size_t num_channels = _time_series.size1();
+    const size_t num_times = _time_series.size2();
+
+    // source and receiver parameters
+
+    orientation src_orient(_source_orient);
+    file.add("sourceID", "count", (int64_t)_source->keyID());
+    file.add("source_latitude", "degrees_north", _source_pos.latitude());
+    file.add("source_longitude", "degrees_east", _source_pos.longitude());
+    file.add("source_altitude", "meters", _source_pos.altitude());
+    file.add("source_yaw", "degrees", src_orient.yaw());
+    file.add("source_pitch", "degrees", src_orient.pitch());
+    file.add("source_roll", "degrees", src_orient.roll());
+    file.add("source_speed", "m/s", _source_speed);
+
+    orientation rcv_orient(_receiver_orient);
+    file.add("receiverID", "count", (int64_t)_receiver->keyID());
+    file.add("receiver_latitude", "degrees_north", _receiver_pos.latitude());
+    file.add("receiver_longitude", "degrees_east",
+             _receiver_pos.longitude());
+    file.add("receiver_altitude", "meters", _receiver_pos.altitude());
+    file.add("receiver_yaw", "degrees", rcv_orient.yaw());
+    file.add("receiver_pitch", "degrees", rcv_orient.pitch());
+    file.add("receiver_roll", "degrees", rcv_orient.roll());
+    file.add("receiver_speed", "m/s", _receiver_speed);
+
+    // data
+
+    seq_linear channels(0.0, 1.0, num_channels);
+    file.add("channels", "count", {num_channels}, channels.data().begin());
+    file.add("travel_time", "seconds", {num_times},
+             _travel_times->data().begin());
+    file.add("time_series", "", {num_channels, num_times},
+             _time_series.data().begin());
+    columnar_writer::instance()->write(filename, std::move(file));
+}
@@ -9,10 +9,12 @@
 #include <usml/transmit/transmit_model.h>
 #include <usml/types/orientation.h>
 #include <usml/types/seq_vector.h>
+#include <usml/threads/read_write_lock.h>
 #include <usml/types/wposition1.h>
 #include <usml/usml_config.h>
 
 #include <boost/numeric/ublas/matrix.hpp>
+#include <map>
 #include <memory>
 
 namespace usml {
@@ -46,6 +48,18 @@ class USML_DECLSPEC rvbts_collection {
      */
     static double power_threshold;
 
+    /**
+     * Relative spacing of the duration classes used to accumulate Gaussian
+     * contributions. Biverbs whose durations round to the same class are
+     * binned by channel and delay, and the time series for each class is
+     * computed by a single FFT convolution with that class's Gaussian.
+     * The duration of each Gaussian is rounded by no more than half this
+     * amount, which limits the error at the peak of each Gaussian to about
+     * half of this amount. Setting it to zero adds each biverb to the time series
+     * directly.
+     */
+    static double duration_resolution;
+
     /**
      * Initialize model parameters with state of sensor_pair at the time that
      * reverberation generator was created.
@@ -67,6 +81,14 @@ class USML_DECLSPEC rvbts_collection {
         const orientation& receiver_orient, const double receiver_speed,
         const seq_vector::csptr& travel_times);
 
+    /**
+     * Copies the time series of another collection, after adding its binned
+     * contributions.
+     *
+     * @param other     Collection to be copied.
+     */
+    rvbts_collection(const rvbts_collection& other);
+
     // Reference to source sensor.
     sensor_model::sptr source() const { return _source; }
 
@@ -94,8 +116,11 @@ class USML_DECLSPEC rvbts_collection {
     /// Receiver times at which reverberation is computed (sec).
     seq_vector::csptr travel_times() const { return _travel_times; }
 
-    /// Reverberation time series for each receiver channel.
-    const matrix<double>& time_series() const { return _time_series; }
+    /**
+     * Reverberation time series for each receiver channel. Calls accumulate()
+     * first, so that binned contributions are always included.
+     */
+    const matrix<double>& time_series() const;
 
     /**
      * Adds the intensity contribution for a single bistatic eigenverb.
@@ -116,6 +141,13 @@ class USML_DECLSPEC rvbts_collection {
      * channel. Interpolates eigenverb power to the transmit frequency. Applies
      * the source and receiver beam patterns to each eigenverb contribution.
      *
+     * If duration_resolution is non-zero, and the travel times are evenly
+     * spaced, the contribution is binned by duration class, channel, and
+     * delay instead. The binned contributions are added to the time series
+     * by accumulate(), the next time that the results are used. Gaussians narrower than min_samples time increments
+     * are always added directly, because binning the delay would distort
+     * their shape.
+     *
      * @param verb	   	Bistatic eigenverb for time series contribution.
      * @param transmit	Single waveform in a transmission schedule.
      * @param steering 	Transmit steering relative to source array.
@@ -125,7 +157,18 @@ class USML_DECLSPEC rvbts_collection {
                     const bvector& steering);
 
     /**
-     * Writes reverberation time series data to disk.
+     * Adds binned contributions to the time series. Convolves the binned
+     * power for each duration class with its Gaussian kernel using FFTs,
+     * then clears the bins. Does nothing if no contributions have been
+     * binned since the last call. Called by time_series(), write_netcdf(),
+     * and write_columnar(), so callers only need it to control when the
+     * convolutions are computed.
+     */
+    void accumulate() const;
+
+    /**
+     * Writes reverberation time series data to disk. Calls accumulate()
+     * first, so that binned contributions are always included.
      *
      * An example of the file format is given below.
      * <pre>
@@ -133,7 +176,42 @@ class USML_DECLSPEC rvbts_collection {
      */
     void write_netcdf(const char* filename) const;
 
+    /**
+     * Writes reverberation time series data to a columnar file, using the
+     * same variable names and units as write_netcdf(). Calls accumulate(),
+     * then copies the data into a columnar_file, then returns while the file is written by the
+     * columnar_writer on a background I/O thread.
+     *
+     * @param filename  Filename used to store this data.
+     */
+    void write_columnar(const char* filename) const;
+
    private:
+    /// Minimum Gaussian duration for binning, in time increments.
+    static const double min_samples;
+
+    /// Biverb power binned for a single class of Gaussian durations.
+    struct duration_class {
+        /// Duration of the Gaussian for this class (sec).
+        double duration;
+
+        /// Extra time samples before and after the time series.
+        size_t pad;
+
+        /// Binned power for each channel and padded travel time.
+        matrix<double> power;
+    };
+
+    /**
+     * Find the duration class for a Gaussian, creating it the first time
+     * that it is used.
+     *
+     * @param duration  Duration of the Gaussian (sec).
+     * @return          Bins for this duration, or nullptr if the Gaussian
+     *                  should be added directly.
+     */
+    duration_class* find_class(double duration);
+
     // Reference to source sensor
     const sensor_model::sptr _source;
 
@@ -164,8 +242,23 @@ class USML_DECLSPEC rvbts_collection {
     /// Receiver times at which reverberation is computed (sec).
     const seq_vector::csptr _travel_times;
 
+    /// First travel time, if travel times are evenly spaced (sec).
+    double _time_start{0.0};
+
+    /// Travel time increment, or zero if not evenly spaced (sec).
+    double _time_increment{0.0};
+
     /// Reverberation time series for each receiver channel.
-    matrix<double> _time_series;
+    mutable matrix<double> _time_series;
+
+    /// Binned biverb power, indexed by duration class.
+    mutable std::map<int, duration_class> _binned;
+
+    /// True if contributions have been binned since the last accumulate().
+    mutable bool _dirty{false};
+
+    /// Mutex used to lock updates to the time series and bins.
+    mutable read_write_lock _mutex;
 };
 
 /// @}
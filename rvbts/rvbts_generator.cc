@@ -39,19 +39,22 @@ rvbts_generator::rvbts_generator(const sensor_pair::sptr& pair,
       _travel_times(new seq_linear(receiver->time_minimum(), treverb,
                                    receiver->time_maximum())),
       _biverbs(biverbs),
-      _source_steering(compute_src_steering()) {
+      _source_steering(compute_src_steering(_source, _source_orient,
+                                           _transmit_schedule)) {
     add_listener(pair.get());
 }
 
 /**
  * Compute source steerings for each transmit waveform.
  */
-matrix<double> rvbts_generator::compute_src_steering() const {
+matrix<double> rvbts_generator::compute_src_steering(
+    const sensor_model::sptr& source, const orientation& source_orient,
+    const transmit_list& transmit_schedule) {
     // compute matrix of ordered steerings relative to host
 
-    matrix<double> steering(3, _transmit_schedule.size());
+    matrix<double> steering(3, transmit_schedule.size());
     int n = 0;
-    for (const auto& transmit : _transmit_schedule) {
+    for (const auto& transmit : transmit_schedule) {
         bvector ordered(transmit->orderedDE, transmit->orderedAZ);
         steering(0, n) = ordered.front();
         steering(1, n) = ordered.right();
@@ -61,7 +64,7 @@ matrix<double> rvbts_generator::compute_src_steering() const {
 
     // use these steerings if sensor has no host
 
-    const platform_model* host = _source->host();
+    const platform_model* host = source->host();
     if (host == nullptr) {
         return steering;
     }
@@ -75,7 +78,7 @@ matrix<double> rvbts_generator::compute_src_steering() const {
 
     // convert steerings from world to array coordinates
 
-    steering = prod(trans(_source_orient.rotation()), steering);
+    steering = prod(trans(source_orient.rotation()), steering);
     return steering;
 }
 
@@ -107,7 +110,7 @@ void rvbts_generator::run() {
                 bvector steering(
                     matrix_column<matrix<double> >(_source_steering, n));
                 collection->add_biverb(verb, transmit, steering);
-                if (_abort) {
+                if (checkpoint()) {
                     cout << "task #" << id()
                          << " rvbts_generator *** aborted during execution ***"
                          << endl;
@@ -120,6 +123,7 @@ void rvbts_generator::run() {
 
     // notify listeners of results
 
+    collection->accumulate();
     _done = true;
     notify_update(&result);
     cout << "task #" << id() << " rvbts_generator: done" << endl;
@@ -65,7 +65,6 @@ class USML_DECLSPEC rvbts_generator
      */
     virtual void run();
 
-   private:
     /**
      * Compute source steerings for each transmit waveform. Steerings in the
      * transmission schedule are defined relative to the orientation of the host
@@ -76,9 +75,18 @@ class USML_DECLSPEC rvbts_generator
      *
      * Receiver beam patterns are less work because their steering directions
      * are defined relative to the array and not the array's host platform.
+     *
+     * @param source            Reference to the source sensor.
+     * @param source_orient     Orientation of the source array.
+     * @param transmit_schedule List of transmit pulses for this source.
+     * @return                  Steerings in array coordinates, one column
+     *                          for each pulse in the transmit schedule.
      */
-    matrix<double> compute_src_steering() const;
+    static matrix<double> compute_src_steering(
+        const sensor_model::sptr& source, const orientation& source_orient,
+        const transmit_list& transmit_schedule);
 
+   private:
     /// Human readable name for this object instance.
     const std::string _description;
 
@@ -0,0 +1,59 @@
+/**
+ * @file rvbts_stream.cc
+ * Accumulates reverberation time series one travel time window at a time.
+ */
+
+#include <usml/rvbts/rvbts_generator.h>
+#include <usml/rvbts/rvbts_stream.h>
+#include <usml/types/bvector.h>
+#include <usml/types/seq_linear.h>
+
+#include <boost/numeric/ublas/matrix_proxy.hpp>
+
+using namespace usml::rvbts;
+
+/**
+ * Initialize model parameters with state of sensor_pair at this time.
+ */
+rvbts_stream::rvbts_stream(const sensor_pair::sptr& pair,
+                           const sensor_model::sptr& source,
+                           const sensor_model::sptr& receiver,
+                           const double treverb)
+    : _transmit_schedule(source->transmit_schedule()),
+      _source_steering(rvbts_generator::compute_src_steering(
+          source, source->orient(), _transmit_schedule)),
+      _collection(source, source->position(), source->orient(),
+                  source->speed(), receiver, receiver->position(),
+                  receiver->orient(), receiver->speed(),
+                  seq_vector::csptr(new seq_linear(receiver->time_minimum(),
+                                                   treverb,
+                                                   receiver->time_maximum()))) {
+    add_listener(pair.get());
+}
+
+/**
+ * Add the contribution of the bistatic eigenverbs in a travel time window.
+ */
+void rvbts_stream::add_window(const biverb_collection& biverbs, double t_min,
+                              double t_max) {
+    rvbts_collection::csptr result;
+    {
+        std::lock_guard<std::mutex> guard(_mutex);
+        for (size_t interface = 0; interface < biverbs.num_interfaces();
+             ++interface) {
+            for (const auto& verb : biverbs.biverbs(interface, t_min, t_max)) {
+                int n = 0;
+                for (const auto& transmit : _transmit_schedule) {
+                    bvector steering(
+                        matrix_column<const matrix<double> >(_source_steering,
+                                                             n));
+                    _collection.add_biverb(verb, transmit, steering);
+                    ++n;
+                }
+            }
+        }
+        _collection.accumulate();
+        result = std::make_shared<rvbts_collection>(_collection);
+    }
+    notify_update(&result);
+}
@@ -0,0 +1,95 @@
+/**
+ * @file rvbts_stream.h
+ * Accumulates reverberation time series one travel time window at a time.
+ */
+#pragma once
+
+#include <usml/biverbs/biverb_collection.h>
+#include <usml/managed/update_notifier.h>
+#include <usml/rvbts/rvbts_collection.h>
+#include <usml/sensors/sensor_model.h>
+#include <usml/sensors/sensor_pair.h>
+#include <usml/transmit/transmit_model.h>
+#include <usml/types/orientation.h>
+#include <usml/types/seq_vector.h>
+#include <usml/types/wposition1.h>
+#include <usml/usml_config.h>
+
+#include <boost/numeric/ublas/matrix.hpp>
+#include <memory>
+#include <mutex>
+
+namespace usml {
+namespace rvbts {
+
+using namespace usml::managed;
+using namespace usml::sensors;
+using namespace usml::transmit;
+using namespace usml::types;
+
+/// @ingroup rvbts
+/// @{
+
+/**
+ * Accumulates reverberation time series for a bistatic pair one travel
+ * time window at a time. Used as the window listener of a biverb_generator
+ * that is streaming its results. Each window of bistatic eigenverbs is
+ * added to a running time series, and update listeners are notified with
+ * a snapshot of the time series after every window, so that the early
+ * part of the reverberation is available before the biverb_generator
+ * has finished.
+ *
+ * Unlike rvbts_generator, this is not a thread_task. Its work is done
+ * inside the biverb_generator's thread, and it stops receiving windows
+ * when that task is aborted.
+ */
+class USML_DECLSPEC rvbts_stream
+    : public update_notifier<rvbts_collection::csptr> {
+   public:
+    /// Shared pointer to an instance of this class.
+    typedef std::shared_ptr<rvbts_stream> sptr;
+
+    /**
+     * Initialize stream with state of sensor_pair at this time. Makes copies
+     * of the position, orientation, speed, and transmit pulses at the time
+     * that the stream is constructed to ensure that the state of the sensor
+     * pair is consistent across all windows.
+     *
+     * @param pair       	Object to notify after each window.
+     * @param source      	Reference to the source for this pair.
+     * @param receiver    	Reference to the receiver for this pair.
+     * @param treverb		Time increment for reverberation time series.
+     */
+    rvbts_stream(const sensor_pair::sptr& pair,
+                 const sensor_model::sptr& source,
+                 const sensor_model::sptr& receiver, const double treverb);
+
+    /**
+     * Add the contribution of the bistatic eigenverbs in a travel time
+     * window to the time series, and notify listeners with a snapshot
+     * of the results so far.
+     *
+     * @param biverbs   Bistatic eigenverbs computed so far.
+     * @param t_min     Start of the travel time window (sec).
+     * @param t_max     End of the travel time window (sec).
+     */
+    void add_window(const biverb_collection& biverbs, double t_min,
+                    double t_max);
+
+   private:
+    /// List of transmit pulses for this source.
+    const transmit_list _transmit_schedule;
+
+    /// Source steerings relative to source array orientation.
+    const matrix<double> _source_steering;
+
+    /// Reverberation time series accumulated so far.
+    rvbts_collection _collection;
+
+    /// Serializes windows from concurrent callers.
+    std::mutex _mutex;
+};
+
+/// @}
+}  // end of namespace rvbts
+}  // end of namespace usml
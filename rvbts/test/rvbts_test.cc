@@ -10,6 +10,7 @@
 #include <usml/managed/managed_obj.h>
 #include <usml/managed/manager_template.h>
 #include <usml/managed/update_listener.h>
+#include <usml/netcdf/columnar_writer.h>
 #include <usml/ocean/ocean_utils.h>
 #include <usml/platforms/platform_manager.h>
 #include <usml/platforms/platform_model.h>
@@ -21,14 +22,21 @@
 #include <usml/threads/thread_task.h>
 #include <usml/transmit/transmit_cw.h>
 #include <usml/transmit/transmit_model.h>
+#include <usml/types/bvector.h>
 #include <usml/types/seq_linear.h>
 #include <usml/types/seq_vector.h>
 #include <usml/types/wposition1.h>
 
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/vector.hpp>
 #include <boost/test/unit_test.hpp>
+#include <boost/timer/timer.hpp>
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <list>
 #include <memory>
+#include <random>
 #include <sstream>
 #include <string>
 
@@ -36,6 +44,7 @@ BOOST_AUTO_TEST_SUITE(rvbts_test)
 
 using namespace usml::sensors;
 using namespace usml::sensors;
+using namespace usml::netcdf;
 using namespace usml::rvbts;
 using namespace usml::transmit;
 
@@ -161,6 +170,9 @@ BOOST_AUTO_TEST_CASE(update_envelope) {
             filename << ncname << "biverbs_" << pair->hash_key() << ".nc";
             cout << "writing to " << filename.str() << endl;
             pair->biverbs()->write_netcdf(filename.str().c_str(), 0);
+            std::ostringstream colname;
+            colname << ncname << "biverbs_" << pair->hash_key() << ".col";
+            pair->biverbs()->write_columnar(colname.str().c_str(), 0);
         }
         {
             BOOST_REQUIRE(pair->rvbts() != nullptr);
@@ -168,8 +180,13 @@ BOOST_AUTO_TEST_CASE(update_envelope) {
             filename << ncname << "rvbts_" << pair->hash_key() << ".nc";
             cout << "writing to " << filename.str() << endl;
             pair->rvbts()->write_netcdf(filename.str().c_str());
+            std::ostringstream colname;
+            colname << ncname << "rvbts_" << pair->hash_key() << ".col";
+            pair->rvbts()->write_columnar(colname.str().c_str());
         }
     }
+    columnar_writer::instance()->flush();
+    BOOST_CHECK_EQUAL(columnar_writer::instance()->num_errors(), 0);
 
     // clean up and exit
 
@@ -177,5 +194,98 @@ BOOST_AUTO_TEST_CASE(update_envelope) {
     sensor_manager::reset();
 }
 
+/**
+ * Compares the binned, FFT based accumulation of Gaussian contributions to
+ * the direct method, for a dense set of random biverbs with a wide range of
+ * durations. Uses an odd number of receiver channels so that the unpaired
+ * channel in the FFT convolution is tested. Generates errors if the peak
+ * normalized difference exceeds half of the duration_resolution. Also
+ * checks that time_series() includes binned contributions without an
+ * explicit call to accumulate().
+ */
+BOOST_AUTO_TEST_CASE(binned_gaussian) {
+    cout << "=== rvbts_test: binned_gaussian ===" << endl;
+    const size_t num_verbs = 20000;
+
+    auto beam = bp_model::csptr(new bp_omni());
+    sensor_model::sptr sensor(
+        new sensor_model(1, "binned", 0.0, wposition1(0.0, 0.0, -100.0)));
+    sensor->src_beam(0, beam);
+    for (int rcv = 0; rcv < 3; ++rcv) {
+        sensor->rcv_beam(rcv, beam);
+    }
+    transmit_model::csptr transmit(new transmit_cw("CW", 0.2, 1000.0));
+    seq_vector::csptr times(new seq_linear(0.0, 0.01, 20.0));
+    seq_vector::csptr freq(new seq_linear(1000.0, 1.0, 1));
+    bvector steering(0.0, 0.0);
+
+    // create random biverbs
+
+    std::mt19937 random(1);
+    std::uniform_real_distribution<double> travel_time(1.0, 15.0);
+    std::uniform_real_distribution<double> duration(0.0, 0.5);
+    std::uniform_real_distribution<double> power(0.5, 1.0);
+    std::list<biverb_model::csptr> verbs;
+    for (size_t n = 0; n < num_verbs; ++n) {
+        auto verb = std::make_shared<biverb_model>();
+        verb->travel_time = travel_time(random);
+        verb->frequencies = freq;
+        verb->power = scalar_vector<double>(1, power(random));
+        verb->duration = duration(random);
+        verb->source_de = verb->source_az = 0.0;
+        verb->receiver_de = verb->receiver_az = 0.0;
+        verbs.push_back(verb);
+    }
+
+    // accumulate time series with direct and binned methods
+
+    rvbts_collection direct(sensor, sensor->position(), sensor->orient(), 0.0,
+                            sensor, sensor->position(), sensor->orient(), 0.0,
+                            times);
+    rvbts_collection binned(direct);
+    rvbts_collection lazy(direct);
+    const double resolution = rvbts_collection::duration_resolution;
+    {
+        cout << "direct: ";
+        boost::timer::auto_cpu_timer timer;
+        rvbts_collection::duration_resolution = 0.0;
+        for (const auto& verb : verbs) {
+            direct.add_biverb(verb, transmit, steering);
+        }
+        rvbts_collection::duration_resolution = resolution;
+    }
+    {
+        cout << "binned: ";
+        boost::timer::auto_cpu_timer timer;
+        for (const auto& verb : verbs) {
+            binned.add_biverb(verb, transmit, steering);
+        }
+        binned.accumulate();
+    }
+    for (const auto& verb : verbs) {
+        lazy.add_biverb(verb, transmit, steering);
+    }
+
+    // compare results
+
+    const matrix<double>& expected = direct.time_series();
+    const matrix<double>& actual = binned.time_series();
+    for (size_t rcv = 0; rcv < expected.size1(); ++rcv) {
+        double peak = 0.0;
+        double error = 0.0;
+        for (size_t t = 0; t < expected.size2(); ++t) {
+            peak = std::max(peak, expected(rcv, t));
+            error =
+                std::max(error, std::abs(actual(rcv, t) - expected(rcv, t)));
+        }
+        cout << "channel " << rcv << " peak=" << peak
+             << " error=" << error / peak << endl;
+        BOOST_CHECK_GT(peak, 0.0);
+        BOOST_CHECK_SMALL(error / peak, 0.5 * resolution);
+    }
+    const matrix<double>& unflushed = lazy.time_series();
+    BOOST_CHECK_EQUAL(norm_inf(unflushed - actual), 0.0);
+}
+
 /// @}
 BOOST_AUTO_TEST_SUITE_END()
@@ -5,10 +5,13 @@
 
 #include <usml/managed/managed_obj.h>
 #include <usml/managed/update_notifier.h>
+#include <usml/ocean/ocean_shared.h>
 #include <usml/platforms/platform_manager.h>
 #include <usml/sensors/sensor_manager.h>
+#include <usml/threads/task_scheduler.h>
 
 #include <list>
+#include <set>
 #include <utility>
 
 using namespace usml::sensors;
@@ -44,6 +47,7 @@ sensor_manager* sensor_manager::instance() {
  */
 void sensor_manager::reset() {
     write_lock_guard guard(_mutex);
+    task_scheduler::reset();
     _instance.reset();
     usml::platforms::platform_manager::reset();
 }
@@ -64,6 +68,35 @@ void sensor_manager::frequencies(const seq_vector::csptr& freq) {
     _frequencies = freq;
 }
 
+/**
+ * Moves the shared ocean to a new time, and re-computes acoustics for
+ * the sensors where that change matters.
+ */
+size_t sensor_manager::ocean_update(double time) {
+    auto previous = ocean::ocean_shared::update(time);
+    auto current = ocean::ocean_shared::current();
+    if (previous == current) {
+        return 0;
+    }
+
+    // copy sensor IDs so that updates run without locking the manager
+
+    std::set<uint64_t> sensors;
+    {
+        read_lock_guard guard(_mutex);
+        sensors.insert(_src_list.begin(), _src_list.end());
+        sensors.insert(_rcv_list.begin(), _rcv_list.end());
+    }
+    size_t count = 0;
+    for (auto keyID : sensors) {
+        auto sensor = find_sensor(keyID);
+        if (sensor != nullptr && sensor->ocean_update(previous, current)) {
+            ++count;
+        }
+    }
+    return count;
+}
+
 /**
  * Adds a sensor into the bistatic pair manager.
  */
@@ -129,6 +162,10 @@ void sensor_manager::remove_sensor(const sensor_model::sptr& sensor,
     remove_multistatic_source(sensor, listener);
     remove_multistatic_receiver(sensor, listener);
 
+    // abort acoustic updates waiting in the task_scheduler
+
+    task_scheduler::instance()->cancel(sensor.get());
+
     // remove reference from platform_manager
 
     platform_manager::instance()->remove(sensor->keyID());
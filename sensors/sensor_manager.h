@@ -57,7 +57,7 @@ class USML_DECLSPEC sensor_manager : public manager_template<sensor_pair> {
 
     /**
      * Removes all sensors from the manager and destroys it.
-     * Also destroys the platform_manager as a side effect.
+     * Also destroys the task_scheduler and platform_manager as a side effect.
      */
     static void reset();
 
@@ -125,6 +125,19 @@ class USML_DECLSPEC sensor_manager : public manager_template<sensor_pair> {
      */
     pair_list find_receiver(sensor_model::key_type keyID);
 
+    /**
+     * Moves the time varying components of the shared ocean to a new time,
+     * and re-computes acoustics for the sensors where that change matters.
+     * Uses ocean_shared::update() to advance the forecast, and then passes
+     * the previous and current oceans to sensor_model::ocean_update() for
+     * each active sensor. Sensors whose local change is below the
+     * motion_thresholds keep their current acoustics.
+     *
+     * @param time      Time at which to evaluate forecasts (sec).
+     * @return          Number of sensors that were forced to update.
+     */
+    size_t ocean_update(double time);
+
    private:
     /**
      * Adds a monostatic sensor pair if new sensor being added is both a source
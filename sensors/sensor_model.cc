@@ -5,13 +5,14 @@
 
 #include <usml/biverbs/biverb_collection.h>
 #include <usml/managed/manager_template.h>
+#include <usml/ocean/ocean_shared.h>
+#include <usml/ocean/ocean_utils.h>
 #include <usml/platforms/motion_thresholds.h>
 #include <usml/platforms/platform_manager.h>
 #include <usml/sensors/sensor_manager.h>
 #include <usml/sensors/sensor_model.h>
 #include <usml/sensors/sensor_pair.h>
-#include <usml/threads/thread_controller.h>
-#include <usml/threads/thread_pool.h>
+#include <usml/threads/task_scheduler.h>
 #include <usml/threads/thread_task.h>
 #include <usml/types/wposition.h>
 #include <usml/wavegen/wavefront_generator.h>
@@ -186,7 +187,8 @@ void sensor_model::update_internals(time_t time, const wposition1& pos,
                 _wavefront_task->abort();
             }
 
-            // launch a new wavefront generator
+            // schedule a new wavefront generator, coalesced with other
+            // updates in the same debounce window
 
             wposition tpos(targets.size(), 1);
             matrix<uint64_t> targetIDs(targets.size(), 1);
@@ -205,35 +207,61 @@ void sensor_model::update_internals(time_t time, const wposition1& pos,
             _wavefront_task = std::make_shared<wavefront_generator>(
                 this, tpos, targetIDs, frequencies, _de_fan, _az_fan,
                 _time_step, _time_maximum, _intensity_threshold, _max_bottom,
-                _max_surface);
-            thread_controller::instance()->run(_wavefront_task);
+                _max_surface, _de_refine, _eigenverb_merge);
+            task_scheduler::instance()->schedule(this, _wavefront_task,
+                                                 _update_window);
+
+            // start loading environment ahead of a moving sensor
+
+            if (speed > 0.0) {
+                orientation heading(orient);
+                wposition1 ahead(pos, speed * motion_thresholds::prefetch_time,
+                                 to_radians(heading.yaw()));
+                ocean::ocean_utils::prefetch_region(
+                    ocean::ocean_shared::current(), ahead,
+                    _time_maximum * ocean::ocean_utils::max_speed);
+            }
         }
     }
 }
 
+/**
+ * Re-computes acoustics if a change in the shared ocean is large enough
+ * to matter at the location of this sensor.
+ */
+bool sensor_model::ocean_update(const ocean::ocean_model::csptr& previous,
+                                const ocean::ocean_model::csptr& current) {
+    if (!previous || !current || previous == current) {
+        return false;
+    }
+    time_t time;
+    wposition1 pos;
+    orientation orient;
+    double speed;
+    get_motion(&time, &pos, &orient, &speed);
+
+    auto change = ocean::ocean_shared::compare(previous, current, pos);
+    if (change.speed < motion_thresholds::speed_threshold &&
+        change.surface < motion_thresholds::height_threshold &&
+        change.bottom < motion_thresholds::height_threshold) {
+        return false;
+    }
+    update(time, pos, orient, speed, FORCE_UPDATE);
+    return true;
+}
+
+/**
+ * True if this sensor has a wavefront_generator that has not completed.
+ */
+bool sensor_model::wavefront_pending() const {
+    read_lock_guard guard(mutex());
+    return _wavefront_task != nullptr && !_wavefront_task->done();
+}
+
 /**
  * Get list of acoustic targets near this sensor.
  */
 std::list<platform_model::sptr> sensor_model::find_targets() {
-    double min_range2 = _min_range * _min_range;
-    double max_range2 = _max_range * _max_range;
-    wposition1 object_pos = position();
-
-    std::list<platform_model::sptr> targets;
-    for (const auto& platform : platform_manager::instance()->list()) {
-        if (platform->is_acoustic_target()) {
-            if (min_range2 < DBL_EPSILON && max_range2 < DBL_EPSILON) {
-                targets.push_back(platform);
-            } else {
-                wposition1 platform_pos = platform->position();
-                double distance2 = platform_pos.distance2(object_pos);
-                if (distance2 >= min_range2) {
-                    if (max_range2 < DBL_EPSILON || distance2 <= max_range2) {
-                        targets.push_back(platform);
-                    }
-                }
-            }
-        }
-    }
-    return targets;
+    return platform_manager::instance()->find_targets(position(), _min_range,
+                                                      _max_range);
 }
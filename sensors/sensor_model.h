@@ -7,6 +7,7 @@
 #include <bits/types/time_t.h>
 #include <usml/beampatterns/bp_model.h>
 #include <usml/managed/managed_obj.h>
+#include <usml/ocean/ocean_model.h>
 #include <usml/platforms/platform_model.h>
 #include <usml/threads/read_write_lock.h>
 #include <usml/transmit/transmit_model.h>
@@ -68,12 +69,15 @@ using namespace usml::wavegen;
  *
  * Automatically launches a background task to recompute eigenrays and
  * eigenverbs when sensor motion exceeds position or orientation thresholds. The
- * find_targets() calculation searches the platform_manager for all platforms
- * and sensors sensors between the maximum and minimum slant range. If an
+ * find_targets() calculation uses the platform_manager spatial index to search
+ * for all platforms and sensors between the maximum and minimum slant range,
+ * without testing platforms that are far outside of the maximum range. If an
  * existing wavefront_generator is running for this sensor, that task is aborted
- * before the new background task is created. Uses update_notifier to notify
- * listeners when eigenray and eigenverb data has changed. Does not notify
- * listeners when other fields like position and orientation change.
+ * before the new background task is created. New tasks are passed to the
+ * task_scheduler, which coalesces bursts of updates within update_window().
+ * Uses update_notifier to notify listeners when eigenray and eigenverb data
+ * has changed. Does not notify listeners when other fields like position and
+ * orientation change.
  */
 class USML_DECLSPEC sensor_model : public platform_model,
                                    public wavefront_notifier {
@@ -120,6 +124,17 @@ class USML_DECLSPEC sensor_model : public platform_model,
     /// List of depression/elevation angles to use in wavefront calculation.
     void de_fan(seq_vector::csptr value) { _de_fan = value; }
 
+    /**
+     * Divergence tolerance for adaptive refinement of the D/E fan.
+     * When non-zero, the wavefront_generator surveys the environment with
+     * de_fan() and adds rays wherever the spreading between neighboring
+     * D/E rays exceeds this ratio. Zero disables refinement.
+     */
+    double de_refine() const { return _de_refine; }
+
+    /// Divergence tolerance for adaptive refinement of the D/E fan.
+    void de_refine(double value) { _de_refine = value; }
+
     /// List of azimuthal angles  to use in wavefront calculation.
     seq_vector::csptr az_fan() const { return _az_fan; }
 
@@ -180,6 +195,31 @@ class USML_DECLSPEC sensor_model : public platform_model,
     /// True if eigenverbs computed for this sensor.
     void compute_reverb(bool value) { _compute_reverb = value; }
 
+    /**
+     * Power tolerance for merging overlapping eigenverbs (dB). When non-zero,
+     * the wavefront_generator merges co-located eigenverbs into larger
+     * Gaussians, as long as the peak intensity of each merged eigenverb is
+     * reduced by no more than this value. Zero disables merging.
+     * See eigenverb_collection::merge() for details.
+     */
+    double eigenverb_merge() const { return _eigenverb_merge; }
+
+    /// Power tolerance for merging overlapping eigenverbs (dB).
+    void eigenverb_merge(double value) { _eigenverb_merge = value; }
+
+    /**
+     * Travel time window for streaming reverberation results (sec). When
+     * non-zero for the receiver of a sensor_pair, the biverb_generator
+     * processes eigenverbs in travel time order, and publishes a partial
+     * reverberation time series at the end of each window, so that the
+     * early part of the time series is available before the full
+     * calculation is complete. Zero disables streaming.
+     */
+    double reverb_window() const { return _reverb_window; }
+
+    /// Travel time window for streaming reverberation results (sec).
+    void reverb_window(double value) { _reverb_window = value; }
+
     /**
      * Multi-static group for this sensor (0=none). The sensor_manager
      * automatically creates bistatic pairs for sources and receivers in the
@@ -190,6 +230,18 @@ class USML_DECLSPEC sensor_model : public platform_model,
     /// Multi-static group for this sensor (0=none).
     void multistatic(uint64_t value) { _multistatic = value; }
 
+    /**
+     * Debounce window for acoustic updates (sec). Motion updates that cross
+     * the motion_thresholds within this window of the first one are coalesced
+     * into a single wavefront_generator task, which is launched by the
+     * task_scheduler when the window expires. Zero launches each task
+     * immediately.
+     */
+    double update_window() const { return _update_window; }
+
+    /// Debounce window for acoustic updates (sec).
+    void update_window(double value) { _update_window = value; }
+
     /// Reset source beams.
     void reset_src_beams();
 
@@ -266,9 +318,33 @@ class USML_DECLSPEC sensor_model : public platform_model,
         return _wavefront_task;
     }
 
+    /**
+     * True if this sensor has a wavefront_generator that is waiting in the
+     * task_scheduler or running in the thread_pool. Used by sensor_pair to
+     * defer downstream calculations until the eigenverbs for both sensors are
+     * final.
+     */
+    bool wavefront_pending() const;
+
     /// Force wavefront calculation on next update.
     void set_needs_update() { _needs_update = true; }
 
+    /**
+     * Re-computes acoustics if a change in the shared ocean is large enough
+     * to matter at the location of this sensor. Uses ocean_shared::compare()
+     * to find the largest change in the water column below the sensor, and
+     * forces an update if the change in sound speed or boundary height
+     * exceeds the motion_thresholds. Invoked by sensor_manager::ocean_update()
+     * to avoid the re-propagation of every sensor when the ocean forecast
+     * advances.
+     *
+     * @param previous  Ocean before the change.
+     * @param current   Ocean after the change.
+     * @return          True if the change forced an acoustic update.
+     */
+    bool ocean_update(const ocean::ocean_model::csptr& previous,
+                      const ocean::ocean_model::csptr& current);
+
    protected:
     /**
      * Updates the internal state of this platform and its children. Starts
@@ -310,6 +386,9 @@ class USML_DECLSPEC sensor_model : public platform_model,
     /// List of depression/elevation angles to use in wavefront calculation.
     seq_vector::csptr _de_fan{seq_vector::csptr(new seq_rayfan())};
 
+    /// Divergence tolerance for adaptive refinement of the D/E fan.
+    double _de_refine{0.0};
+
     /// List of azimuthal angles  to use in wavefront calculation.
     seq_vector::csptr _az_fan{
         seq_vector::csptr(new seq_linear(0.0, 10.0, 360.0))};
@@ -347,9 +426,18 @@ class USML_DECLSPEC sensor_model : public platform_model,
     /// True if computing reverberation from this sensor.
     bool _compute_reverb{false};
 
+    /// Power tolerance for merging overlapping eigenverbs (dB).
+    double _eigenverb_merge{0.0};
+
+    /// Travel time window for streaming reverberation results (sec).
+    double _reverb_window{0.0};
+
     /// Multi-static group for this sensor (0=none).
     uint64_t _multistatic{0};
 
+    /// Debounce window for acoustic updates (sec).
+    double _update_window{0.0};
+
     /// Source beam patterns.
     beam_map_type _src_beams;
 
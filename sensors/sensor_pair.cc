@@ -8,6 +8,7 @@
 #include <usml/managed/manager_template.h>
 #include <usml/platforms/platform_model.h>
 #include <usml/rvbts/rvbts_generator.h>
+#include <usml/rvbts/rvbts_stream.h>
 #include <usml/sensors/sensor_manager.h>
 #include <usml/sensors/sensor_pair.h>
 #include <usml/threads/thread_controller.h>
@@ -83,28 +84,25 @@ void sensor_pair::update_wavefront_data(
         // eigenray collection has eigenray list for all targets near this
         // sensor find the eigenray list specific to this pair
 
+        // uses the hashed target index, so the cost of this lookup does
+        // not grow with the number of targets in the wavefront
+
         auto sourceID = _source->keyID();
         auto targetID = _receiver->keyID();
         wposition1 source_pos(_source->position());
         wposition1 receiver_pos(_receiver->position());
-        eigenray_list raylist = eigenrays->find_eigenrays(targetID);
+        const bool reciprocal =
+            _source != _receiver && sensor->keyID() == _receiver->keyID();
 
         // swap source/receiver sense of direct path eigenrays, if needed
 
-        if (_source != _receiver && sensor->keyID() == _receiver->keyID()) {
+        if (reciprocal) {
             sourceID = _receiver->keyID();
             targetID = _source->keyID();
             source_pos = _receiver->position();
             receiver_pos = _source->position();
-            eigenray_list new_list;
-            for (const auto& ray : eigenrays->find_eigenrays(targetID)) {
-                auto* copy = new eigenray_model(*ray);
-                std::swap(copy->source_de, copy->target_de);
-                std::swap(copy->source_az, copy->target_az);
-                new_list.push_back(eigenray_model::csptr(copy));
-            }
-            raylist = new_list;  // replace original list
         }
+        const eigenray_list& raylist = eigenrays->find_eigenrays(targetID);
 
         // create new direct path collection with just rays for a single target
 
@@ -115,7 +113,11 @@ void sensor_pair::update_wavefront_data(
             eigenrays->frequencies(), _source->position(),
             wposition(receiver_pos), sourceID, receiverID,
             eigenrays->coherent());
-        for (const auto& ray : raylist) {
+        eigenray_list reversed;
+        if (reciprocal) {
+            reversed = eigenray_collection::reciprocal(raylist);
+        }
+        for (const auto& ray : reciprocal ? reversed : raylist) {
             collection->add_eigenray(0, 0, ray);
         }
         collection->sum_eigenrays();
@@ -136,18 +138,38 @@ void sensor_pair::update_wavefront_data(
 
             // launch a new bistatic eigenverb generator background task
 
-            if (_src_eigenverbs != nullptr && _rcv_eigenverbs != nullptr) {
-                if (_biverb_task != nullptr) {  // abort incomplete tasks
-                    _biverb_task->abort();
+            // defer until eigenverbs from both sensors are final
+
+            if (_src_eigenverbs != nullptr && _rcv_eigenverbs != nullptr &&
+                !upstream_pending()) {
+                auto previous = _biverb_task.lock();
+                if (previous != nullptr) {  // abort incomplete tasks
+                    previous->abort();
                 }
                 sensor_pair::sptr reference =
                     sensor_manager::instance()->find(keyID());
                 eigenverb_collection::csptr src_verbs = _src_eigenverbs;
                 eigenverb_collection::csptr rcv_verbs = _rcv_eigenverbs;
-                _biverb_task = std::make_shared<biverb_generator>(
+                auto task = std::make_shared<biverb_generator>(
                     reference, src_verbs, rcv_verbs);
-                thread_controller::instance()->run(_biverb_task);
-                _biverb_task.reset();  // destroy background task shared pointer
+
+                // stream reverberation time series in travel time windows
+
+                const double window = _receiver->reverb_window();
+                if (window > 0.0 && !_source->transmit_schedule().empty()) {
+                    auto previous_rvbts = _rvbts_task.lock();
+                    if (previous_rvbts != nullptr) {
+                        previous_rvbts->abort();
+                    }
+                    auto stream = std::make_shared<rvbts_stream>(
+                        reference, _source, _receiver, treverb());
+                    task->stream(window, [stream](const biverb_collection& b,
+                                                  double t_min, double t_max) {
+                        stream->add_window(b, t_min, t_max);
+                    });
+                }
+                _biverb_task = task;
+                thread_controller::instance()->run(task);
             }
         }
     }
@@ -172,30 +194,29 @@ void sensor_pair::notify_update(const biverb_collection::csptr* object) {
             return;
         }
 
-        // compute treverb from transmit schedule
+        // skip time series if these biverbs have already been superseded
+        // or if the time series was streamed by the biverb_generator
 
-        const double treverb_min = 0.1;
-        double treverb = 0.0;
-        for (const auto& transmit : _source->transmit_schedule()) {
-            if (treverb == 0.0) {
-                treverb = transmit->duration;
-            } else {
-                treverb = std::min(treverb, transmit->duration);
-            }
+        notify_early = false;
+        auto latest = _biverb_task.lock();
+        if ((latest != nullptr && !latest->done()) || upstream_pending()) {
+            return;
+        }
+        if (latest != nullptr && latest->streaming()) {
+            return;
         }
-        treverb = std::max(treverb_min, treverb / 2.0);
 
         // launch a new reverberation time series generator background task
 
-        notify_early = false;
-        if (_rvbts_task != nullptr) {  // abort incomplete tasks
-            _rvbts_task->abort();
+        auto previous = _rvbts_task.lock();
+        if (previous != nullptr) {  // abort incomplete tasks
+            previous->abort();
         }
         sensor_pair::sptr reference = sensor_manager::instance()->find(keyID());
-        _rvbts_task = std::make_shared<rvbts_generator>(
-            reference, _source, _receiver, treverb, _biverbs);
-        thread_controller::instance()->run(_rvbts_task);
-        _rvbts_task.reset();  // destroy background task shared pointer
+        auto task = std::make_shared<rvbts_generator>(
+            reference, _source, _receiver, treverb(), _biverbs);
+        _rvbts_task = task;
+        thread_controller::instance()->run(task);
     }
     if (notify_early) {
         notify_update(this);
@@ -220,3 +241,26 @@ void sensor_pair::notify_update(const rvbts_collection::csptr* object) {
 void sensor_pair::notify_update(const sensor_pair* object) const {
     this->update_notifier<sensor_pair>::notify_update(object);
 }
+
+/**
+ * Time increment for reverberation time series.
+ */
+double sensor_pair::treverb() const {
+    const double treverb_min = 0.1;
+    double treverb = 0.0;
+    for (const auto& transmit : _source->transmit_schedule()) {
+        if (treverb == 0.0) {
+            treverb = transmit->duration;
+        } else {
+            treverb = std::min(treverb, transmit->duration);
+        }
+    }
+    return std::max(treverb_min, treverb / 2.0);
+}
+
+/**
+ * True if either sensor has a wavefront_generator that has not completed.
+ */
+bool sensor_pair::upstream_pending() const {
+    return _source->wavefront_pending() || _receiver->wavefront_pending();
+}
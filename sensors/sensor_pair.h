@@ -162,7 +162,13 @@ class USML_DECLSPEC sensor_pair
      * object before notifying sensor_pair listeners of the change.
      *
      * Aborts previous biverb_generator if new calculation required before old
-     * one has been completed.
+     * one has been completed. Defers the biverb_generator if either sensor
+     * has a wavefront_generator that has not completed, because those
+     * eigenverbs are about to be replaced. The deferred calculation is
+     * launched when the last of these wavefront_generator tasks completes.
+     * If the receiver has a non-zero reverb_window(), the biverb_generator
+     * streams its results to an rvbts_stream, which publishes partial
+     * reverberation time series as each travel time window is completed.
      *
      * @param sensor		Pointer to updated sensor.
      * @param eigenrays		Transmission loss results for this sensor
@@ -183,7 +189,10 @@ class USML_DECLSPEC sensor_pair
      * object before notifying sensor_pair listeners of the change.
      *
      * Aborts previous rvbts_generator if new calculation required before old
-     * one has been completed.
+     * one has been completed. Does not launch a rvbts_generator if these
+     * bistatic eigenverbs have already been superseded by a newer
+     * biverb_generator or wavefront_generator task, or if the time series
+     * has already been streamed by the biverb_generator.
      *
      * @param  object	Updated bistatic eigenverbs collection.
      */
@@ -191,7 +200,8 @@ class USML_DECLSPEC sensor_pair
 
     /**
      * Update reverberation time series using results of the rvbts_generator
-     * background task. Stores a reference to the reverberation time series then
+     * background task, or a partial result from an rvbts_stream. Stores a
+     * reference to the reverberation time series then
      * notifies listeners that this sensor_pair has been updated.
      *
      * Locks the object while this update is taking place. Then unlocks the
@@ -241,11 +251,25 @@ class USML_DECLSPEC sensor_pair
     /// Reverberation time series time series.
     rvbts_collection::csptr _rvbts;
 
-    /// Background task used to generate biverb objects.
-    std::shared_ptr<biverb_generator> _biverb_task;
+    /// Background task used to generate biverb objects. Weak reference
+    /// avoids a cycle with the task's reference to this pair.
+    std::weak_ptr<biverb_generator> _biverb_task;
 
     /// Background task used to generate reverberation time series objects.
-    std::shared_ptr<rvbts_generator> _rvbts_task;
+    /// Weak reference avoids a cycle with the task's reference to this pair.
+    std::weak_ptr<rvbts_generator> _rvbts_task;
+
+    /**
+     * Time increment for reverberation time series. Half of the shortest
+     * pulse in the source's transmit schedule, with a minimum of 0.1 sec.
+     */
+    double treverb() const;
+
+    /**
+     * True if the inputs to downstream calculations are about to be replaced
+     * by a wavefront_generator that has not completed for either sensor.
+     */
+    bool upstream_pending() const;
 };
 
 typedef std::list<sensor_pair::sptr> pair_list;
@@ -10,7 +10,12 @@
 #include <usml/managed/managed_obj.h>
 #include <usml/managed/manager_template.h>
 #include <usml/managed/update_listener.h>
+#include <usml/ocean/boundary_flat.h>
+#include <usml/ocean/ocean_model.h>
+#include <usml/ocean/ocean_shared.h>
 #include <usml/ocean/ocean_utils.h>
+#include <usml/ocean/profile_forecast.h>
+#include <usml/ocean/profile_linear.h>
 #include <usml/platforms/platform_manager.h>
 #include <usml/platforms/platform_model.h>
 #include <usml/sensors/sensor_manager.h>
@@ -211,6 +216,47 @@ BOOST_AUTO_TEST_CASE(update_wavefront_data) {
     sensor_manager::reset();
 }
 
+/**
+ * Tests the ability to skip acoustic updates when the ocean forecast
+ * changes by a small amount at the sensor location. Uses a forecast whose
+ * surface sound speed changes by 10 m/s over an hour. Moving the forecast
+ * forward by one minute changes the sound speed by much less than the
+ * speed_threshold, and should not schedule a new wavefront_generator.
+ * Moving it to the end of the hour should schedule one. Uses a one second
+ * debounce window so that the new task is still pending when it is checked.
+ */
+BOOST_AUTO_TEST_CASE(ocean_update) {
+    cout << "=== sensors_test: ocean_update ===" << endl;
+    profile_forecast::epochs_type::epoch_map epochs;
+    epochs[0.0] = profile_model::csptr(new profile_linear(1500.0, 0.016));
+    epochs[3600.0] = profile_model::csptr(new profile_linear(1510.0, 0.016));
+    ocean_shared::update(ocean_model::csptr(new ocean_model(
+        boundary_model::csptr(new boundary_flat()),
+        boundary_model::csptr(new boundary_flat(-1000.0)),
+        profile_model::csptr(new profile_forecast(epochs, 0.0)))));
+
+    auto* sensor_mgr = sensor_manager::instance();
+    sensor_mgr->frequencies(seq_vector::csptr(new seq_linear(3000.0, 1.0, 1)));
+    auto* sensor_ptr = new simple_sonobuoy(1, "simple_sonobuoy", 0.0,
+                                           wposition1(36.0, 16.0, -100.0));
+    sensor_ptr->time_maximum(1.0);
+    sensor_ptr->compute_reverb(true);
+    sensor_ptr->update_window(1.0);
+    sensor_model::sptr sensor(sensor_ptr);
+    sensor_mgr->add_sensor(sensor);
+    BOOST_CHECK(!sensor->wavefront_pending());
+
+    BOOST_CHECK_EQUAL(sensor_mgr->ocean_update(60.0), 0);
+    BOOST_CHECK(!sensor->wavefront_pending());
+
+    BOOST_CHECK_EQUAL(sensor_mgr->ocean_update(3600.0), 1);
+    BOOST_CHECK(sensor->wavefront_pending());
+    thread_task::wait();
+
+    sensor_manager::reset();
+    ocean_shared::reset();
+}
+
 /// @}
 
 BOOST_AUTO_TEST_SUITE_END()
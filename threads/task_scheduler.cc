@@ -0,0 +1,261 @@
+/**
+ * @file task_scheduler.cc
+ * Coalesces bursts of background tasks before passing them to thread_pool.
+ */
+
+#include <usml/threads/task_scheduler.h>
+#include <usml/threads/thread_controller.h>
+#include <usml/threads/thread_pool.h>
+
+using namespace usml::threads;
+
+/** Initializes empty reference to singleton. */
+std::unique_ptr<task_scheduler> task_scheduler::_instance;
+
+/** Initializes mutex for singleton construction. */
+read_write_lock task_scheduler::_instance_mutex;
+
+/**
+ * Singleton constructor, implemented using double-checked locking pattern.
+ */
+task_scheduler* task_scheduler::instance() {
+    task_scheduler* scheduler = _instance.get();
+    if (scheduler == nullptr) {
+        write_lock_guard guard(_instance_mutex);
+        scheduler = _instance.get();
+        if (scheduler == nullptr) {
+            scheduler = new task_scheduler();
+            _instance.reset(scheduler);
+        }
+    }
+    return scheduler;
+}
+
+/**
+ * Aborts all pending tasks and destroys the singleton.
+ */
+void task_scheduler::reset() {
+    write_lock_guard guard(_instance_mutex);
+    _instance.reset();
+}
+
+/**
+ * Stops the dispatcher thread, resumes preempted tasks, and flushes pending
+ * tasks.
+ */
+task_scheduler::~task_scheduler() {
+    _active = false;
+    if (_dispatcher.joinable()) {
+        _dispatcher.join();
+    }
+    write_lock_guard guard(_mutex);
+    for (auto& entry : _running) {
+        auto task = running(entry.first);
+        if (entry.second.preempted && task != nullptr) {
+            task->resume();
+        }
+    }
+    for (auto& entry : _pending) {
+        entry.second.task->abort();
+        thread_controller::instance()->run(entry.second.task);
+    }
+    _pending.clear();
+}
+
+/**
+ * Schedule a task to be run on behalf of an owner.
+ */
+void task_scheduler::schedule(const void* owner, const thread_task::ref& task,
+                              double window, int priority) {
+    write_lock_guard guard(_mutex);
+    auto superseded = running(owner);
+    if (superseded != nullptr) {
+        superseded->abort();
+    }
+    auto iter = _pending.find(owner);
+
+    // launch immediately if there is no debounce window
+
+    if (window <= 0.0) {
+        if (iter != _pending.end()) {
+            iter->second.task->abort();
+            thread_controller::instance()->run(iter->second.task);
+            _pending.erase(iter);
+        }
+        launch(owner, task, priority);
+        return;
+    }
+
+    // replace pending task, but keep its deadline
+
+    if (iter != _pending.end()) {
+        iter->second.task->abort();
+        thread_controller::instance()->run(iter->second.task);
+        iter->second.task = task;
+        iter->second.priority = priority;
+        return;
+    }
+    auto delay = std::chrono::duration_cast<clock_type::duration>(
+        std::chrono::duration<double>(window));
+    _pending[owner] = pending_task{clock_type::now() + delay, task, priority};
+    if (!_dispatcher.joinable()) {
+        _dispatcher = std::thread(&task_scheduler::dispatch, this);
+    }
+}
+
+/**
+ * Aborts the pending and running tasks for an owner.
+ */
+bool task_scheduler::cancel(const void* owner) {
+    write_lock_guard guard(_mutex);
+    auto task = running(owner);
+    if (task != nullptr) {
+        task->abort();
+    }
+    _running.erase(owner);
+    auto iter = _pending.find(owner);
+    if (iter == _pending.end()) {
+        return false;
+    }
+    iter->second.task->abort();
+    thread_controller::instance()->run(iter->second.task);
+    _pending.erase(iter);
+    return true;
+}
+
+/**
+ * Suspends the running task for an owner at its next checkpoint.
+ */
+bool task_scheduler::pause(const void* owner) {
+    read_lock_guard guard(_mutex);
+    auto task = running(owner);
+    if (task == nullptr) {
+        return false;
+    }
+    task->pause();
+    return true;
+}
+
+/**
+ * Resumes a running task that was suspended by pause().
+ */
+bool task_scheduler::resume(const void* owner) {
+    read_lock_guard guard(_mutex);
+    auto task = running(owner);
+    if (task == nullptr) {
+        return false;
+    }
+    task->resume();
+    return true;
+}
+
+/**
+ * Number of tasks waiting for their debounce window to expire.
+ */
+size_t task_scheduler::num_pending() const {
+    read_lock_guard guard(_mutex);
+    return _pending.size();
+}
+
+/**
+ * Number of owners whose last dispatched task is still tracked.
+ */
+size_t task_scheduler::num_running() const {
+    read_lock_guard guard(_mutex);
+    return _running.size();
+}
+
+/**
+ * Passes tasks to the thread_pool when their deadline expires.
+ */
+void task_scheduler::dispatch() {
+    while (_active) {
+        {
+            write_lock_guard guard(_mutex);
+            const auto now = clock_type::now();
+            auto iter = _pending.begin();
+            while (iter != _pending.end()) {
+                if (iter->second.deadline <= now) {
+                    launch(iter->first, iter->second.task,
+                           iter->second.priority);
+                    iter = _pending.erase(iter);
+                } else {
+                    ++iter;
+                }
+            }
+            resume_preempted();
+        }
+        thread_task::sleep();
+    }
+}
+
+/**
+ * Passes a task to the thread_pool and remembers it as the running task.
+ */
+void task_scheduler::launch(const void* owner, const thread_task::ref& task,
+                            int priority) {
+    bool preempted = false;
+    auto iter = _running.begin();
+    while (iter != _running.end()) {
+        auto other = running(iter->first);
+        if (other == nullptr) {
+            iter = _running.erase(iter);
+            continue;
+        }
+        if (iter->first != owner && iter->second.priority < priority &&
+            !other->paused()) {
+            other->pause();
+            iter->second.preempted = true;
+            preempted = true;
+        }
+        ++iter;
+    }
+    _running[owner] = running_task{task, priority, false};
+    thread_controller::instance()->run(task);
+    if (preempted && !_dispatcher.joinable()) {
+        _dispatcher = std::thread(&task_scheduler::dispatch, this);
+    }
+}
+
+/**
+ * Resumes preempted tasks once no running task has a higher priority.
+ */
+void task_scheduler::resume_preempted() {
+    for (auto& entry : _running) {
+        if (!entry.second.preempted) {
+            continue;
+        }
+        auto task = running(entry.first);
+        if (task == nullptr) {
+            entry.second.preempted = false;
+            continue;
+        }
+        bool urgent = false;
+        for (const auto& other : _running) {
+            if (other.second.priority > entry.second.priority &&
+                running(other.first) != nullptr) {
+                urgent = true;
+                break;
+            }
+        }
+        if (!urgent) {
+            task->resume();
+            entry.second.preempted = false;
+        }
+    }
+}
+
+/**
+ * Find the running task for an owner.
+ */
+thread_task::ref task_scheduler::running(const void* owner) const {
+    auto iter = _running.find(owner);
+    if (iter == _running.end()) {
+        return nullptr;
+    }
+    auto task = iter->second.task.lock();
+    if (task != nullptr && (task->done() || task->finished())) {
+        return nullptr;
+    }
+    return task;
+}
@@ -0,0 +1,214 @@
+/**
+ * @file task_scheduler.h
+ * Coalesces bursts of background tasks before passing them to thread_pool.
+ */
+#pragma once
+
+#include <usml/threads/read_write_lock.h>
+#include <usml/threads/thread_task.h>
+#include <usml/usml_config.h>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <thread>
+
+namespace usml {
+namespace threads {
+
+/// @ingroup threads
+/// @{
+
+/**
+ * Singleton that coalesces bursts of background tasks before passing them
+ * to the thread_controller. Each task is scheduled on behalf of an owner,
+ * and each owner can have at most one pending task. The scheduler holds a
+ * new task for a debounce window. If the same owner schedules another task
+ * before the window expires, the pending task is replaced by the new one,
+ * but the deadline of the original request is kept. This bounds the delay
+ * of each update to the length of the window, while limiting the thread_pool
+ * to a single task per owner in each window.
+ *
+ * Replaced tasks are aborted and passed directly to the thread_pool, where
+ * they terminate as soon as they start. This keeps thread_task::num_active()
+ * consistent, because each task is counted as active from the time it is
+ * created until the time its run() method returns. Tasks with a zero length
+ * window are passed directly to the thread_pool.
+ *
+ * The scheduler also remembers the last task that it dispatched for each
+ * owner. Scheduling a new task aborts that task if it is still running,
+ * so that superseded work releases its core at the next
+ * thread_task::checkpoint(). Entries for tasks that have completed, or
+ * been destroyed, are pruned each time a task is launched, so this list
+ * is bounded by the number of owners with live tasks.
+ *
+ * Each task is scheduled with a priority. When a task is launched, the
+ * scheduler pauses every running task with a lower priority, so that the
+ * urgent work gets their cores at their next thread_task::checkpoint().
+ * The thread_pool starts a replacement worker for each paused task, so the
+ * urgent task is not queued behind paused workers. A preempted task is
+ * resumed once no running task has a higher priority than it does. The
+ * pause() and resume() methods let callers suspend an owner's running task
+ * directly. Tasks paused by the caller are only resumed by the caller.
+ *
+ * A dispatcher thread polls for pending tasks whose deadline has expired,
+ * and for preempted tasks that can be resumed, using the same sleep
+ * interval as the thread_pool workers. The thread is only created the
+ * first time that a task is delayed or preempted.
+ */
+class USML_DECLSPEC task_scheduler {
+   public:
+    /**
+     * Provides a reference to the task_scheduler singleton. If this is the
+     * first time that this has been invoked, the singleton is automatically
+     * constructed.
+     *
+     * @return  Reference to the task_scheduler singleton.
+     */
+    static task_scheduler* instance();
+
+    /**
+     * Aborts all pending tasks and destroys the singleton.
+     */
+    static void reset();
+
+    /**
+     * Stops the dispatcher thread. Resumes preempted tasks. Aborts all
+     * pending tasks and passes them to the thread_pool so that they can
+     * terminate.
+     */
+    ~task_scheduler();
+
+    /**
+     * Schedule a task to be run on behalf of an owner. Replaces any pending
+     * task for the same owner, and aborts the last task dispatched for this
+     * owner if it is still running. Pauses running tasks with a lower
+     * priority when this task is launched.
+     *
+     * @param owner     Object that owns this task. Often the "this" pointer
+     *                  of the object that would have launched the task.
+     * @param task      Shared pointer to the task to be executed.
+     * @param window    Length of the debounce window (sec).
+     *                  Runs the task immediately if this is zero.
+     * @param priority  Urgency of this task, larger numbers are more urgent.
+     */
+    void schedule(const void* owner, const thread_task::ref& task,
+                  double window = 0.0, int priority = 0);
+
+    /**
+     * Aborts the pending and running tasks for an owner. Used when
+     * the owner is about to be destroyed.
+     *
+     * @param owner     Object that owns this task.
+     * @return          False if this owner did not have a pending task.
+     */
+    bool cancel(const void* owner);
+
+    /**
+     * Suspends the running task for an owner at its next checkpoint.
+     *
+     * @param owner     Object that owns this task.
+     * @return          False if this owner does not have a running task.
+     */
+    bool pause(const void* owner);
+
+    /**
+     * Resumes a running task that was suspended by pause().
+     *
+     * @param owner     Object that owns this task.
+     * @return          False if this owner does not have a running task.
+     */
+    bool resume(const void* owner);
+
+    /**
+     * Number of tasks waiting for their debounce window to expire.
+     */
+    size_t num_pending() const;
+
+    /**
+     * Number of owners whose last dispatched task is still tracked by
+     * the scheduler.
+     */
+    size_t num_running() const;
+
+   private:
+    /// Type used to measure deadlines.
+    typedef std::chrono::steady_clock clock_type;
+
+    /// Task waiting for its debounce window to expire.
+    struct pending_task {
+        clock_type::time_point deadline;  ///< Time to launch task.
+        thread_task::ref task;            ///< Latest task for this owner.
+        int priority;                     ///< Urgency of this task.
+    };
+
+    /// Task that has been passed to the thread_pool.
+    struct running_task {
+        std::weak_ptr<thread_task> task;  ///< Last task for this owner.
+        int priority;                     ///< Urgency of this task.
+        bool preempted;                   ///< Paused by the scheduler.
+    };
+
+    /// Reference to singleton.
+    static std::unique_ptr<task_scheduler> _instance;
+
+    /// Mutex for singleton access.
+    static read_write_lock _instance_mutex;
+
+    /// Mutex used to lock updates to the list of pending tasks.
+    mutable read_write_lock _mutex;
+
+    /// Latest pending task for each owner.
+    std::map<const void*, pending_task> _pending;
+
+    /// Last task dispatched to the thread_pool for each owner.
+    std::map<const void*, running_task> _running;
+
+    /// Thread that launches tasks when their deadline expires.
+    std::thread _dispatcher;
+
+    /// Flag that controls execution of dispatcher loop.
+    std::atomic<bool> _active{true};
+
+    /// Hide default constructor to prevent incorrect use of singleton.
+    task_scheduler() {}
+
+    /**
+     * Passes tasks to the thread_pool when their deadline expires, and
+     * resumes preempted tasks. Invoked by the dispatcher thread.
+     */
+    void dispatch();
+
+    /**
+     * Passes a task to the thread_pool and remembers it as the running
+     * task for its owner. Pauses running tasks with a lower priority, and
+     * prunes the entries for other owners whose tasks have completed.
+     * Assumes that the caller has locked the mutex.
+     *
+     * @param owner     Object that owns this task.
+     * @param task      Shared pointer to the task to be executed.
+     * @param priority  Urgency of this task.
+     */
+    void launch(const void* owner, const thread_task::ref& task,
+                int priority);
+
+    /**
+     * Resumes preempted tasks once no running task has a higher priority.
+     * Assumes that the caller has locked the mutex.
+     */
+    void resume_preempted();
+
+    /**
+     * Find the running task for an owner. Assumes that the caller has
+     * locked the mutex.
+     *
+     * @param owner     Object that owns this task.
+     * @return          Running task, or nullptr if it has finished.
+     */
+    thread_task::ref running(const void* owner) const;
+};
+
+/// @}
+}  // end of namespace threads
+}  // end of namespace usml
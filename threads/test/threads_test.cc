@@ -5,6 +5,7 @@
 #include <bits/stdint-intn.h>
 #include <cstddef>
 #include <usml/threads/read_write_lock.h>
+#include <usml/threads/task_scheduler.h>
 #include <usml/threads/thread_controller.h>
 #include <usml/threads/thread_pool.h>
 #include <usml/threads/thread_task.h>
@@ -12,8 +13,10 @@
 
 #include <boost/test/unit_test.hpp>
 #include <boost/timer/timer.hpp>
+#include <atomic>
 #include <cmath>
 #include <iostream>
+#include <vector>
 #include <memory>
 
 BOOST_AUTO_TEST_SUITE(threads_test)
@@ -253,6 +256,50 @@ class sqrt_task_tester {
     }
 };
 
+/**
+ * Task that counts the number of times it has been executed without
+ * being aborted.
+ */
+class count_task : public thread_task {
+   public:
+    /// Number of tasks that have executed without being aborted.
+    static std::atomic<size_t> num_run;
+
+    /**
+     * Increments the number of tasks executed, unless aborted.
+     */
+    void run() override {
+        if (!_abort) {
+            ++num_run;
+        }
+        _done = true;
+    }
+};
+
+/** Number of tasks that have executed without being aborted. */
+std::atomic<size_t> count_task::num_run = 0;
+
+/**
+ * Task that loops until aborted, counting the number of checkpoints
+ * that it passes through.
+ */
+class loop_task : public thread_task {
+   public:
+    /// Number of checkpoints passed by this task.
+    std::atomic<size_t> num_loops{0};
+
+    /**
+     * Increments the number of loops at each checkpoint, until aborted.
+     */
+    void run() override {
+        while (!checkpoint()) {
+            ++num_loops;
+            sleep();
+        }
+        _done = true;
+    }
+};
+
 /**
  * @ingroup threads_test
  * @{
@@ -291,6 +338,206 @@ BOOST_AUTO_TEST_CASE(thread_controller_test) {
     #endif
 }
 
+/**
+ * Test the ability of task_scheduler to coalesce a burst of tasks from the
+ * same owner into a single task. Schedules five tasks for one owner within
+ * a 0.2 sec debounce window, and one task for a second owner without a
+ * debounce window.
+ *
+ * This test passes if:
+ *   - the first owner has a single pending task after the burst
+ *   - the second owner's task is not delayed
+ *   - only two tasks execute without being aborted
+ */
+BOOST_AUTO_TEST_CASE(task_scheduler_test) {
+    cout << "=== threads_test: task_scheduler_test ===" << endl;
+    task_scheduler* scheduler = task_scheduler::instance();
+    count_task::num_run = 0;
+    int owner1;
+    int owner2;
+
+    std::shared_ptr<count_task> task;
+    for (size_t n = 0; n < 5; ++n) {
+        task = std::make_shared<count_task>();
+        scheduler->schedule(&owner1, task, 0.2);
+    }
+    scheduler->schedule(&owner2, std::make_shared<count_task>());
+    BOOST_CHECK_EQUAL(scheduler->num_pending(), 1);
+    BOOST_CHECK(!task->done());
+
+    thread_task::wait(5000);
+    BOOST_CHECK(task->done());
+    BOOST_CHECK_EQUAL(scheduler->num_pending(), 0);
+    BOOST_CHECK_EQUAL(count_task::num_run, 2);
+    task_scheduler::reset();
+}
+
+/**
+ * Test the ability of task_scheduler to preempt a running task. Launches a
+ * task that loops until aborted, pauses and resumes it through the
+ * scheduler, and then supersedes it with a new task for the same owner.
+ *
+ * This test passes if:
+ *   - the running task stops making progress while paused
+ *   - the running task continues after it is resumed
+ *   - the running task is aborted when a new task is scheduled
+ */
+BOOST_AUTO_TEST_CASE(task_preempt_test) {
+    cout << "=== threads_test: task_preempt_test ===" << endl;
+    task_scheduler* scheduler = task_scheduler::instance();
+    count_task::num_run = 0;
+    int owner;
+
+    auto task = std::make_shared<loop_task>();
+    scheduler->schedule(&owner, task);
+    while (task->num_loops == 0) {
+        thread_task::sleep();
+    }
+    BOOST_CHECK(scheduler->pause(&owner));
+    thread_task::sleep(20);
+    const size_t paused = task->num_loops;
+    thread_task::sleep(50);
+    BOOST_CHECK_EQUAL(task->num_loops, paused);
+    BOOST_CHECK(!task->done());
+
+    BOOST_CHECK(scheduler->resume(&owner));
+    thread_task::sleep(50);
+    BOOST_CHECK(task->num_loops > paused);
+
+    scheduler->schedule(&owner, std::make_shared<count_task>());
+    BOOST_CHECK(task->aborted());
+    thread_task::wait(5000);
+    BOOST_CHECK(task->done());
+    BOOST_CHECK_EQUAL(count_task::num_run, 1);
+    task_scheduler::reset();
+}
+
+/**
+ * Test that the task_scheduler forgets the tasks of owners that have
+ * completed. Launches one task for each of ten owners, waits for them to
+ * finish, and then launches a task for one more owner.
+ *
+ * This test passes if:
+ *   - the scheduler tracks all ten tasks while they are running
+ *   - only the last task is tracked after the others complete
+ */
+BOOST_AUTO_TEST_CASE(task_prune_test) {
+    cout << "=== threads_test: task_prune_test ===" << endl;
+    task_scheduler* scheduler = task_scheduler::instance();
+    int owners[11];
+
+    std::vector<std::shared_ptr<loop_task>> tasks;
+    for (size_t n = 0; n < 10; ++n) {
+        tasks.push_back(std::make_shared<loop_task>());
+        scheduler->schedule(&owners[n], tasks.back());
+    }
+    BOOST_CHECK_EQUAL(scheduler->num_running(), 10);
+    for (auto& task : tasks) {
+        task->abort();
+    }
+    thread_task::wait(5000);
+
+    scheduler->schedule(&owners[10], std::make_shared<count_task>());
+    BOOST_CHECK_EQUAL(scheduler->num_running(), 1);
+    thread_task::wait(5000);
+    task_scheduler::reset();
+}
+
+/**
+ * Test that the task_scheduler pauses lower priority tasks when urgent
+ * work arrives. Uses a thread_pool with a single worker, and fills it with
+ * a low priority loop_task. Then schedules a high priority count_task for
+ * another owner.
+ *
+ * This test passes if:
+ *   - the urgent task runs, even though the only worker is blocked by
+ *     the paused task
+ *   - the low priority task is paused while the urgent task runs
+ *   - the low priority task is resumed after the urgent task completes
+ */
+BOOST_AUTO_TEST_CASE(task_priority_test) {
+    cout << "=== threads_test: task_priority_test ===" << endl;
+    thread_controller::reset(1);
+    task_scheduler* scheduler = task_scheduler::instance();
+    count_task::num_run = 0;
+    int background;
+    int urgent;
+
+    auto task = std::make_shared<loop_task>();
+    scheduler->schedule(&background, task, 0.0, 0);
+    while (task->num_loops == 0) {
+        thread_task::sleep();
+    }
+    scheduler->schedule(&urgent, std::make_shared<count_task>(), 0.0, 1);
+    BOOST_CHECK(task->paused());
+    for (int n = 0; n < 5000 && count_task::num_run == 0; ++n) {
+        thread_task::sleep();
+    }
+    BOOST_CHECK_EQUAL(count_task::num_run, 1);
+
+    for (int n = 0; n < 5000 && task->paused(); ++n) {
+        thread_task::sleep();
+    }
+    BOOST_CHECK(!task->paused());
+    const size_t resumed = task->num_loops;
+    thread_task::sleep(50);
+    BOOST_CHECK(task->num_loops > resumed);
+
+    task->abort();
+    thread_task::wait(5000);
+    task_scheduler::reset();
+    thread_controller::reset();
+}
+
+/**
+ * Test the ability of thread_pool::run_blocks() to split a range across
+ * the workers of the pool, and to compute it serially when it is called
+ * from one of those workers.
+ *
+ * This test passes if:
+ *   - every index is computed exactly once
+ *   - a nested call from a pool task completes without waiting on the pool
+ */
+BOOST_AUTO_TEST_CASE(run_blocks_test) {
+    cout << "=== threads_test: run_blocks_test ===" << endl;
+    thread_controller::reset(4);
+    thread_pool* pool = thread_controller::instance();
+    std::vector<int> count(1000, 0);
+    pool->run_blocks(count.size(), [&](size_t first, size_t last) {
+        for (size_t n = first; n < last; ++n) {
+            ++count[n];
+        }
+    });
+    for (size_t n = 0; n < count.size(); ++n) {
+        BOOST_CHECK_EQUAL(count[n], 1);
+    }
+
+    // nested call from inside a pool task
+
+    class nested_task : public thread_task {
+       public:
+        nested_task(thread_pool* pool, std::vector<int>& count)
+            : _pool(pool), _count(count) {}
+        void run() override {
+            _pool->run_blocks(_count.size(), [&](size_t first, size_t last) {
+                for (size_t n = first; n < last; ++n) {
+                    ++_count[n];
+                }
+            });
+        }
+
+       private:
+        thread_pool* _pool;
+        std::vector<int>& _count;
+    };
+    pool->run(std::make_shared<nested_task>(pool, count));
+    thread_task::wait(5000);
+    for (size_t n = 0; n < count.size(); ++n) {
+        BOOST_CHECK_EQUAL(count[n], 2);
+    }
+    thread_controller::reset();
+}
+
 /// @}
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -5,6 +5,7 @@
 
 #include <usml/threads/thread_pool.h>
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <iostream>
@@ -14,44 +15,39 @@
 using namespace usml::threads;
 using namespace std::chrono_literals;
 
+namespace {
+
+/// True on threads that execute the tasks of a thread_pool.
+thread_local bool is_worker = false;
+
 /**
- * Creates a new thread pool with a specific number of threads.
- *
+ * Task that computes one block of a thread_pool::run_blocks() range.
  */
-thread_pool::thread_pool(unsigned num_threads) {
-    assert(num_threads != 0);
+class block_task : public thread_task {
+   public:
+    block_task(const std::function<void(size_t, size_t)>& func, size_t first,
+               size_t last)
+        : _func(func), _first(first), _last(last) {}
 
-    // Use a lambda expression to create an infinite loop that
-    // checks for (and then executes) new entries in the _task_queue
-    // until _running is false.
-
-    auto worker = [this] {
-        while (this->_running) {
-            // find the next task in the queue
-
-            thread_task::ref task;
-            {
-                write_lock_guard guard(_task_mutex);
-                if (!_task_queue.empty()) {
-                    task = _task_queue.front();
-                    _task_queue.pop();
-                }
-            }
+    void run() override { _func(_first, _last); }
 
-            // run this task or wait for a short time
+   private:
+    const std::function<void(size_t, size_t)>& _func;
+    const size_t _first;
+    const size_t _last;
+};
 
-            if (task != nullptr) {
-                task->start();
-            } else {
-                thread_task::sleep();
-            }
-        }
-    };
-
-    // create a list of threads using this worker
+}  // namespace
 
+/**
+ * Creates a new thread pool with a specific number of threads.
+ *
+ */
+thread_pool::thread_pool(unsigned num_threads) : _num_threads(num_threads) {
+    assert(num_threads != 0);
+    write_lock_guard guard(_thread_mutex);
     for (unsigned n = 0; n < num_threads; ++n) {
-        _thread_list.emplace_back(worker);
+        spawn();
     }
 }
 
@@ -59,9 +55,13 @@ thread_pool::thread_pool(unsigned num_threads) {
  * Stop the scheduler and terminate the threads used to execute tasks.
  */
 thread_pool::~thread_pool() {
-    write_lock_guard guard(_task_mutex);
     this->_running = false;
-    for (auto& thread : _thread_list) {
+    std::vector<std::thread> threads;
+    {
+        write_lock_guard guard(_thread_mutex);
+        threads.swap(_thread_list);
+    }
+    for (auto& thread : threads) {
         thread.join();
     }
 }
@@ -71,5 +71,113 @@ thread_pool::~thread_pool() {
  */
 void thread_pool::run(const thread_task::ref& task) {
     write_lock_guard guard(_task_mutex);
+    task->_pool = this;
     _task_queue.push(task);
 }
+
+/**
+ * Computes blocks of a range on the workers of this pool.
+ */
+void thread_pool::run_blocks(
+    size_t size, const std::function<void(size_t, size_t)>& func) {
+    const size_t num_blocks = std::min(size, _num_threads);
+    if (num_blocks < 2 || is_worker) {
+        func(0, size);
+        return;
+    }
+    std::vector<thread_task::ref> tasks;
+    tasks.reserve(num_blocks);
+    const size_t block = (size + num_blocks - 1) / num_blocks;
+    for (size_t first = 0; first < size; first += block) {
+        tasks.push_back(std::make_shared<block_task>(
+            func, first, std::min(first + block, size)));
+        run(tasks.back());
+    }
+    for (const auto& task : tasks) {
+        while (!task->finished()) {
+            thread_task::sleep();
+        }
+    }
+}
+
+/**
+ * Checks for (and then executes) new entries in the _task_queue
+ * until _running is false.
+ */
+void thread_pool::work() {
+    is_worker = true;
+    while (this->_running) {
+        // find the next task in the queue
+
+        thread_task::ref task;
+        {
+            write_lock_guard guard(_task_mutex);
+            if (!_task_queue.empty()) {
+                task = _task_queue.front();
+                _task_queue.pop();
+            }
+        }
+
+        // run this task or wait for a short time
+
+        if (task != nullptr) {
+            task->start();
+        } else {
+            thread_task::sleep();
+        }
+        if (retire()) {
+            return;
+        }
+    }
+}
+
+/**
+ * Starts a new worker thread.
+ */
+void thread_pool::spawn() {
+    for (const auto& id : _retired) {
+        for (auto iter = _thread_list.begin(); iter != _thread_list.end();
+             ++iter) {
+            if (iter->get_id() == id) {
+                iter->join();
+                _thread_list.erase(iter);
+                break;
+            }
+        }
+    }
+    _retired.clear();
+    ++_num_workers;
+    _thread_list.emplace_back(&thread_pool::work, this);
+}
+
+/**
+ * Removes the calling worker if the pool has too many free workers.
+ */
+bool thread_pool::retire() {
+    write_lock_guard guard(_thread_mutex);
+    if (_num_workers - _num_parked <= _num_threads) {
+        return false;
+    }
+    --_num_workers;
+    _retired.push_back(std::this_thread::get_id());
+    return true;
+}
+
+/**
+ * Starts a replacement worker for a task that is blocked by pause().
+ */
+void thread_pool::park() {
+    write_lock_guard guard(_thread_mutex);
+    ++_num_parked;
+    if (_running && _num_workers - _num_parked < _num_threads) {
+        spawn();
+    }
+}
+
+/**
+ * Called by a paused task when it continues.
+ */
+void thread_pool::unpark() {
+    write_lock_guard guard(_thread_mutex);
+    --_num_parked;
+}
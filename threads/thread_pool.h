@@ -9,6 +9,8 @@
 #include <usml/usml_config.h>
 
 #include <atomic>
+#include <cstddef>
+#include <functional>
 #include <queue>
 #include <thread>
 #include <vector>
@@ -25,11 +27,19 @@ namespace threads {
  * simultaneously on a specific computer. It also avoids the overhead
  * associated with starting each task on its own thread.
  *
+ * A task that is suspended by thread_task::pause() blocks its worker at
+ * its next checkpoint. The pool then starts a replacement worker, so that
+ * the number of workers that are free to run tasks stays the same. When
+ * the task is resumed, the first worker to become idle exits, to bring
+ * the number of running workers back down to the size of the pool.
+ *
  * @xref Vorbrodt's C++ Blog: Advanced thread pool
  *       Posted on February 27, 2019 by Martin Vorbrodt
  *       https://vorbrodt.blog/2019/02/27/advanced-thread-pool/
  */
 class USML_DECLSPEC thread_pool {
+    friend class thread_task;
+
    public:
     /**
      * Creates a new thread pool with a specific number of threads.
@@ -54,10 +64,39 @@ class USML_DECLSPEC thread_pool {
      */
     void run(const thread_task::ref& task);
 
+    /**
+     * Splits a range of indices into contiguous blocks, computes them on
+     * the workers of this pool, and waits for all of them to finish.
+     * Uses no more blocks than the size of the pool. Computes the whole
+     * range on the calling thread when it is itself a pool worker, so that
+     * nested calls never wait on the workers that they are blocking.
+     *
+     * @param size      Number of indices in the range.
+     * @param func      Computes the indices from first up to (but not
+     *                  including) last. Must not throw.
+     */
+    void run_blocks(size_t size,
+                    const std::function<void(size_t first, size_t last)>& func);
+
    private:
+    /// Number of workers that are free to run tasks.
+    const size_t _num_threads;
+
     /// List of threads that execute the tasks.
     std::vector<std::thread> _thread_list;
 
+    /// Mutex used to lock changes to the list of threads.
+    read_write_lock _thread_mutex;
+
+    /// Number of worker threads that have not exited.
+    size_t _num_workers = 0;
+
+    /// Number of workers blocked by paused tasks.
+    size_t _num_parked = 0;
+
+    /// Workers that have exited, and are waiting to be joined.
+    std::vector<std::thread::id> _retired;
+
     /// Queue of the tasks to execute.
     std::queue<thread_task::ref> _task_queue;
 
@@ -66,6 +105,37 @@ class USML_DECLSPEC thread_pool {
 
     /// Flag that controls execution of thread loop.
     std::atomic<bool> _running = true;
+
+    /**
+     * Executes tasks from the queue until the pool is stopped, or until
+     * this worker is no longer needed.
+     */
+    void work();
+
+    /**
+     * Starts a new worker thread. Joins workers that have exited.
+     * Assumes that the caller has locked the thread mutex.
+     */
+    void spawn();
+
+    /**
+     * Removes the calling worker from the pool if more workers are free
+     * to run tasks than the size of the pool.
+     *
+     * @return  True if the calling worker needs to exit.
+     */
+    bool retire();
+
+    /**
+     * Called by a task that is blocked by pause(). Starts a replacement
+     * worker if needed.
+     */
+    void park();
+
+    /**
+     * Called by a paused task when it continues.
+     */
+    void unpark();
 };
 
 /// @}
@@ -4,6 +4,7 @@
  */
 
 #include <bits/exception.h>
+#include <usml/threads/thread_pool.h>
 #include <usml/threads/thread_task.h>
 
 #include <iostream>
@@ -44,5 +45,22 @@ void thread_task::start() {
         cerr << "Uncaught exception in thread_task" << endl;
     }
     // After run is completed decrement number of active tasks counter.
+    _finished = true;
     --_num_active;
 }
+
+/**
+ * Blocks while this task is paused, and lets the thread_pool start another
+ * worker in its place.
+ */
+void thread_task::suspend() const {
+    if (_pool != nullptr) {
+        _pool->park();
+    }
+    while (_paused && !_abort) {
+        sleep();
+    }
+    if (_pool != nullptr) {
+        _pool->unpark();
+    }
+}
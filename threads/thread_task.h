@@ -98,7 +98,7 @@ class USML_DECLSPEC thread_task {
      * param millisec 	Number of milliseconds to wait, 0 waits forever.
      */
     static void wait(int64_t max_time = 0) {
-        int64_t count;
+        int64_t count = 0;
         while (thread_task::num_active() > 0) {
             if (max_time > 0 && count++ > max_time) {
                 throw std::range_error("maximum wait time exceeded");
@@ -114,17 +114,63 @@ class USML_DECLSPEC thread_task {
      */
     void abort() { _abort = true; }
 
+    /**
+     * True if abort() has been invoked for this task.
+     */
+    bool aborted() const { return _abort; }
+
     /**
      * Set to true when this task complete.
      */
     bool done() const { return _done; }
 
+    /**
+     * True once run() has returned, whether or not the task completed.
+     */
+    bool finished() const { return _finished; }
+
+    /**
+     * Suspend this task at its next checkpoint(). Allows the caller to
+     * temporarily release a core for more urgent work, without losing the
+     * progress of this task. Has no effect on tasks that do not call
+     * checkpoint().
+     */
+    void pause() { _paused = true; }
+
+    /**
+     * Allow a paused task to continue from its current checkpoint().
+     */
+    void resume() { _paused = false; }
+
+    /**
+     * True if pause() has been invoked without a matching resume().
+     */
+    bool paused() const { return _paused; }
+
+    /**
+     * Cooperative cancellation and preemption point for long calculations.
+     * Blocks while this task is paused, unless it is aborted.
+     * Sub-classes, and the models they invoke, call this in their inner
+     * loops to release cores as quickly as possible.
+     *
+     * @return  True if the task has been aborted and needs to terminate.
+     */
+    bool checkpoint() const {
+        if (_paused && !_abort) {
+            suspend();
+        }
+        return _abort;
+    }
+
    protected:
     /// Indication that task needs to abort.
-    bool _abort;
+    std::atomic<bool> _abort;
 
     /// Set to true when this task complete.
-    bool _done{false};
+    std::atomic<bool> _done{false};
+
+    /// Indication that task needs to wait at its next checkpoint.
+    std::atomic<bool> _paused{false};
 
    private:
     /**
@@ -134,6 +180,18 @@ class USML_DECLSPEC thread_task {
      */
     void start();
 
+    /**
+     * Blocks while this task is paused, unless it is aborted. Lets the
+     * thread_pool start another worker while this one is blocked.
+     */
+    void suspend() const;
+
+    /// Thread pool that is running this task, nullptr if none.
+    thread_pool* _pool = nullptr;
+
+    /// Set to true when run() returns.
+    std::atomic<bool> _finished{false};
+
     /// Next identification number to be assigned to a task.
     static std::atomic<std::size_t> _id_next;
 
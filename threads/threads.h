@@ -12,6 +12,7 @@
 #pragma once
 
 #include <usml/threads/read_write_lock.h>
+#include <usml/threads/task_scheduler.h>
 #include <usml/threads/thread_controller.h>
 #include <usml/threads/thread_pool.h>
 #include <usml/threads/thread_task.h>
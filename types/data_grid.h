@@ -6,6 +6,7 @@
 
 #include <ncvalues.h>
 #include <netcdfcpp.h>
+#include <usml/netcdf/netcdf_utils.h>
 #include <usml/types/seq_vector.h>
 #include <usml/types/wposition.h>
 #include <usml/usml_config.h>
@@ -14,6 +15,7 @@
 #include <boost/numeric/ublas/vector.hpp>
 #include <cstddef>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <typeinfo>
@@ -111,13 +113,13 @@ class USML_DLLEXPORT data_grid {
 
     /**
      * Extract a data value at a specific combination of indices.
+     * Unpacks the value for sub-classes that do not store their data
+     * as an array of DATA_TYPE.
      *
      * @param  index            Index number in each dimension.
      */
     DATA_TYPE data(const size_t* index) const {
-        const size_t offset =
-            data_grid_compute_offset<NUM_DIMS - 1>(_axis, index);
-        return _data.get()[offset];
+        return data_at(data_grid_compute_offset<NUM_DIMS - 1>(_axis, index));
     }
 
     /**
@@ -281,10 +283,25 @@ class USML_DLLEXPORT data_grid {
     }
 
     /**
-     * Output data_grid to netcdf file.
+     * Output data_grid to netcdf file. Packed data is unpacked into a
+     * temporary array before it is written.
      * @param filename      name of the netcdf file to output to
      */
     void write_netcdf(const char* filename) const {
+        const DATA_TYPE* values = _data.get();
+        std::unique_ptr<DATA_TYPE[]> unpacked;
+        if (values == nullptr) {
+            size_t N = 1;
+            for (size_t n = 0; n < NUM_DIMS; ++n) {
+                N *= _axis[n]->size();
+            }
+            unpacked.reset(new DATA_TYPE[N]);
+            for (size_t n = 0; n < N; ++n) {
+                unpacked[n] = data_at(n);
+            }
+            values = unpacked.get();
+        }
+        std::lock_guard<std::mutex> lock(netcdf::netcdf_utils::mutex());
         NcFile* file = new NcFile(filename, NcFile::Replace);
 
         vector<const NcDim*> axis_dim(NUM_DIMS);
@@ -322,7 +339,7 @@ class USML_DLLEXPORT data_grid {
                 boost::numeric::ublas::vector<double>(*_axis[i]).data().begin(),
                 data_size[i]);
         }
-        data_var->put(_data.get(), data_size);
+        data_var->put(values, data_size);
 
         // clean up after file completion
         delete file;
@@ -339,6 +356,17 @@ class USML_DLLEXPORT data_grid {
         }
     }
 
+    /**
+     * Extract the data value at a specific offset into the data array.
+     * Sub-classes that do not store their data as an array of DATA_TYPE
+     * override this to unpack their own storage.
+     *
+     * @param  offset           Offset of the value in the data array.
+     */
+    virtual DATA_TYPE data_at(size_t offset) const {
+        return _data.get()[offset];
+    }
+
     /// Axis associated with each dimension of the data grid.
     seq_vector::csptr _axis[NUM_DIMS];
 
@@ -54,6 +54,10 @@ class USML_DECLSPEC data_grid_bathy : public data_grid<2> {
             this->_edge_limit[n] = grid->edge_limit(n);
         }
         this->_data = grid->data_csptr();
+        if (!this->_data) {
+            throw std::invalid_argument(
+                "data_grid_bathy requires unpacked data");
+        }
 
         // Construct the inverse bicubic interpolation coefficient matrix
         _inv_bicubic_coeff = zero_matrix<double>(16, 16);
@@ -14,6 +14,7 @@
 #include <cstddef>
 #include <iterator>
 #include <memory>
+#include <stdexcept>
 
 namespace usml {
 namespace types {
@@ -51,6 +52,9 @@ class USML_DECLSPEC data_grid_svp : public gen_grid<3> {
             this->_edge_limit[n] = grid->edge_limit(n);
         }
         this->_data = grid->data_csptr();
+        if (!this->_data) {
+            throw std::invalid_argument("data_grid_svp requires unpacked data");
+        }
 
         this->_interp_type[0] = interp_enum::pchip;
         this->_interp_type[1] = interp_enum::linear;
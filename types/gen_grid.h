@@ -10,10 +10,14 @@
 #include <usml/ublas/randgen.h>
 #include <usml/usml_config.h>
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <cstddef>
+#include <limits>
 #include <memory>
 #include <stdexcept>
+#include <type_traits>
 
 namespace usml {
 namespace types {
@@ -25,29 +29,146 @@ namespace types {
  * Generic N-dimensional data set and its associated axes.
  * Editable class that supports interpolation in any number of dimensions.
  *
+ * The data can optionally be stored in a more compact type than the one used
+ * for interpolation, such as float or int16_t storage for a grid of doubles.
+ * Each stored value is unpacked as
+ * \f[
+ *      value = stored * scale + offset
+ * \f]
+ * when it is read, so all of the interpolation arithmetic is still done
+ * in DATA_TYPE. Subtracting an offset, like the mean earth radius from a
+ * grid of boundary heights, preserves most of the precision of float
+ * storage. NaN values are stored as the smallest value of signed integer
+ * storage types. Packed grids do not have a DATA_TYPE array, so the data() and
+ * data_csptr() methods of the data_grid base class return nullptr for
+ * these grids. The data(index) and write_netcdf() methods of the base class
+ * unpack each value as it is read.
+ *
  * @param  NUM_DIMS     Number of dimensions in this grid.  Specifying this
  *                      at compile time allows for some loop un-wrapping.
+ * @param  DATA_TYPE    Type used for interpolation.
+ * @param  STORAGE_TYPE Type used to store the data at each grid point.
+ *                      Defaults to DATA_TYPE.
  */
-template <size_t NUM_DIMS, class DATA_TYPE = double>
+template <size_t NUM_DIMS, class DATA_TYPE = double,
+          class STORAGE_TYPE = DATA_TYPE>
 class USML_DLLEXPORT gen_grid : public data_grid<NUM_DIMS, DATA_TYPE> {
    public:
+    /// True if data is stored in a different type than DATA_TYPE.
+    static constexpr bool is_packed = !std::is_same_v<DATA_TYPE, STORAGE_TYPE>;
+
     /**
      * Create data grid from its associated axes.
      * Allocates new memory for the data at each grid point.
      * Initialize all of the interpolation types to interp_enum::linear.
      *
-     * @param axis  Axes to use for each dimension of the grid.
+     * @param axis      Axes to use for each dimension of the grid.
+     * @param scale     Scale factor used to unpack stored values.
+     *                  Ignored unless STORAGE_TYPE differs from DATA_TYPE.
+     * @param offset    Offset used to unpack stored values.
+     *                  Ignored unless STORAGE_TYPE differs from DATA_TYPE.
      */
-    gen_grid(const seq_vector::csptr axis[]) {
+    gen_grid(const seq_vector::csptr axis[], double scale = 1.0,
+             double offset = 0.0)
+        : _scale(scale), _offset(offset) {
         size_t N = 1;
         for (size_t n = 0; n < NUM_DIMS; ++n) {
             this->_axis[n] = axis[n];
             N *= this->_axis[n]->size();
         }
-        _writeable_data = std::shared_ptr<DATA_TYPE[]>(new DATA_TYPE[N]);
-        this->_data = _writeable_data;  // read only reference
-        initialize<DATA_TYPE>::zero_n(_writeable_data.get(), N);
-        _zero = initialize<DATA_TYPE>::zero((_writeable_data.get())[0]);
+        if constexpr (is_packed) {
+            _packed_data = std::shared_ptr<STORAGE_TYPE[]>(new STORAGE_TYPE[N]);
+            std::fill_n(_packed_data.get(), N, pack(DATA_TYPE(0)));
+            _zero = DATA_TYPE(0);
+        } else {
+            _writeable_data = std::shared_ptr<DATA_TYPE[]>(new DATA_TYPE[N]);
+            this->_data = _writeable_data;  // read only reference
+            initialize<DATA_TYPE>::zero_n(_writeable_data.get(), N);
+            _zero = initialize<DATA_TYPE>::zero((_writeable_data.get())[0]);
+        }
+    }
+
+    /**
+     * Create a packed copy of another grid. Copies the axes, interpolation
+     * types, and edge limits of the original grid. For floating point
+     * storage, the offset is set to the middle of the range of the data,
+     * and the scale is set to one. For integer storage, the scale is also
+     * set so that the range of the data fills the range of the integer.
+     * Grids that are themselves packed are unpacked on the fly.
+     *
+     * @param grid      Grid to be copied.
+     * @return          Packed copy of the grid.
+     */
+    static std::shared_ptr<const gen_grid> pack_grid(
+        const data_grid<NUM_DIMS, DATA_TYPE>& grid) {
+        static_assert(is_packed, "pack_grid() requires packed storage");
+        size_t N = 1;
+        for (size_t n = 0; n < NUM_DIMS; ++n) {
+            N *= grid.axis(n).size();
+        }
+        const DATA_TYPE* data = grid.data();
+        std::unique_ptr<DATA_TYPE[]> unpacked;
+        if (data == nullptr) {  // source is itself packed, walk its indices
+            unpacked.reset(new DATA_TYPE[N]);
+            size_t index[NUM_DIMS] = {};
+            for (size_t n = 0; n < N; ++n) {
+                unpacked[n] = grid.data(index);
+                for (size_t d = NUM_DIMS; d-- > 0;) {
+                    if (++index[d] < grid.axis(d).size()) break;
+                    index[d] = 0;
+                }
+            }
+            data = unpacked.get();
+        }
+        double minimum = INFINITY;
+        double maximum = -INFINITY;
+        for (size_t n = 0; n < N; ++n) {
+            if (std::isfinite(data[n])) {
+                minimum = std::min(minimum, double(data[n]));
+                maximum = std::max(maximum, double(data[n]));
+            }
+        }
+        if (minimum > maximum) {
+            minimum = maximum = 0.0;
+        }
+        double scale = 1.0;
+        double offset = 0.5 * (minimum + maximum);
+        if constexpr (std::is_integral_v<STORAGE_TYPE>) {
+            static_assert(std::is_signed_v<STORAGE_TYPE>,
+                          "integer storage must be signed");
+            const double levels =
+                double(std::numeric_limits<STORAGE_TYPE>::max());
+            if (maximum > minimum) {
+                scale = (maximum - minimum) / (2.0 * levels);
+            }
+        }
+        auto result =
+            std::make_shared<gen_grid>(grid.axis_list(), scale, offset);
+        for (size_t n = 0; n < NUM_DIMS; ++n) {
+            result->interp_type(n, grid.interp_type(n));
+            result->edge_limit(n, grid.edge_limit(n));
+        }
+        for (size_t n = 0; n < N; ++n) {
+            result->_packed_data.get()[n] = result->pack(data[n]);
+        }
+        return result;
+    }
+
+    /// Scale factor used to unpack stored values.
+    double scale() const { return _scale; }
+
+    /// Offset used to unpack stored values.
+    double offset() const { return _offset; }
+
+    /**
+     * Extract a data value at a specific combination of indices.
+     * Unpacks the value if it is stored in a different type.
+     *
+     * @param  index            Index number in each dimension.
+     */
+    DATA_TYPE value(const size_t* index) const {
+        return unpack(
+            data_grid_compute_offset<NUM_DIMS - 1>(this->_axis, index));
     }
 
     /**
@@ -55,11 +176,20 @@ class USML_DLLEXPORT gen_grid : public data_grid<NUM_DIMS, DATA_TYPE> {
      *
      * @param  index            Index number in each dimension.
      * @param  value            Value to insert at this location.
+     * @throws std::logic_error if the sub-class has read-only data,
+     *                          like a memory mapped file.
      */
     void setdata(const size_t* index, DATA_TYPE value) {
         const size_t offset =
             data_grid_compute_offset<NUM_DIMS - 1>(this->_axis, index);
-        _writeable_data.get()[offset] = value;
+        if constexpr (is_packed) {
+            _packed_data.get()[offset] = pack(value);
+        } else {
+            if (!_writeable_data) {
+                throw std::logic_error("data grid is read-only");
+            }
+            _writeable_data.get()[offset] = value;
+        }
     }
 
     /**
@@ -124,15 +254,74 @@ class USML_DLLEXPORT gen_grid : public data_grid<NUM_DIMS, DATA_TYPE> {
 
         // compute interpolation results for value and derivative
 
-        if (!_zero_init) {
-            _zero_init = true;
-            _zero = initialize<DATA_TYPE>::zero((_writeable_data.get())[0]);
+        if constexpr (!is_packed) {
+            if (!_zero_init) {
+                _zero_init = true;
+                _zero =
+                    initialize<DATA_TYPE>::zero((_writeable_data.get())[0]);
+            }
         }
         DATA_TYPE dresult = _zero;
         return interp(NUM_DIMS - 1, index, loc, dresult, derivative);
     }
 
+   protected:
+    /**
+     * Extract the data value at a specific offset into the data array.
+     * Unpacks the value if it is stored in a different type.
+     *
+     * @param  offset           Offset of the value in the data array.
+     */
+    DATA_TYPE data_at(size_t offset) const override { return unpack(offset); }
+
    private:
+    //*************************************************************************
+    // storage methods
+
+    /**
+     * Convert a value into the type used for storage.
+     *
+     * @param   value       Value to be stored.
+     * @return              Packed version of the value.
+     */
+    STORAGE_TYPE pack(DATA_TYPE value) const {
+        if constexpr (!is_packed) {
+            return value;
+        } else if constexpr (std::is_integral_v<STORAGE_TYPE>) {
+            if (std::isnan(value)) {
+                return std::numeric_limits<STORAGE_TYPE>::min();
+            }
+            const double stored = std::round((value - _offset) / _scale);
+            return STORAGE_TYPE(
+                std::clamp(stored,
+                           double(std::numeric_limits<STORAGE_TYPE>::min()) +
+                               1.0,
+                           double(std::numeric_limits<STORAGE_TYPE>::max())));
+        } else {
+            return STORAGE_TYPE((value - _offset) / _scale);
+        }
+    }
+
+    /**
+     * Read the value stored at a specific offset into the data.
+     *
+     * @param   offset      Offset of the value in the data array.
+     * @return              Unpacked version of the value.
+     */
+    DATA_TYPE unpack(size_t offset) const {
+        if constexpr (!is_packed) {
+            return this->_data.get()[offset];
+        } else {
+            const STORAGE_TYPE stored = _packed_data.get()[offset];
+            if constexpr (std::is_integral_v<STORAGE_TYPE>) {
+                if (stored == std::numeric_limits<STORAGE_TYPE>::min()) {
+                    return DATA_TYPE(NAN);
+                }
+            }
+            return DATA_TYPE(double(stored) * _scale + _offset);
+        }
+    }
+
     //*************************************************************************
     // interpolation methods
 
@@ -162,7 +351,7 @@ class USML_DLLEXPORT gen_grid : public data_grid<NUM_DIMS, DATA_TYPE> {
         if (dim < 0) {
             const size_t offset =
                 data_grid_compute_offset<NUM_DIMS - 1>(this->_axis, index);
-            result = this->_data.get()[offset];
+            result = unpack(offset);
             // terminates recursion
 
         } else if (this->_axis[dim]->size() < 2) {
@@ -522,13 +711,24 @@ class USML_DLLEXPORT gen_grid : public data_grid<NUM_DIMS, DATA_TYPE> {
    protected:
     /// Limit construction to sub-classes.
     // NOLINTNEXTLINE(clang-analyzer-optin.cplusplus.UninitializedObject)
-    gen_grid<NUM_DIMS, DATA_TYPE>() {}
+    gen_grid() {}
 
     /**
      * Local copy of data storage to support data editing.
      */
     std::shared_ptr<DATA_TYPE[]> _writeable_data;
 
+    /**
+     * Data storage for grids whose STORAGE_TYPE differs from DATA_TYPE.
+     */
+    std::shared_ptr<STORAGE_TYPE[]> _packed_data;
+
+    /// Scale factor used to unpack stored values.
+    double _scale{1.0};
+
+    /// Offset used to unpack stored values.
+    double _offset{0.0};
+
     /**
      * Example of empty data type with vector/matrix correct size. If results
      * variables are left uninitialized, Valgrind's Memcheck flags them out as
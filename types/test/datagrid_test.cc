@@ -16,7 +16,9 @@
 #include <boost/numeric/ublas/vector.hpp>
 #include <boost/test/unit_test.hpp>
 #include <boost/timer/timer.hpp>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <cstdio>
 #include <iostream>
 #include <memory>
@@ -672,6 +674,125 @@ BOOST_AUTO_TEST_CASE(fast_accuracy_test) {
     BOOST_CHECK_CLOSE(grid_value, true_value, 3);
 }
 
+/**
+ * Pack a 2-D cubic field, offset by the earth's radius, into float and
+ * int16_t storage and compare the interpolated values and derivatives to
+ * the original double grid. The offset tests the ability of packed grids to
+ * preserve precision for large values, like the rho coordinate of a
+ * bathymetry grid. Also checks that NaN values survive the packing.
+ *
+ * An error is produced if the float values differ from the double values
+ * by more than 1 mm, or the int16_t values differ by more than 1E-4 of
+ * the range of the data.
+ */
+BOOST_AUTO_TEST_CASE(packed_grid_test) {
+    cout << "=== datagrid_test: packed_grid_test ===" << endl;
+
+    const int N = 10;
+    const double span = 0.5;
+    const double earth_radius = 6378101.030201019;
+    const double range = 1000.0;
+
+    seq_vector::csptr ax[2];
+    ax[0] = seq_vector::csptr(new seq_linear(-span, 0.1, N));
+    ax[1] = seq_vector::csptr(new seq_linear(-span, 0.1, N));
+    gen_grid<2> grid(ax);
+    grid.interp_type(0, interp_enum::pchip);
+    grid.interp_type(1, interp_enum::linear);
+    size_t index[2];
+    for (index[0] = 0; index[0] < ax[0]->size(); ++index[0]) {
+        for (index[1] = 0; index[1] < ax[1]->size(); ++index[1]) {
+            const double x = (*ax[0])[index[0]];
+            const double y = (*ax[1])[index[1]];
+            grid.setdata(index, earth_radius + range * cubic2d(x, y));
+        }
+    }
+
+    auto float_grid = gen_grid<2, double, float>::pack_grid(grid);
+    auto short_grid = gen_grid<2, double, int16_t>::pack_grid(grid);
+    BOOST_CHECK(float_grid->data() == nullptr);
+    BOOST_CHECK(float_grid->interp_type(0) == interp_enum::pchip);
+    index[0] = index[1] = 1;
+    BOOST_CHECK_SMALL(float_grid->value(index) - grid.data(index), 1e-3);
+
+    const double tolerance = 1e-4 * range;
+    randgen random(0);
+    for (int n = 0; n < 100; ++n) {
+        double spot[2] = {0.8 * span * (2.0 * random.uniform() - 1.0),
+                          0.8 * span * (2.0 * random.uniform() - 1.0)};
+        double derv[2];
+        double float_derv[2];
+        double short_derv[2];
+        const double value = grid.interpolate(spot, derv);
+        const double float_value = float_grid->interpolate(spot, float_derv);
+        const double short_value = short_grid->interpolate(spot, short_derv);
+        BOOST_CHECK_SMALL(float_value - value, 1e-3);
+        BOOST_CHECK_SMALL(short_value - value, tolerance);
+        for (int d = 0; d < 2; ++d) {
+            BOOST_CHECK_SMALL(float_derv[d] - derv[d], 1e-1);
+            BOOST_CHECK_SMALL(short_derv[d] - derv[d], 10.0 * tolerance);
+        }
+    }
+
+    // check that NaN values are preserved
+
+    index[0] = index[1] = 0;
+    grid.setdata(index, NAN);
+    float_grid = gen_grid<2, double, float>::pack_grid(grid);
+    short_grid = gen_grid<2, double, int16_t>::pack_grid(grid);
+    BOOST_CHECK(std::isnan(float_grid->value(index)));
+    BOOST_CHECK(std::isnan(short_grid->value(index)));
+}
+
+/**
+ * Read and write a packed grid through the data_grid interface. Packed
+ * grids do not have a double array, so data(index) and write_netcdf() must
+ * unpack each value. Checks that data(index) matches value(index), and that
+ * the data written to disk can be read back in row major order.
+ */
+BOOST_AUTO_TEST_CASE(packed_grid_access) {
+    cout << "=== datagrid_test: packed_grid_access ===" << endl;
+    const char* filename = USML_TEST_DIR "/types/test/packed_grid.nc";
+
+    seq_vector::csptr ax[2];
+    ax[0] = seq_vector::csptr(new seq_linear(0.0, 1.0, 3));
+    ax[1] = seq_vector::csptr(new seq_linear(0.0, 1.0, 4));
+    gen_grid<2> grid(ax);
+    size_t index[2];
+    for (index[0] = 0; index[0] < 3; ++index[0]) {
+        for (index[1] = 0; index[1] < 4; ++index[1]) {
+            grid.setdata(index, 1000.0 + 10.0 * index[0] + index[1]);
+        }
+    }
+    auto packed = gen_grid<2, double, float>::pack_grid(grid);
+    const data_grid<2>& base = *packed;
+    BOOST_REQUIRE(base.data() == nullptr);
+    for (index[0] = 0; index[0] < 3; ++index[0]) {
+        for (index[1] = 0; index[1] < 4; ++index[1]) {
+            BOOST_CHECK_EQUAL(base.data(index), packed->value(index));
+            BOOST_CHECK_CLOSE(base.data(index), grid.data(index), 1e-6);
+        }
+    }
+
+    // re-packing an already packed grid must not touch its null data()
+    auto repacked = gen_grid<2, double, short>::pack_grid(base);
+    for (index[0] = 0; index[0] < 3; ++index[0]) {
+        for (index[1] = 0; index[1] < 4; ++index[1]) {
+            BOOST_CHECK_CLOSE(repacked->value(index), grid.data(index), 1e-3);
+        }
+    }
+
+    base.write_netcdf(filename);
+    NcFile file(filename);
+    BOOST_REQUIRE(file.is_valid());
+    double values[12];
+    BOOST_REQUIRE(file.get_var("data")->get(values, 3, 4));
+    for (size_t n = 0; n < 12; ++n) {
+        BOOST_CHECK_CLOSE(values[n], 1000.0 + 10.0 * (n / 4) + (n % 4),
+                          1e-6);
+    }
+}
+
 /// @}
 
 BOOST_AUTO_TEST_SUITE_END()
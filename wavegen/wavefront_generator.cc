@@ -7,6 +7,7 @@
 #include <usml/eigenverbs/eigenverb_collection.h>
 #include <usml/managed/managed_obj.h>
 #include <usml/ocean/ocean_shared.h>
+#include <usml/ocean/ocean_utils.h>
 #include <usml/platforms/platform_model.h>
 #include <usml/sensors/sensor_model.h>
 #include <usml/wavegen/wavefront_generator.h>
@@ -29,7 +30,7 @@ wavefront_generator::wavefront_generator(
     const matrix<uint64_t>& targetIDs, const seq_vector::csptr& frequencies,
     const seq_vector::csptr& de_fan, const seq_vector::csptr& az_fan,
     double time_step, double time_maximum, double intensity_threshold,
-    int max_bottom, int max_surface)
+    int max_bottom, int max_surface, double de_refine, double eigenverb_merge)
     : _ocean(ocean_shared::current()),
       _source(source),
       _source_position(source->position()),
@@ -42,7 +43,9 @@ wavefront_generator::wavefront_generator(
       _time_maximum(time_maximum),
       _intensity_threshold(intensity_threshold),
       _max_bottom(max_bottom),
-      _max_surface(max_surface) {}
+      _max_surface(max_surface),
+      _de_refine(de_refine),
+      _eigenverb_merge(eigenverb_merge) {}
 
 /**
  * Executes the WaveQ3D propagation model.
@@ -61,33 +64,46 @@ void wavefront_generator::run() {
     cout << "task #" << id()
          << " wavefront_generator: " << _source->description() << " for "
          << _time_maximum << " secs" << endl;
+    if (_de_refine > 0.0 && !refine_de_fan()) {
+        cout << "task #" << id()
+             << " wavefront_generator *** aborted during refinement ***"
+             << endl;
+        return;
+    }
+
+    // load the environment that this wavefront can reach, if it is tiled
+
+    ocean_utils::stream_region(_ocean, _source_position,
+                               _time_maximum * ocean_utils::max_speed);
     wave_queue wave(_ocean, _frequencies, _source_position, _de_fan, _az_fan,
                     _time_step, &_target_positions);
+    wave.cancellation(this);
     wave.intensity_threshold(_intensity_threshold);
     wave.max_bottom(_max_bottom);
     wave.max_surface(_max_surface);
 
     // create listener to store eigenrays, if targets exist
 
-    auto* eigenrays = new eigenray_collection(_frequencies, _source_position,
-                                              _target_positions,
-                                              _source->keyID(), _targetIDs);
+    std::unique_ptr<eigenray_collection> eigenrays(new eigenray_collection(
+        _frequencies, _source_position, _target_positions, _source->keyID(),
+        _targetIDs));
     if (_targetIDs.size1() > 0 && _targetIDs.size2() > 0) {
-        wave.add_eigenray_listener(eigenrays);
+        wave.add_eigenray_listener(eigenrays.get());
     }
 
     // create listener to store eigenverbs
 
-    auto* eigenverbs = new eigenverb_collection(_ocean->num_volume());
+    std::unique_ptr<eigenverb_collection> eigenverbs(
+        new eigenverb_collection(_ocean->num_volume()));
     if (_source->compute_reverb()) {
-        wave.add_eigenverb_listener(eigenverbs);
+        wave.add_eigenverb_listener(eigenverbs.get());
     }
 
     // propagate wavefront to build eigenrays and eigenverbs
 
     while (wave.time() < _time_maximum) {
         wave.step();
-        if (_abort) {
+        if (checkpoint()) {
             cout << "task #" << id()
                  << " wavefront_generator *** aborted during execution ***"
                  << endl;
@@ -97,12 +113,37 @@ void wavefront_generator::run() {
     if (eigenrays != nullptr) {
         eigenrays->sum_eigenrays();
     }
+    if (_eigenverb_merge > 0.0) {
+        eigenverbs->merge(_eigenverb_merge);
+    }
+    eigenverbs->index();
 
     // distribute eigenrays and eigenverbs to listeners
 
     _done = true;
     _source->notify_wavefront_listeners(
-        _source, eigenray_collection::csptr(eigenrays),
-        eigenverb_collection::csptr(eigenverbs));
+        _source, eigenray_collection::csptr(eigenrays.release()),
+        eigenverb_collection::csptr(eigenverbs.release()));
     cout << "task #" << id() << " wavefront_generator: done" << endl;
 }
+
+/**
+ * Survey the environment to refine the D/E fan.
+ */
+bool wavefront_generator::refine_de_fan() {
+    wave_queue survey(_ocean, _frequencies, _source_position, _de_fan,
+                      _az_fan, _time_step);
+    survey.cancellation(this);
+    survey.track_divergence(true);
+    while (survey.time() < _time_maximum) {
+        survey.step();
+        if (checkpoint()) {
+            return false;
+        }
+    }
+    _de_fan = survey.refine_de(_de_refine);
+    cout << "task #" << id() << " wavefront_generator: refined "
+         << survey.num_de() << " to " << _de_fan->size() << " D/E rays"
+         << endl;
+    return true;
+}
@@ -54,6 +54,10 @@ class USML_DECLSPEC wavefront_generator : public thread_task {
      * @param intensity_threshold Intensity threshold in wavefront (dB).
      * @param max_bottom    	The maximum number of bottom bounces.
      * @param max_surface   	The maximum number of surface bounces.
+     * @param de_refine     	Divergence tolerance for adaptive refinement
+     *                          of the D/E fan. Disabled if zero.
+     * @param eigenverb_merge   Power tolerance for merging overlapping
+     *                          eigenverbs (dB). Disabled if zero.
      */
     wavefront_generator(sensor_model* source, const wposition& target_positions,
                         const matrix<uint64_t>& targetIDs,
@@ -61,7 +65,8 @@ class USML_DECLSPEC wavefront_generator : public thread_task {
                         const seq_vector::csptr& de_fan,
                         const seq_vector::csptr& az_fan, double time_step,
                         double time_maximum, double intensity_threshold,
-                        int max_bottom, int max_surface);
+                        int max_bottom, int max_surface,
+                        double de_refine = 0.0, double eigenverb_merge = 0.0);
 
     /**
      * Executes the WaveQ3D propagation model to generate eigenrays and
@@ -71,6 +76,15 @@ class USML_DECLSPEC wavefront_generator : public thread_task {
     virtual void run();
 
    private:
+    /**
+     * Survey the environment with the initial D/E fan to find regions where
+     * neighboring rays diverge, and replace _de_fan with a refined fan.
+     * The survey does not compute eigenrays or eigenverbs.
+     *
+     * @return      False if the task was aborted during the survey.
+     */
+    bool refine_de_fan();
+
     /// Reference to the shared ocean at the time of invocation.
     /// Cached to avoid change while the calculation is being performed.
     ocean_model::csptr _ocean;
@@ -129,6 +143,23 @@ class USML_DECLSPEC wavefront_generator : public thread_task {
      * Defaults to 999.
      */
     const int _max_surface;
+
+    /**
+     * Divergence tolerance for adaptive refinement of the D/E fan.
+     * If non-zero, the initial D/E fan is used to survey the environment,
+     * and rays are added to the intervals whose divergence ratio exceeds
+     * this value before eigenrays and eigenverbs are computed.
+     * See wave_queue::refine_de() for details.
+     */
+    const double _de_refine;
+
+    /**
+     * Power tolerance for merging overlapping eigenverbs (dB).
+     * If non-zero, co-located eigenverbs are merged into larger Gaussians
+     * after propagation is complete.
+     * See eigenverb_collection::merge() for details.
+     */
+    const double _eigenverb_merge;
 };
 
 /// @}
@@ -639,7 +639,7 @@ BOOST_AUTO_TEST_CASE(bounce_threshold_test) {
 
     // check that no bottom eigenverbs have too many bounces
 
-    const eigenverb_list bottom_list =
+    const eigenverb_span bottom_list =
         eigenverbs.eigenverbs(eigenverb_model::BOTTOM);
     cout << "checking " << bottom_list.size() << " bottom eigenverbs" << endl;
     for (const eigenverb_model::csptr& verb : bottom_list) {
@@ -648,7 +648,7 @@ BOOST_AUTO_TEST_CASE(bounce_threshold_test) {
     }
     // check that no surface eigenverbs have too many bounces
 
-    const eigenverb_list surface_list =
+    const eigenverb_span surface_list =
         eigenverbs.eigenverbs(eigenverb_model::SURFACE);
     cout << "checking " << surface_list.size() << " surface eigenverbs" << endl;
     for (const eigenverb_model::csptr& verb : surface_list) {
@@ -1178,6 +1178,60 @@ BOOST_AUTO_TEST_CASE(surface_duct_test) {
     wave.close_netcdf();
 }
 
+/**
+ * Tests the adaptive refinement of the D/E ray fan in an isovelocity ocean.
+ * In the absence of refraction and reflection, the separation between
+ * neighboring rays is governed by spherical spreading, and the divergence
+ * ratio for every D/E interval should be very close to one.
+ *
+ * - Scenario parameters
+ *   - Profile: constant 1500 m/s sound speed
+ *   - Bottom: 10000 meters
+ *   - Source: 45N, 45W, -3000 meters
+ *   - Launch D/E: 10 degree linear spacing from -40 to 40 degrees
+ *   - Time: 1 second, before any rays reach the surface or bottom
+ *
+ * Generates errors if any divergence ratio differs from one by more than
+ * 0.01. Refining with a tolerance larger than one must return the original
+ * fan.  Refining with a tolerance of 0.5 must split each interval in two,
+ * while preserving the original launch angles.
+ */
+BOOST_AUTO_TEST_CASE(refraction_de_refine) {
+    cout << "=== refraction_test: refraction_de_refine ===" << endl;
+
+    const double c0 = 1500.0;
+    profile_model::csptr profile(new profile_linear(c0));
+    boundary_model::csptr surface(new boundary_flat());
+    boundary_model::csptr bottom(new boundary_flat(1e4));
+    ocean_model::csptr ocean(new ocean_model(surface, bottom, profile));
+
+    wposition1 pos(45.0, -45.0, -3000.0);
+    seq_vector::csptr de(new seq_linear(-40.0, 10.0, 40.0));
+    seq_vector::csptr az(new seq_linear(-4.0, 2.0, 4.0));
+    seq_vector::csptr freq(new seq_log(10e3, 1.0, 1));
+
+    wave_queue wave(ocean, freq, pos, de, az, time_step);
+    wave.track_divergence(true);
+    while (wave.time() < 1.0) {
+        wave.step();
+    }
+
+    const vector<double>& ratio = wave.de_divergence();
+    BOOST_CHECK_EQUAL(ratio.size(), de->size() - 1);
+    for (size_t n = 0; n < ratio.size(); ++n) {
+        cout << "de=" << (*de)(n) << " ratio=" << ratio(n) << endl;
+        BOOST_CHECK_SMALL(ratio(n) - 1.0, 0.01);
+    }
+
+    BOOST_CHECK(wave.refine_de(2.0) == de);
+    seq_vector::csptr refined = wave.refine_de(0.5);
+    BOOST_CHECK_EQUAL(refined->size(), 2 * de->size() - 1);
+    for (size_t n = 0; n < de->size(); ++n) {
+        BOOST_CHECK_CLOSE((*refined)(2 * n), (*de)(n), 1e-10);
+    }
+    BOOST_CHECK_CLOSE((*refined)(1), -35.0, 1e-10);
+}
+
 /// @}
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -3,6 +3,7 @@
  * Wavefront propagation as a function of time.
  */
 #include <usml/eigenverbs/eigenverb_model.h>
+#include <usml/types/seq_data.h>
 #include <usml/waveq3d/ode_integ.h>
 #include <usml/waveq3d/reflection_model.h>
 #include <usml/waveq3d/spreading_hybrid_gaussian.h>
@@ -15,6 +16,7 @@
 #include <cmath>
 #include <iomanip>
 #include <utility>
+#include <vector>
 
 // #define DEBUG_EIGENRAYS_DETAIL
 // #define DEBUG_EIGENRAYS
@@ -156,6 +158,9 @@ void wave_queue::step() {
     // search for caustics and boundary reflections
 
     detect_reflections();
+    if (preempted()) {
+        return;
+    }
 
     // rotate wavefront queue to the next step.
 
@@ -181,16 +186,92 @@ void wave_queue::step() {
     _next->upper = _curr->upper;
     _next->lower = _curr->lower;
     _next->caustic = _curr->caustic;
+    if (preempted()) {
+        return;
+    }
 
     // search for eigenray collisions with acoustic targets
 
     detect_eigenrays();
+    if (preempted()) {
+        return;
+    }
+
+    // measure spreading between neighboring D/E rays
+
+    if (!_de_divergence.empty()) {
+        update_divergence();
+    }
 
     // notify listeners that this step is complete
 
     check_eigenray_listeners(_time, runID());
 }
 
+/**
+ * Enables the tracking of divergence between neighboring D/E rays.
+ */
+void wave_queue::track_divergence(bool flag) {
+    if (flag && num_de() > 1) {
+        _de_divergence = scalar_vector<double>(num_de() - 1, 0.0);
+    } else {
+        _de_divergence.clear();
+    }
+}
+
+/**
+ * Update the divergence ratio between neighboring D/E rays.
+ */
+void wave_queue::update_divergence() {
+    const double min_path = 1.0;  // ignore points too close to source
+    for (size_t de = 0; de < _max_de; ++de) {
+        const double spacing = to_radians(abs(_source_de->increment(de)));
+        if (spacing <= 0.0) {
+            continue;
+        }
+        for (size_t az = 0; az < num_az(); ++az) {
+            const double path = 0.5 * (_next->path_length(de, az) +
+                                       _next->path_length(de + 1, az));
+            if (path < min_path) {
+                continue;
+            }
+            wposition1 p1(_next->position, de, az);
+            wposition1 p2(_next->position, de + 1, az);
+            const double ratio = p1.distance(p2) / (path * spacing);
+            _de_divergence(de) = max(_de_divergence(de), ratio);
+        }
+    }
+}
+
+/**
+ * Builds a new D/E launch fan that adds rays to divergent intervals.
+ */
+seq_vector::csptr wave_queue::refine_de(double tolerance,
+                                        size_t max_split) const {
+    if (_de_divergence.empty() || tolerance <= 0.0) {
+        return _source_de;
+    }
+    std::vector<double> angles;
+    angles.reserve(num_de());
+    for (size_t de = 0; de < _max_de; ++de) {
+        const double first = (*_source_de)(de);
+        angles.push_back(first);
+        const double ratio = _de_divergence(de) / tolerance;
+        if (ratio > 1.0) {
+            const auto split = std::min(max_split, size_t(ceil(ratio)));
+            const double inc = _source_de->increment(de) / double(split);
+            for (size_t n = 1; n < split; ++n) {
+                angles.push_back(first + double(n) * inc);
+            }
+        }
+    }
+    angles.push_back((*_source_de)(_max_de));
+    if (angles.size() == num_de()) {
+        return _source_de;
+    }
+    return seq_vector::csptr(new seq_data(angles));
+}
+
 /**
  * Detect and process boundary reflections and caustics.
  */
@@ -199,6 +280,9 @@ void wave_queue::detect_reflections() {
     // note that multiple rays can reflect in the same time step
 
     for (size_t de = 0; de < num_de(); ++de) {
+        if (preempted()) {
+            return;
+        }
         for (size_t az = 0; az < num_az(); ++az) {
             detect_volume_scattering(de, az);
             if (!detect_reflections_surface(de, az)) {
@@ -360,6 +444,9 @@ void wave_queue::detect_eigenrays() {
     // loop over all targets
     for (size_t t1 = 0; t1 < _target_pos->size1(); ++t1) {
         for (size_t t2 = 0; t2 < _target_pos->size2(); ++t2) {
+            if (preempted()) {
+                return;
+            }
             _de_branch = false;
             if (abs(_source_pos.latitude() - _target_pos->latitude(t1, t2)) <
                     1e-4 &&
@@ -8,6 +8,7 @@
 #include <usml/eigenrays/eigenray_notifier.h>
 #include <usml/eigenverbs/eigenverb_notifier.h>
 #include <usml/ocean/ocean_model.h>
+#include <usml/threads/thread_task.h>
 #include <usml/types/seq_vector.h>
 #include <usml/types/wposition.h>
 #include <usml/types/wposition1.h>
@@ -27,6 +28,7 @@ namespace waveq3d {
 using namespace usml::ocean;
 using namespace usml::eigenverbs;
 using namespace usml::eigenrays;
+using namespace usml::threads;
 
 class reflection_model;
 class spreading_model;
@@ -236,6 +238,24 @@ class USML_DECLSPEC wave_queue : public eigenray_notifier,
      */
     inline const size_t runID() const { return _run_id; }
 
+    /**
+     * Background task used to cancel or pause this calculation. When set,
+     * step() calls thread_task::checkpoint() between each phase of the
+     * calculation, and between rows of the wavefront in its longest loops.
+     * This allows an aborted task to release its core without waiting for
+     * the end of the step. Set to nullptr to disable these checks.
+     *
+     * @param task  Task that owns this wavefront calculation.
+     */
+    inline void cancellation(const thread_task* task) { _cancellation = task; }
+
+    /**
+     * True if the last step() was interrupted because the cancellation task
+     * was aborted. The wavefront is left in an incomplete state, and must
+     * be discarded once this is true.
+     */
+    inline bool aborted() const { return _aborted; }
+
     /**
      * Marches to the next integration step in the acoustic propagation.
      * Uses the third order Adams-Bashforth algorithm to estimate the position
@@ -256,9 +276,53 @@ class USML_DECLSPEC wave_queue : public eigenray_notifier,
      * portray targets near the interface.  Reflections are computed at the
      * beginning of the next iteration to ensure that the next wave elements
      * are alway inside of the water column.
+     *
+     * Returns early, without notifying listeners, if the cancellation task
+     * is aborted during the step.
      */
     void step();
 
+    //**************************************************
+    // adaptive ray fan refinement
+
+    /**
+     * Enables the tracking of divergence between neighboring D/E rays.
+     * When enabled, each step() compares the separation of adjacent
+     * D/E rays to the separation that spherical spreading would produce
+     * for the same launch increment.  Turned off by default, because it
+     * adds a distance computation for each point on the wavefront.
+     *
+     * @param flag          Enables divergence tracking when true.
+     */
+    void track_divergence(bool flag);
+
+    /**
+     * Largest divergence ratio observed between each pair of neighboring
+     * D/E rays, over all azimuths and all time steps so far.  Element "n"
+     * describes the interval between D/E rays "n" and "n+1".  A value near
+     * one indicates spherical spreading.  Values much larger than one
+     * are found near shadow zone edges, caustics, and where rays in the
+     * same interval reflect from different interfaces.  Empty if
+     * divergence tracking has not been enabled.
+     */
+    inline const vector<double>& de_divergence() const {
+        return _de_divergence;
+    }
+
+    /**
+     * Builds a new D/E launch fan that adds rays to the intervals whose
+     * divergence exceeds a tolerance.  Intervals with a divergence ratio of
+     * "r" are split into ceil(r/tolerance) equal sub-intervals, up to a
+     * limit of max_split.  All of the original launch angles are preserved.
+     * Intended to be used as the D/E fan for a second propagation, after this
+     * wave_queue has been used to survey the environment.
+     *
+     * @param tolerance     Largest divergence ratio allowed without refinement.
+     * @param max_split     Maximum number of sub-intervals per interval.
+     * @return              Refined D/E launch angles (degrees).
+     */
+    seq_vector::csptr refine_de(double tolerance, size_t max_split = 8) const;
+
    protected:
     /**
      * Reference to the environmental parameters.
@@ -359,6 +423,38 @@ class USML_DECLSPEC wave_queue : public eigenray_notifier,
      */
     bool _de_branch;
 
+    /**
+     * Largest divergence ratio observed between neighboring D/E rays.
+     * Empty if divergence tracking has not been enabled.
+     */
+    vector<double> _de_divergence;
+
+    /// Background task used to cancel or pause this calculation.
+    const thread_task* _cancellation{nullptr};
+
+    /// True if the last step() was interrupted by the cancellation task.
+    bool _aborted{false};
+
+    /**
+     * Cooperative cancellation point. Blocks while the cancellation task is
+     * paused, and latches the aborted() flag if it has been aborted.
+     *
+     * @return  True if the calculation needs to terminate.
+     */
+    inline bool preempted() {
+        if (_cancellation != nullptr && _cancellation->checkpoint()) {
+            _aborted = true;
+        }
+        return _aborted;
+    }
+
+    /**
+     * Update the divergence ratio between neighboring D/E rays using
+     * the positions in the next wavefront.  Ignores wavefront points that
+     * have not yet traveled far enough to make the ratio meaningful.
+     */
+    void update_divergence();
+
     /**
      * Initialize wavefronts at the start of propagation using a
      * 3rd order Runge-Kutta algorithm.  The Runge-Kutta algorithm is
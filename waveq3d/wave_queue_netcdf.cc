@@ -2,14 +2,19 @@
  * @file wave_queue_netcdf.cc
  * Recording to netCDF wavefront log
  */
+#include <usml/netcdf/netcdf_utils.h>
 #include <usml/waveq3d/wave_queue.h>
 
+#include <mutex>
+
+using namespace usml::netcdf;
 using namespace usml::waveq3d;
 
 /**
  * Initialize recording to netCDF wavefront log.
  */
 void wave_queue::init_netcdf(const char *filename, const char *long_name) {
+    std::lock_guard<std::mutex> lock(netcdf_utils::mutex());
     _nc_file = new NcFile(filename, NcFile::Replace);
     _nc_rec = 0;
     if (long_name != nullptr) {
@@ -80,6 +85,7 @@ void wave_queue::init_netcdf(const char *filename, const char *long_name) {
  * Write current record to netCDF wavefront log.
  */
 void wave_queue::save_netcdf() {
+    std::lock_guard<std::mutex> lock(netcdf_utils::mutex());
     // NcError( verbose_nonfatal ) ;
     _nc_time->put_rec(&_time, _nc_rec);
     _nc_latitude->put_rec(_curr->position.latitude().data().begin(), _nc_rec);
@@ -99,6 +105,7 @@ void wave_queue::save_netcdf() {
  * Close netCDF wavefront log.
  */
 void wave_queue::close_netcdf() {
+    std::lock_guard<std::mutex> lock(netcdf_utils::mutex());
     delete _nc_file;  // destructor frees all netCDF temp variables
     _nc_file = nullptr;
 }